@@ -11,6 +11,41 @@
  *			
  *
  * Modification History:
+ * 10/18/2026 - Follow the display shift of writes in a shifting entry mode
+ * 10/18/2026 - Write nothing for a label only field
+ * 10/18/2026 - Send queued writes for the primary display straight to the bus
+ * 10/18/2026 - Leave a CGRAM upload alone in the scrub step
+ * 10/18/2026 - Write whole fields while the address counter is lost
+ * 10/18/2026 - Hold frame scheduler updates with taskENTER_CRITICAL
+ * 10/18/2026 - Follow the address counter through cursor moves
+ * 10/18/2026 - Only drive RS, R/W and the E pins being strobed on LCP
+ * 10/18/2026 - Restore the display control in use after a page flip
+ * 10/18/2026 - Position text in the columns showing while the display is shifted
+ * 10/18/2026 - Reject gatekeeper text longer than a line, count characters written
+ * 10/18/2026 - Added RTOS yielding waits for long controller operations
+ * 10/18/2026 - Added UTF-8 writer with ROM code tables
+ * 10/18/2026 - Added named field layouts
+ * 10/18/2026 - Added frame paced update scheduler
+ * 10/18/2026 - Added DDRAM read back and background scrub
+ * 10/18/2026 - Added warm start detection and busy flag driven initialization
+ * 10/18/2026 - Added broadcast writes, clear and initialization
+ * 10/18/2026 - Added multi display handles and interleaved scheduler
+ * 10/18/2026 - Added off screen page flip
+ * 10/18/2026 - Added display shift marquee
+ * 10/18/2026 - Added CGRAM bar graphs and sparklines
+ * 10/18/2026 - Added CGRAM glyph cache
+ * 10/18/2026 - Added bus trace recorder
+ * 10/18/2026 - Added optional per call instrumentation counters
+ * 10/18/2026 - Fixed early sends from the transmit queue found by the simulator
+ * 10/18/2026 - Added integer, fixed point and hex writers
+ * 10/18/2026 - Added scatter gather segment writes
+ * 10/18/2026 - Added optional peephole stage for instruction writes
+ * 10/18/2026 - Added set-DDRAM based line clear, fill and home functions
+ * 10/18/2026 - Made 4-bit bus mode operational
+ * 10/18/2026 - Added FreeRTOS gatekeeper task
+ * 10/18/2026 - Added interrupt driven transmit queue
+ * 10/18/2026 - Added shadow DDRAM buffer and flush planner
+ * 10/18/2026 - Added busy flag polled writes
  * 11/18/2013 - Pulled all Functions in
  * 11/16/2013 - Original File
  *
@@ -19,12 +54,243 @@
  
  
  /* #includes go here */
+#include <avr/pgmspace.h>
+#if configUSE_TX_INTERRUPT == 1 || configUSE_LCD_STATS == 1 || configUSE_LCD_TRACE == 1 || \
+	configUSE_FRAME_SCHEDULER == 1
+#include <avr/interrupt.h>
+#endif
  
+/*****************************************************************************/
+/**********************************/
+/*Library Private Function Prototypes*/
+/**********************************/
+
+static void prvLCD_TRACK_STEP(uint8_t increment);
+static void prvLCD_TRACK_WRITE(char RS, char data);
+#if configUSE_SHADOW_BUFFER == 0
+static uint8_t prvLCD_WRITE_DATA(char character);
+#endif
+static uint8_t prvLCD_SEND(char RS, char data);
+static void prvLCD_BUS_WRITE(char RS, char data);
+#ifdef BITMODE4
+static void prvLCD_BUS_WRITE_NIBBLE(char RS, uint8_t nibble);
+#endif
+#if configUSE_BUSY_FLAG == 1
+static uint8_t prvLCD_BUS_READ(char RS);
+static uint8_t prvLCD_READ_STATUS(void);
+#endif
+#if configUSE_BUSY_FLAG == 1 && configUSE_MULTI_DISPLAY == 0
+static uint8_t prvLCD_READY_STATUS(void);
+static uint8_t prvLCD_READ_CELL(uint8_t address, uint8_t *data);
+static void prvLCD_READ_END(uint8_t address);
+#endif
+#if configUSE_WARM_START == 1
+static uint8_t prvLCD_WARM_CHECK(void);
+static void prvLCD_WARM_SIGN(void);
+static void prvLCD_WARM_RESTORE(void);
+#endif
+#if configUSE_TX_INTERRUPT == 1
+static void prvLCD_TX_ENQUEUE(char RS, char data);
+static void prvLCD_TX_SERVICE(void);
+#endif
+#if configUSE_LCD_GATEKEEPER == 1
+static uint8_t prvLCD_GATEKEEPER_CELL(void);
+static void prvLCD_GATEKEEPER_TASK(void *pvParameters);
+static BaseType_t prvLCD_REQUEST(LCD_Request_t *request, TickType_t xTicksToWait);
+#endif
+#if configUSE_PEEPHOLE == 1
+static uint8_t prvLCD_PEEPHOLE_WRITE(char RS, char data);
+#endif
+#if configUSE_SHADOW_BUFFER == 1
+static void prvLCD_SHADOW_FILL(uint8_t first, uint8_t count, char character);
+static uint8_t prvLCD_SHADOW_SEND(uint16_t budget, uint8_t *line);
+#endif
+#if configUSE_SHADOW_BUFFER == 1 && (configUSE_MARQUEE == 1 || configUSE_PAGE_FLIP == 1)
+static void prvLCD_SHADOW_SHIFTED(uint8_t from);
+#endif
+#if configUSE_GLYPH_CACHE == 1
+static uint8_t prvLCD_GLYPH_VISIBLE(uint8_t slot);
+static void prvLCD_GLYPH_USE(uint8_t slot);
+static const uint8_t *prvLCD_GLYPH_PATTERN(uint8_t id);
+static uint8_t prvLCD_GLYPH_LOAD(uint8_t slot, uint8_t id);
+#endif
+#if configUSE_UTF8 == 1
+static uint16_t prvLCD_UTF8_DECODE(const char **text);
+static uint8_t prvLCD_UTF8_ROM(uint16_t codepoint, uint8_t *mark);
+#endif
+#if configUSE_UTF8_GLYPHS == 1
+static uint8_t prvLCD_UTF8_GLYPH(uint16_t codepoint);
+#endif
+#if configUSE_BAR_GRAPH == 1
+static uint8_t prvLCD_BAR_LEVEL(uint16_t value, uint16_t full, uint8_t levels);
+static uint8_t prvLCD_BAR_CELL(uint8_t x, uint8_t y, uint8_t level,
+	uint8_t levels, uint8_t glyph, uint8_t *next, uint8_t *shown);
+#endif
+#if configUSE_MARQUEE == 1
+static uint8_t prvLCD_MARQUEE_DRAW(const char *text, uint16_t length,
+	uint16_t index, uint16_t period, uint8_t cell, uint8_t count);
+#endif
+#if configUSE_PAGE_FLIP == 1
+static uint8_t prvLCD_PAGE_WRITE(uint8_t y, uint8_t cell, const char *text, uint8_t count);
+#endif
+#if configUSE_MULTI_DISPLAY == 1
+static uint8_t prvLCD_MULTI_ENQUEUE(char RS, char data);
+static uint8_t prvLCD_MULTI_SERVICE(void);
+static uint8_t prvLCD_BROADCAST_WRITE(char RS, char data);
+#endif
+#if configUSE_YIELD_WAIT == 1
+static uint8_t prvLCD_YIELD(uint16_t us);
+#endif
+#if configUSE_LCD_STATS == 1 || configUSE_LCD_TRACE == 1
+static uint16_t prvLCD_TIMER5_NOW(void);
+#endif
+#if configUSE_LCD_STATS == 1
+static LCD_StatsFrame_t prvLCD_STATS_ENTER(uint8_t api);
+static void prvLCD_STATS_EXIT(LCD_StatsFrame_t *frame);
+#endif
+#if configUSE_LCD_TRACE == 1
+static uint32_t prvLCD_TRACE_NOW(void);
+static void prvLCD_TRACE_DROP(void);
+static void prvLCD_TRACE_RECORD(char RS, char data);
+#endif
+
+/*****************************************************************************/
+
 /*****************************************************************************/
 /****************************/
 /*Library LCD Initialization*/
 /****************************/
 
+#if configUSE_WARM_START == 1
+
+/*!****************************************************************************
+*
+* \fn prvLCD_WARM_CHECK(void)
+*
+* \brief Function to find out whether the controller is still set up
+*
+* \details Only called when the reset was not a power on reset, so the
+*		   controller has had power all along and can be read at once.
+*		   Addresses the signature cell and reads the address counter
+*		   back, which only matches when the controller took the
+*		   instruction in the bus mode of this build, then reads the
+*		   signature byte. In 4-bit mode a controller still in 8-bit mode,
+*		   or one left halfway through a byte, takes the two nibbles of
+*		   the address as other instructions and the check fails. None of
+*		   these writes can change DDRAM or the display, whatever mode the
+*		   controller is in.
+*
+* \params[in] none
+*
+* \returns 1 when the address counter and signature match, 0 otherwise
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Poll with prvLCD_READY_STATUS
+*
+******************************************************************************
+*/
+static uint8_t prvLCD_WARM_CHECK(void)
+{
+	uint8_t Signature;
+	
+	/*! Let an instruction cut short by the reset finish */
+	if (prvLCD_READY_STATUS() == LCD_ADDRESS_UNKNOWN) return 0;
+	
+	prvLCD_BUS_WRITE(INSTR_WR, 1 << LCD_DDRAM | configLCD_WARM_ADDRESS);
+	
+	if (prvLCD_READY_STATUS() != configLCD_WARM_ADDRESS) return 0;
+	
+	Signature = prvLCD_BUS_READ(DATA_RD);
+	
+	/*! A nibble of the 4-bit resync sent while the read runs would be lost */
+	(void)prvLCD_READY_STATUS();
+	
+	return Signature == configLCD_WARM_SIGNATURE;
+}
+
+/*!****************************************************************************
+*
+* \fn prvLCD_WARM_SIGN(void)
+*
+* \brief Function to leave the signature in its DDRAM cell
+*
+* \details Called after every clear, which blanks the cell. The address
+*		   counter is put back at the top line home, where the clear left
+*		   it.
+*
+* \params[in] none
+*
+* \returns nothing
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+*
+******************************************************************************
+*/
+static void prvLCD_WARM_SIGN(void)
+{
+	vWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_DDRAM | configLCD_WARM_ADDRESS);
+	vWRITE_COMMAND_TO_LCD(DATA_WR, configLCD_WARM_SIGNATURE);
+	vWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_DDRAM | LCD_LINE0_DDRAMADDR);
+}
+
+/*!****************************************************************************
+*
+* \fn prvLCD_WARM_RESTORE(void)
+*
+* \brief Function to bring the library state back after a warm start
+*
+* \details With the shadow buffer, glyph cache or scrubber the visible
+*		   cells are read back into LCD_GlassBuffer, and into the shadow
+*		   buffer so the application starts from what the display shows.
+*		   The address counter is then put at the top line home.
+*
+* \params[in] none
+*
+* \returns nothing
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Read the lines with xLCD_READ_DDRAM, also for the scrubber
+*
+******************************************************************************
+*/
+static void prvLCD_WARM_RESTORE(void)
+{
+	#if configUSE_SHADOW_BUFFER == 1 || configUSE_GLYPH_CACHE == 1 || configUSE_SCRUB == 1 || \
+		configUSE_LAYOUT == 1
+	
+		uint8_t Line;
+		
+		for (Line = 0; Line < LCD_LINES; Line++)
+		{
+			if (xLCD_READ_DDRAM(0, Line, LCD_LINE_LENGTH,
+				(char *)LCD_GlassBuffer[Line]) != LCD_OK) break;
+			
+			#if configUSE_SHADOW_BUFFER == 1
+			{
+				uint8_t Column;
+				for (Column = 0; Column < LCD_LINE_LENGTH; Column++)
+					LCD_ShadowBuffer[Line][Column] = LCD_GlassBuffer[Line][Column];
+			}
+			#endif
+		}
+		
+		#if configUSE_SHADOW_BUFFER == 1
+			if (Line == LCD_LINES) LCD_ShadowDirty = 0;
+		#endif
+	
+	#endif
+	
+	vWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_DDRAM | LCD_LINE0_DDRAMADDR);
+}
+
+#endif
+
 /*!****************************************************************************
 *
 * \fn vLCD_INITIALIZATION(void)
@@ -33,7 +299,8 @@
 *
 * \details Function is called to initialize the LCD into either 
 *		   4 bit or 8 bit mode off of the flowcharts on pages 26 and 27
-*		   of the KS6600U datasheet 
+*		   of the KS6600U datasheet. Timeouts are reported by 
+*		   xLCD_INITIALIZATION only.
 *
 * \params[in] none
 *
@@ -41,16 +308,125 @@
 *
 * Modification History:
 *
-* 11/17/2013 - Original Function
+* 10/18/2026 - Original Function, the sequence moved to xLCD_INITIALIZATION
 *
 ******************************************************************************
 */
 void vLCD_INITIALIZATION(void)
 {
+	(void)xLCD_INITIALIZATION();
+}
+
+/*!****************************************************************************
+*
+* \fn xLCD_INITIALIZATION(void)
+*
+* \brief Function to initialize the LDC and report the result
+*
+* \details Runs the flowcharts on pages 26 and 27 of the KS0066U
+*		   datasheet. The busy flag may not be read before the function
+*		   set, so up to and including it fixed delays are used whatever
+*		   configUSE_BUSY_FLAG says. The instructions after it are sent
+*		   even when one times out, so the library state still matches a
+*		   display that answers late.
+*
+* \params[in] none
+*
+* \returns LCD_OK, or LCD_ERROR_TIMEOUT if an instruction was not written
+*
+* Modification History:
+*
+* 11/17/2013 - Original Function
+* 10/18/2026 - Configure port directions, use busy flag after function set
+* 10/18/2026 - Reset the cursor line and shadow buffer
+* 10/18/2026 - Added the 4-bit nibble sequence
+* 10/18/2026 - Forget the peephole state, the controller may be warm
+* 10/18/2026 - Counted by the instrumentation, delays included
+* 10/18/2026 - Forget which glyphs are in CGRAM
+* 10/18/2026 - Initialize the selected display's E pin
+* 10/18/2026 - Skip the power on wait, resync and clear on a warm start
+* 10/18/2026 - Block the calling task in the long waits when it can
+* 10/18/2026 - Use fixed delays until the function set, report timeouts
+*
+******************************************************************************
+*/
+uint8_t xLCD_INITIALIZATION(void)
+{
+	LCD_STATS_ENTER(LCD_API_INITIALIZATION);
+	
 	unsigned char Instructions = 0x00;
+	uint8_t Result = LCD_OK;
+	/*! Cleared when the controller kept its set up through the reset */
+	uint8_t Cold = 1;
+	/*! Cleared when the controller has had power since before the reset */
+	uint8_t PowerOn = 1;
 	
+		#if configUSE_PEEPHOLE == 1
+			/*! Nothing is known to be on the controller until it is sent again */
+			LCD_PeepholeDisplay = LCD_ADDRESS_UNKNOWN;
+			LCD_PeepholeEntry = LCD_ADDRESS_UNKNOWN;
+			LCD_PeepholePending = LCD_ADDRESS_UNKNOWN;
+		#endif
+		
+		#if configUSE_MARQUEE == 1
+			/*! The clear below undoes the display shift */
+			LCD_Marquee.Running = 0;
+		#endif
+		
+		#if configUSE_PAGE_FLIP == 1
+			LCD_PageReady = 0;
+		#endif
+		
+		#if configUSE_GLYPH_CACHE == 1
+			/*! CGRAM may hold anything until the glyphs are loaded again */
+			{
+				uint8_t Slot;
+				for (Slot = 0; Slot < LCD_GLYPH_SLOTS; Slot++)
+					LCD_GlyphSlot[Slot] = LCD_GLYPH_NONE;
+			}
+		#endif
+		
+		/*! Data pins are outputs unless the busy flag is being read */
+		LDDR = LDDR | LCD_DATA_MASK;
+		/*! RS, R/W and E are always outputs */
+		LCDR = LCDR | LCD_CONTROL_MASK;
+		LCP = LCP & (uint8_t)~LCD_CONTROL_MASK;
+		
+		#if configUSE_WARM_START == 1
+			#if configUSE_TX_INTERRUPT == 1
+				/*! The checks below use the bus directly */
+				vLCD_TX_FLUSH();
+			#endif
+			PowerOn = configLCD_POWER_ON_RESET() ? 1 : 0;
+			LCD_WarmStarted = PowerOn ? 0 : prvLCD_WARM_CHECK();
+			Cold = !LCD_WarmStarted;
+		#endif
+		
 		/*! Delay  more than 30ms after powering up*/
-		_delay_ms(35);
+		if (PowerOn) LCD_WAIT_US(35000UL);
+		
+		#ifdef BITMODE4
+		
+			/*!
+			 * The controller starts in 8-bit mode and only D4-D7 are wired.
+			 * Three 8-bit function sets sent as single nibbles put it back
+			 * in 8-bit mode whatever state it was left in, then a fourth
+			 * nibble switches it to 4-bit mode. Each byte after this is
+			 * sent as two nibbles. A warm controller is already in step.
+			 */
+			if (Cold)
+			{
+				prvLCD_BUS_WRITE_NIBBLE(INSTR_WR, 0x03);
+				LCD_WAIT_US(4100);
+				prvLCD_BUS_WRITE_NIBBLE(INSTR_WR, 0x03);
+				LCD_DELAY_US(100);
+				prvLCD_BUS_WRITE_NIBBLE(INSTR_WR, 0x03);
+				LCD_DELAY_US(50);
+				prvLCD_BUS_WRITE_NIBBLE(INSTR_WR, 0x02);
+				LCD_DELAY_US(50);
+			}
+		
+		#endif
 		
 		/***************************************************************************/
 		/*! ###Function set###
@@ -62,14 +438,28 @@ void vLCD_INITIALIZATION(void)
 		 */
 		
 		Instructions = (1 << LCD_D5) |
-					   (1 << LCD_D4) | 
+			(LCD_BUS_8BIT << LCD_D4) | 
 		   (TWO_LINE_MODE << LCD_D3) | 
 		      (DISPLAY_ON << LCD_D2);	
+		
+		#if configUSE_BUSY_FLAG == 1
+			/*! The busy flag may not be read until the function set has run */
+			LCD_BusyFlagReady = 0;
+		#endif
 			  
-		vWRITE_COMMAND_TO_LCD(INSTR_WR, Instructions);
+		if (xWRITE_COMMAND_TO_LCD(INSTR_WR, Instructions) != LCD_OK) Result = LCD_ERROR_TIMEOUT;
+		
+		#if configUSE_TX_INTERRUPT == 1
+			/*! The delay below runs from when the timer sent it */
+			vLCD_TX_FLUSH();
+		#endif
 			  	
-		/*! Delay more than 39us*/
-		_delay_us(50);
+		/*! Delay more than 39us, the busy flag can be checked after this*/
+		LCD_DELAY_US(50);
+		
+		#if configUSE_BUSY_FLAG == 1
+			LCD_BusyFlagReady = 1;
+		#endif
 		
 		/***************************************************************************/
 		/*! ###Display ON/OFF Control###
@@ -86,10 +476,10 @@ void vLCD_INITIALIZATION(void)
 			   (CURSOR_ON << LCD_D1) | 
 		 (CURSOR_BLINK_ON << 0);
 		 
-		 vWRITE_COMMAND_TO_LCD(INSTR_WR, Instructions);
+		if (xWRITE_COMMAND_TO_LCD(INSTR_WR, Instructions) != LCD_OK) Result = LCD_ERROR_TIMEOUT;
 		 
 		/*! Delay more than 39us*/
-		_delay_us(50);
+		LCD_EXECUTION_DELAY_US(50);
 		
 		/***************************************************************************/
 		/*! ###Display Clear###
@@ -99,10 +489,14 @@ void vLCD_INITIALIZATION(void)
 		
 		Instructions = 0x01;
 		
-		vWRITE_COMMAND_TO_LCD(INSTR_WR, Instructions);
-		
-		/*! Delay more than 1.53ms*/
-		_delay_us(1600);
+		/*! A warm display keeps what it shows */
+		if (Cold)
+		{
+			if (xWRITE_COMMAND_TO_LCD(INSTR_WR, Instructions) != LCD_OK) Result = LCD_ERROR_TIMEOUT;
+			
+			/*! Delay more than 1.53ms*/
+			LCD_EXECUTION_WAIT_US(1600);
+		}
 		
 		/***************************************************************************/
 		/*! ###Entry Mode set###
@@ -117,10 +511,28 @@ void vLCD_INITIALIZATION(void)
 		   (INCREMENT_MODE << LCD_D1) | 
 		(ENTIRE_SHIFT_MODE << 0);
 		
-		vWRITE_COMMAND_TO_LCD(INSTR_WR, Instructions);
+		if (xWRITE_COMMAND_TO_LCD(INSTR_WR, Instructions) != LCD_OK) Result = LCD_ERROR_TIMEOUT;
+	
+	#if configUSE_WARM_START == 1
+		if (Cold) prvLCD_WARM_SIGN();
+		else prvLCD_WARM_RESTORE();
+		if (PowerOn) configLCD_POWER_ON_SEEN();
+	#endif
 	
 	/*! Set cursor position to zero*/
 	CURSOR_X_POSITION = 0;
+	CURSOR_Y_POSITION = 0;
+	
+	#if configUSE_SHADOW_BUFFER == 1
+		if (Cold)
+		{
+			/*! The clear left blanks on the display, start the shadow the same */
+			prvLCD_SHADOW_FILL(0, LCD_LINES * LCD_LINE_LENGTH, ' ');
+			LCD_ShadowDirty = 0;
+		}
+	#endif
+	
+	return Result;
 }
 
 
@@ -145,393 +557,6173 @@ void vLCD_INITIALIZATION(void)
 * Modification History:
 *
 * 11/17/2013 - Original Function
+* 10/18/2026 - Moved bus cycle into xWRITE_COMMAND_TO_LCD
 *
 ******************************************************************************
 */
 void vWRITE_COMMAND_TO_LCD(char RS, char data)
 {		
-	if(RS == DATA_WR) LCP = 1 << LCD_RS;	/*Set RS high to write data*/ 
-	else LCP = 0x00;	/*Set RS low to write instructions*/
-	
-	/*! Enable display for use*/
-	LCP = LCP | 1<<LCD_E; 
+	/*! Timeouts are reported by xWRITE_COMMAND_TO_LCD only */
+	(void)xWRITE_COMMAND_TO_LCD(RS, data);
+}
+
+/*!****************************************************************************
+*
+* \fn xWRITE_COMMAND_TO_LCD(char RS, char data)
+*
+* \brief Function to write commands to the LCD and report the result
+*
+* \details When configUSE_BUSY_FLAG is set the busy flag is polled before
+*		   the write and the byte is strobed in with a short E pulse, so
+*		   the transfer takes only as long as the controller needs. When
+*		   it is cleared fixed delays longer than 39us surround the strobe.
+*		   When configUSE_TX_INTERRUPT is set the byte is queued for the
+*		   timer interrupt instead and this returns straight away.
+*		   When configUSE_PEEPHOLE is set instructions that change nothing
+*		   are dropped before they reach the bus.
+*
+* \params[in] RS, data
+*
+* \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy. 
+*		   Nothing is written when the wait times out.
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Queue the byte when the transmit interrupt is enabled
+* 10/18/2026 - Fixed delay path uses prvLCD_BUS_WRITE for both bus widths
+* 10/18/2026 - Moved the bus paths to prvLCD_SEND, added the peephole stage
+* 10/18/2026 - Counted by the instrumentation
+* 10/18/2026 - Record the write in the bus trace
+* 10/18/2026 - Strobe all targets of a broadcast call together
+*
+******************************************************************************
+*/
+uint8_t xWRITE_COMMAND_TO_LCD(char RS, char data)
+{
+	LCD_STATS_ENTER(LCD_API_WRITE_COMMAND);
 	
-	/*! Delay for more than 39us*/
-	_delay_us(50);
+	#if configUSE_LCD_TRACE == 1
+		/*! Record what was asked for, before the peephole stage */
+		prvLCD_TRACE_RECORD(RS, data);
+	#endif
 	
-	/* Write Data*/
+	#if configUSE_MULTI_DISPLAY == 1
+		if (LCD_Broadcast)
+		{
+			/*! Every target takes the write in the same bus cycle */
+			return prvLCD_BROADCAST_WRITE(RS, data);
+		}
+	#endif
 	
-	#ifdef BITMODE4
-		LDP = data; 
-		data = (data << 4);
-		LDP =  data; 
-	#endif;
-
-	#ifdef BITMODE8
-		LDP = data;
+	#if configUSE_PEEPHOLE == 1
+		if (prvLCD_PEEPHOLE_WRITE(RS, data) != LCD_OK)
+		{
+			return LCD_ERROR_TIMEOUT;
+		}
+	#else
+		if (prvLCD_SEND(RS, data) != LCD_OK)
+		{
+			return LCD_ERROR_TIMEOUT;
+		}
 	#endif
 	
 	if (RS == DATA_WR)
 	{
 		/*!Increment Cursor Position*/
 		CURSOR_X_POSITION++;
-	}		
+	}
 	
-	/*Set Read/Write low*/
-	LCP = LCP & 1<<LCD_RS; 
+	/*! Follow the controller's address counter */
+	prvLCD_TRACK_WRITE(RS, data);
 	
-	/*! Delay for more than 39us*/
-	_delay_us(50);
+	return LCD_OK;
 }
 
-
-
 /*!****************************************************************************
 *
-* \fn vLCD_WRITE_STRING(char *str_ptr)
+* \fn prvLCD_SEND(char RS, char data)
 *
-* \brief Function to write strings to the LCD
+* \brief Function to put one write on the bus
 *
-* \details Function is used to take in a string of characters and display 
-*		   the string to the LCD
+* \details Waits for the controller the way the configuration asks (busy
+*		   flag, fixed delays or the transmit queue) and strobes the byte
+*		   in. Does not touch the cursor or the tracked controller state.
 *
-* \params[in] *str_ptr
+* \params[in] RS, data
 *
-* \returns nothing
+* \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
 *
 * Modification History:
 *
-* 11/17/2013 - Original Function
-* 11/23/2013 - Added Code
-* 11/30/2013 - Limit bottom line to prevent rollover
+* 10/18/2026 - Original Function, moved from xWRITE_COMMAND_TO_LCD
+* 10/18/2026 - Count bytes, instructions and delays
+* 10/18/2026 - Queue per display between vLCD_MULTI_BEGIN and xLCD_MULTI_FLUSH
+* 10/18/2026 - Send straight to LCD_PrimaryDisplay, which the scheduler does not visit
 *
 ******************************************************************************
 */
-void vLCD_WRITE_STRING(char *str_ptr)
-{	
-	uint8_t character;
-	while(*str_ptr != '\0')		//move through the string until the end is reached
-	{
-		/*! If text wrap is enabled */
-		#ifdef configTEXT_WRAP
-			#if configTEXT_WRAP == 1
+static uint8_t prvLCD_SEND(char RS, char data)
+{
+	#if configUSE_TX_INTERRUPT == 1
+	
+		/*! The timer interrupt owns the bus, queue the byte behind the others */
+		prvLCD_TX_ENQUEUE(RS, data);
+	
+	#elif configUSE_MULTI_DISPLAY == 1
+	
+		/*! LCD_PrimaryDisplay is not in the list the scheduler visits */
+		if (LCD_MultiQueued && (LCD_Active != &LCD_PrimaryDisplay))
+		{
+			/*! The scheduler sends it between the writes to the other displays */
+			if (prvLCD_MULTI_ENQUEUE(RS, data) != LCD_OK)
+			{
+				return LCD_ERROR_TIMEOUT;
+			}
+		}
+		else
+		{
+			if (xLCD_WAIT_WHILE_BUSY() != LCD_OK)
+			{
+				return LCD_ERROR_TIMEOUT;
+			}
+			
+			prvLCD_BUS_WRITE(RS, data);
+		}
+	
+	#elif configUSE_BUSY_FLAG == 1
+	
+		/*! Wait for the previous instruction to finish */
+		if (xLCD_WAIT_WHILE_BUSY() != LCD_OK)
+		{
+			return LCD_ERROR_TIMEOUT;
+		}
 		
-				/*! If the LCD is at the end of the top line */
-				if( xLCD_Get_Length() <= 0 && CURSOR_Y_POSITION == 0)
-					vLCD_HOME_BOTTOM_LINE(); //Continue on to the bottom line
+		prvLCD_BUS_WRITE(RS, data);
+	
+	#else
+	
+		/*! Delay for more than 39us*/
+		LCD_DELAY_US(50);
 		
-			#endif
-		#endif
-		/*! Limit the length of the bottom line to prevent rollover */
-		if (!(xLCD_Get_Length() < 0 && CURSOR_Y_POSITION == 1))
-		{
-			character = *str_ptr++; //increment pointer
-			vWRITE_COMMAND_TO_LCD(DATA_WR, character); //print character
-		}			
-	}	
+		prvLCD_BUS_WRITE(RS, data);
+		
+		/*! Delay for more than 39us*/
+		LCD_DELAY_US(50);
+	
+	#endif
+	
+	/*! Count what reached the bus or the queue */
+	if (RS == DATA_WR) LCD_STATS_ADD(Bytes, 1);
+	else LCD_STATS_ADD(Commands, 1);
+	
+	return LCD_OK;
 }
 
-/*****************************************************************************/
-
-/*****************************************************************************/
-/*************************/
-/*Library Clear Functions*/
-/*************************/
-
 /*!****************************************************************************
 *
-* \fn vLCD_CLEAR(void)
+* \fn prvLCD_BUS_WRITE(char RS, char data)
 *
-* \brief Function to clear the LCD Display
+* \brief Function to strobe one byte into the LCD
 *
-* \details Function is called to clear all data displayed on the LCD. Also
-*		   returns the cursor to the home location on the top row. The command
-*		   used to clear the display takes 1.53ms to run. Proper time needs
-*		   allocated to ensure no commands are sent to the display for that time
-*	
-* \params[in] nothing
-*	
-* \returns nothing	
+* \details Sets RS, puts the byte on the data pins and pulses E for 1us.
+*		   In 4-bit mode the high nibble is strobed first and the low
+*		   nibble straight after it; the controller only needs time
+*		   between bytes, not between nibbles. Does not wait for the
+*		   controller, the caller must know it is ready.
+*
+* \params[in] RS, data
+*
+* \returns nothing
 *
 * Modification History:
 *
-* 11/17/2013 - Original Function
-* 11/24/2013 - Added code to function
+* 10/18/2026 - Original Function
+* 10/18/2026 - Added 4-bit transfer
+* 10/18/2026 - Strobe the E pin of the selected display
+* 10/18/2026 - Leave the LCP pins of other displays and the application alone
 *
 ******************************************************************************
 */
-void vLCD_CLEAR(void)
+static void prvLCD_BUS_WRITE(char RS, char data)
 {
-	/*! Call write command to send 0x01 command (clear) to the controller */
-	vWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_CLEAR_INSTRUCTION);
-	/*! Delay 1.53 ms to allow clear to finish */
-	_delay_us(1530);
+	#ifdef BITMODE4
+	
+		prvLCD_BUS_WRITE_NIBBLE(RS, (uint8_t)data >> 4);
+		prvLCD_BUS_WRITE_NIBBLE(RS, data);
+	
+	#else
+	
+		/*! RS high to write data, low for instructions, R/W and E low */
+		LCP = (LCP & (uint8_t)~LCD_CONTROL_MASK) | ((RS == DATA_WR) ? (1 << LCD_RS) : 0);
+		
+		/* Data must be set up before E falls */
+		LDP = data;
+		
+		/*! Enable display for use*/
+		LCP = LCP | LCD_E_MASK;
+		
+		/*! E pulse must be wider than 230ns*/
+		_delay_us(1);
+		
+		/*! Data is latched on the falling edge of E*/
+		LCP = LCP & (uint8_t)~LCD_E_MASK;
+	
+	#endif
 }
 
+#ifdef BITMODE4
+
 /*!****************************************************************************
 *
-* \fn vLCD_CLEAR_TOP(void)
+* \fn prvLCD_BUS_WRITE_NIBBLE(char RS, uint8_t nibble)
 *
-* \brief Function to clear the top line of the LCD Display
+* \brief Function to strobe the low four bits of nibble into LCD D4-D7
 *
-* \details Calls the function to set the cursor to the home position of the top
-*		   row, write 24 spaces as a string, then return to the home position
-*		   of the top row.
-*	
-* \params[in] nothing
-*	
-* \returns nothing	
+* \details Only LDP pins 4-7 are changed. The 1us E pulse plus the port
+*		   writes around it also covers the 1us E cycle time, so two
+*		   nibbles can be sent back to back.
+*
+* \params[in] RS, nibble
+*
+* \returns nothing
 *
 * Modification History:
 *
-* 11/17/2013 - Original Function
-* 11/24/2013 - Added code to function
+* 10/18/2026 - Original Function
+* 10/18/2026 - Strobe the E pin of the selected display
+* 10/18/2026 - Leave the LCP pins of other displays and the application alone
 *
 ******************************************************************************
 */
-void vLCD_CLEAR_TOP(void)
+static void prvLCD_BUS_WRITE_NIBBLE(char RS, uint8_t nibble)
 {
-	/*! Call function to set cursor for top row's home position */
-	vLCD_HOME_TOP_LINE();
-	/*! Call function to write string of 24 spaces to clear the top row */
-	vLCD_WRITE_STRING("                        ");
-	/*! Call function to set cursor for top row's home position */
-	vLCD_HOME_TOP_LINE();
+	/*! RS high to write data, low for instructions, R/W and E low */
+	LCP = (LCP & (uint8_t)~LCD_CONTROL_MASK) | ((RS == DATA_WR) ? (1 << LCD_RS) : 0);
+	
+	/* Data must be set up before E falls */
+	LDP = (LDP & (uint8_t)~LCD_DATA_MASK) | ((nibble << LCD_D4) & LCD_DATA_MASK);
+	
+	/*! Enable display for use*/
+	LCP = LCP | LCD_E_MASK;
+	
+	/*! E pulse must be wider than 230ns*/
+	_delay_us(1);
+	
+	/*! Data is latched on the falling edge of E*/
+	LCP = LCP & (uint8_t)~LCD_E_MASK;
 }
 
+#endif
+
+#if configUSE_BUSY_FLAG == 1
+
 /*!****************************************************************************
 *
-* \fn vLCD_CLEAR_BOTTOM(void)
+* \fn prvLCD_BUS_READ(char RS)
 *
-* \brief Function to clear the bottom line of the LCD Display
+* \brief Function to read one byte from the LCD
 *
-* \details Calls the function to set the cursor to the home position of the
-*		   bottom row, write 24 spaces as a string, then return to the home 
-*		   position of the bottom row.
-*	
-* \params[in] nothing
-*	
-* \returns nothing	
+* \details Releases the data bus, does one read cycle with R/W high, then
+*		   drives the data bus again. In 4-bit mode two read cycles are
+*		   needed, high nibble first. With RS low the byte is the busy
+*		   flag and address counter, with RS high it is the DDRAM or
+*		   CGRAM byte at the address counter, which then steps like it
+*		   does for a write. Does not wait for the controller.
+*
+* \params[in] RS, STATUS_RD or DATA_RD
+*
+* \returns The byte the controller drove
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function, moved from prvLCD_READ_STATUS
+* 10/18/2026 - Leave the LCP pins of other displays and the application alone
+*
+******************************************************************************
+*/
+static uint8_t prvLCD_BUS_READ(char RS)
+{
+	/*! The other pins of LCP keep what the application drives on them */
+	uint8_t Control = (LCP & (uint8_t)~LCD_CONTROL_MASK) | (1 << LCD_RW) |
+		((RS == DATA_RD) ? (1 << LCD_RS) : 0);
+	uint8_t Value;
+	
+	/*! Release the data bus, no pull-ups */
+	LDDR = LDDR & (uint8_t)~LCD_DATA_MASK;
+	LDP = LDP & (uint8_t)~LCD_DATA_MASK;
+	
+	LCP = Control;
+	LCP = Control | LCD_E_MASK;
+	/*! Data is valid 360ns after E rises*/
+	_delay_us(1);
+	Value = LDPIN;
+	LCP = Control;
+	
+	#ifdef BITMODE4
+		/*! The second nibble holds the low bits */
+		Value = Value & 0xF0;
+		_delay_us(1);
+		LCP = Control | LCD_E_MASK;
+		_delay_us(1);
+		Value = Value | ((LDPIN & 0xF0) >> 4);
+		LCP = Control;
+	#endif
+	
+	/*! Take the data bus back for writing */
+	LCP = LCP & (uint8_t)~LCD_CONTROL_MASK;
+	LDDR = LDDR | LCD_DATA_MASK;
+	
+	return Value;
+}
+
+/*!****************************************************************************
+*
+* \fn prvLCD_READ_STATUS(void)
+*
+* \brief Function to read the busy flag and address counter
+*
+* \details One read cycle with RS low and R/W high.
+*
+* \params[in] none
+*
+* \returns Busy flag in bit LCD_BUSY, address counter in the lower bits
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Strobe the E pin of the selected display
+* 10/18/2026 - Bus cycle moved to prvLCD_BUS_READ
+*
+******************************************************************************
+*/
+static uint8_t prvLCD_READ_STATUS(void)
+{
+	return prvLCD_BUS_READ(STATUS_RD);
+}
+
+#endif
+
+#if configUSE_BUSY_FLAG == 1 && configUSE_MULTI_DISPLAY == 0
+
+/*!****************************************************************************
+*
+* \fn prvLCD_READY_STATUS(void)
+*
+* \brief Function to wait for the busy flag and return the status after it
+*
+* \details Like xLCD_WAIT_WHILE_BUSY, but polls the controller even with
+*		   the transmit queue and keeps the address counter read with the
+*		   last poll.
+*
+* \params[in] none
+*
+* \returns Address counter, or LCD_ADDRESS_UNKNOWN if the busy flag never
+*		   cleared
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function, moved from prvLCD_WARM_STATUS
+*
+******************************************************************************
+*/
+static uint8_t prvLCD_READY_STATUS(void)
+{
+	uint16_t Polls = configBUSY_TIMEOUT_POLLS;
+	uint8_t Status;
+	
+	while ((Status = prvLCD_READ_STATUS()) & (1 << LCD_BUSY))
+	{
+		LCD_STATS_ADD(BusyPolls, 1);
+		if (--Polls == 0)
+		{
+			return LCD_ADDRESS_UNKNOWN;
+		}
+		/*! E cycle time must be more than 500ns*/
+		LCD_DELAY_US(1);
+	}
+	
+	return Status;
+}
+
+#endif
+
+/*!****************************************************************************
+*
+* \fn prvLCD_TRACK_STEP(uint8_t increment)
+*
+* \brief Function to step LCD_AddressCounter the way the controller does
+*
+* \details After a data write or a cursor move the address counter steps
+*		   one cell, from the last cell of one line to the first of the 
+*		   other and back. An address counter that is not known, or points
+*		   into CGRAM, stays LCD_ADDRESS_UNKNOWN.
+*
+* \params[in] increment, non zero to step right
+*
+* \returns nothing
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function, split out of prvLCD_TRACK_WRITE
+*
+******************************************************************************
+*/
+static void prvLCD_TRACK_STEP(uint8_t increment)
+{
+	if (LCD_AddressCounter == LCD_ADDRESS_UNKNOWN) return;
+	
+	/*! Step the address counter, wrapping between the two lines */
+	if (increment)
+	{
+		if (LCD_AddressCounter == LCD_LINE0_DDRAMADDR + LCD_DDRAM_LINE_LENGTH - 1)
+			LCD_AddressCounter = LCD_LINE1_DDRAMADDR;
+		else if (LCD_AddressCounter == LCD_LINE1_DDRAMADDR + LCD_DDRAM_LINE_LENGTH - 1)
+			LCD_AddressCounter = LCD_LINE0_DDRAMADDR;
+		else
+			LCD_AddressCounter++;
+	}
+	else
+	{
+		if (LCD_AddressCounter == LCD_LINE0_DDRAMADDR)
+			LCD_AddressCounter = LCD_LINE1_DDRAMADDR + LCD_DDRAM_LINE_LENGTH - 1;
+		else if (LCD_AddressCounter == LCD_LINE1_DDRAMADDR)
+			LCD_AddressCounter = LCD_LINE0_DDRAMADDR + LCD_DDRAM_LINE_LENGTH - 1;
+		else
+			LCD_AddressCounter--;
+	}
+}
+
+/*!****************************************************************************
+*
+* \fn prvLCD_TRACK_WRITE(char RS, char data)
+*
+* \brief Function to follow the controller state after a write
+*
+* \details Updates LCD_AddressCounter and LCD_DisplayShift the way the 
+*		   controller updates its address counter and shift, keeps the last
+*		   display control instruction in LCD_DisplayControl, and with the
+*		   shadow buffer, glyph cache or scrubber enabled records data
+*		   written to a visible DDRAM cell in LCD_GlassBuffer.
+*
+* \params[in] RS, data
+*
+* \returns nothing
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Keep LCD_GlassBuffer for the glyph cache too
+* 10/18/2026 - Follow the display shift for the marquee
+* 10/18/2026 - Keep LCD_GlassBuffer for the scrubber too
+* 10/18/2026 - Keep the display control instruction for the page flip
+* 10/18/2026 - Follow cursor moves, so writes after one are kept in LCD_GlassBuffer
+* 10/18/2026 - Follow the display shift of writes in a shifting entry mode
+*
+******************************************************************************
+*/
+static void prvLCD_TRACK_WRITE(char RS, char data)
+{
+	uint8_t Instruction = (uint8_t)data;
+	
+	if (RS == DATA_WR)
+	{
+		if (LCD_AddressCounter == LCD_ADDRESS_UNKNOWN) return;
+		
+		#if configUSE_SHADOW_BUFFER == 1 || configUSE_GLYPH_CACHE == 1 || configUSE_SCRUB == 1 || \
+			configUSE_LAYOUT == 1
+			/*! Record what is now on the glass */
+			if ((LCD_AddressCounter & 0x3F) < LCD_GLASS_LENGTH)
+			{
+				LCD_GlassBuffer[LCD_AddressCounter >> 6]
+					[LCD_AddressCounter & 0x3F] = Instruction;
+			}
+		#endif
+		
+		/*! A shifting entry mode moves the display with the cursor */
+		if (LCD_EntryMode & (1 << LCD_ENTRY_SHIFT))
+		{
+			if (LCD_EntryMode & (1 << LCD_ENTRY_INC))
+				LCD_DisplayShift = (LCD_DisplayShift + 1) % LCD_DDRAM_LINE_LENGTH;
+			else
+				LCD_DisplayShift = (LCD_DisplayShift + LCD_DDRAM_LINE_LENGTH - 1) % LCD_DDRAM_LINE_LENGTH;
+		}
+		
+		prvLCD_TRACK_STEP(LCD_EntryMode & (1 << LCD_ENTRY_INC));
+	}
+	else if (Instruction & (1 << LCD_DDRAM))
+	{
+		/*! Set DDRAM address */
+		LCD_AddressCounter = Instruction & 0x7F;
+	}
+	else if (Instruction & (1 << LCD_CGRAM))
+	{
+		/*! Writes now go to CGRAM and leave DDRAM alone until the next set
+			DDRAM address, return home or clear */
+		LCD_AddressCounter = LCD_ADDRESS_UNKNOWN;
+	}
+	else if (Instruction & (1 << LCD_FUNCTION))
+	{
+		/*! Function set does not move the address counter */
+	}
+	else if (Instruction & (1 << LCD_MOVE))
+	{
+		/*! A cursor move steps the address counter, a display shift does not */
+		if (!(Instruction & (1 << LCD_MOVE_DISP)))
+			prvLCD_TRACK_STEP(Instruction & (1 << LCD_MOVE_RIGHT));
+		else if (Instruction & (1 << LCD_MOVE_RIGHT))
+			LCD_DisplayShift = (LCD_DisplayShift + LCD_DDRAM_LINE_LENGTH - 1) % LCD_DDRAM_LINE_LENGTH;
+		else
+			LCD_DisplayShift = (LCD_DisplayShift + 1) % LCD_DDRAM_LINE_LENGTH;
+	}
+	else if (Instruction & (1 << LCD_ON_CTRL))
+	{
+		/*! Display control does not move the address counter */
+		LCD_DisplayControl = Instruction;
+	}
+	else if (Instruction & (1 << LCD_ENTRY_MODE))
+	{
+		LCD_EntryMode = Instruction;
+	}
+	else if (Instruction & (1 << LCD_HOME_TOP_LINE))
+	{
+		/*! Return home, also undoes the display shift */
+		LCD_AddressCounter = LCD_LINE0_DDRAMADDR;
+		LCD_DisplayShift = 0;
+	}
+	else if (Instruction & (1 << LCD_CLR))
+	{
+		LCD_AddressCounter = LCD_LINE0_DDRAMADDR;
+		LCD_DisplayShift = 0;
+		/*! Clearing also sets increment mode */
+		LCD_EntryMode = LCD_EntryMode | (1 << LCD_ENTRY_INC);
+		#if configUSE_SHADOW_BUFFER == 1 || configUSE_GLYPH_CACHE == 1 || configUSE_SCRUB == 1 || \
+			configUSE_LAYOUT == 1
+			{
+				uint8_t *Cell = &LCD_GlassBuffer[0][0];
+				uint8_t Count = LCD_LINES * LCD_GLASS_LENGTH;
+				while (Count--) *Cell++ = ' ';
+			}
+		#endif
+	}
+}
+
+/*!****************************************************************************
+*
+* \fn xLCD_WAIT_WHILE_BUSY(void)
+*
+* \brief Function to wait until the LCD is ready for the next instruction
+*
+* \details Releases the data bus, sets R/W high with RS low and reads the
+*		   busy flag on DB7 until it clears or configBUSY_TIMEOUT_POLLS
+*		   reads have been made. The data bus is driven again on return.
+*		   Without configUSE_BUSY_FLAG this returns straight away, since
+*		   the writes use fixed delays instead, and so it does before the
+*		   function set of xLCD_INITIALIZATION, when the flag may not be
+*		   read. With configUSE_TX_INTERRUPT this waits for the transmit
+*		   queue to drain.
+*
+* \params[in] none
+*
+* \returns LCD_OK, or LCD_ERROR_TIMEOUT if the busy flag never cleared
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Wait for the transmit queue when it is enabled
+* 10/18/2026 - Count busy polls and the delay between them
+* 10/18/2026 - Do not read the flag before the function set
+*
+******************************************************************************
+*/
+uint8_t xLCD_WAIT_WHILE_BUSY(void)
+{
+	LCD_STATS_ENTER(LCD_API_WAIT_BUSY);
+	
+	#if configUSE_TX_INTERRUPT == 1
+	
+		/*! The queue is paced by the timer, wait for it to drain */
+		vLCD_TX_FLUSH();
+	
+	#elif configUSE_BUSY_FLAG == 1
+	
+		uint16_t Polls = configBUSY_TIMEOUT_POLLS;
+		
+		/*! Before the function set the initialization delays instead */
+		if (!LCD_BusyFlagReady)
+		{
+			return LCD_OK;
+		}
+		
+		while (prvLCD_READ_STATUS() & (1 << LCD_BUSY))
+		{
+			LCD_STATS_ADD(BusyPolls, 1);
+			if (--Polls == 0)
+			{
+				return LCD_ERROR_TIMEOUT;
+			}
+			/*! E cycle time must be more than 500ns*/
+			LCD_DELAY_US(1);
+		}
+	
+	#endif
+	
+	return LCD_OK;
+}
+
+
+
+/*!****************************************************************************
+*
+* \fn vLCD_WRITE_STRING(char *str_ptr)
+*
+* \brief Function to write strings to the LCD
+*
+* \details Function is used to take in a string of characters and display 
+*		   the string to the LCD
+*
+* \params[in] *str_ptr
+*
+* \returns nothing
 *
 * Modification History:
 *
 * 11/17/2013 - Original Function
-* 11/24/2013 - Added code to function
+* 11/23/2013 - Added Code
+* 11/30/2013 - Limit bottom line to prevent rollover
+* 10/18/2026 - Stop writing when the busy flag times out
+* 10/18/2026 - Write through xLCD_WRITE_CHAR for the shadow buffer
+* 10/18/2026 - Counted by the instrumentation
 *
 ******************************************************************************
 */
-void vLCD_CLEAR_BOTTOM(void)
+void vLCD_WRITE_STRING(char *str_ptr)
+{	
+	LCD_STATS_ENTER(LCD_API_WRITE_STRING);
+	
+	uint8_t character;
+	while(*str_ptr != '\0')		//move through the string until the end is reached
+	{
+		/*! If text wrap is enabled */
+		#ifdef configTEXT_WRAP
+			#if configTEXT_WRAP == 1
+		
+				/*! If the LCD is at the end of the top line */
+				if( xLCD_Get_Length() <= 0 && CURSOR_Y_POSITION == 0)
+					vLCD_HOME_BOTTOM_LINE(); //Continue on to the bottom line
+		
+			#endif
+		#endif
+		/*! Limit the length of the bottom line to prevent rollover */
+		if (!(xLCD_Get_Length() < 0 && CURSOR_Y_POSITION == 1))
+		{
+			character = *str_ptr++; //increment pointer
+			//print character, give up if the display stopped responding
+			if (xLCD_WRITE_CHAR(character) != LCD_OK)
+				return;
+		}			
+	}	
+}
+
+/*****************************************************************************/
+
+#if configUSE_SHADOW_BUFFER == 0
+
+/*!****************************************************************************
+*
+* \fn prvLCD_WRITE_DATA(char character)
+*
+* \brief Function to write one character into DDRAM at the address counter
+*
+* \details After cell 39 the address counter runs on to the other line. 
+*		   While the display is shifted cell 0 of the same line is showing
+*		   in the next column, so the address is set back to it.
+*
+* \params[in] character
+*
+* \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+*
+******************************************************************************
+*/
+static uint8_t prvLCD_WRITE_DATA(char character)
+{
+	uint8_t Address = LCD_AddressCounter;
+	uint8_t Result = xWRITE_COMMAND_TO_LCD(DATA_WR, character);
+	
+	#if configUSE_MARQUEE == 1 || configUSE_PAGE_FLIP == 1
+		if ((Result == LCD_OK) && (LCD_DisplayShift != 0) && 
+			(LCD_EntryMode & (1 << LCD_ENTRY_INC)) &&
+			((Address & 0x3F) == LCD_DDRAM_LINE_LENGTH - 1))
+		{
+			Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_DDRAM) | (Address & 0x40));
+		}
+	#else
+		(void)Address;
+	#endif
+	
+	return Result;
+}
+
+#endif
+
+/*!****************************************************************************
+*
+* \fn xLCD_WRITE_CHAR(char character)
+*
+* \brief Function to write one character at the cursor
+*
+* \details Writes the character at the current cursor position and moves
+*		   the cursor one place right. With the shadow buffer enabled the
+*		   character only goes into LCD_ShadowBuffer; characters past the
+*		   end of the line are dropped.
+*
+* \params[in] character
+*
+* \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Counted by the instrumentation
+* 10/18/2026 - Carry on in the same line while the display is shifted
+*
+******************************************************************************
+*/
+uint8_t xLCD_WRITE_CHAR(char character)
+{
+	LCD_STATS_ENTER(LCD_API_WRITE_CHAR);
+	
+	#if configUSE_SHADOW_BUFFER == 1
+	
+		if (CURSOR_X_POSITION < LCD_LINE_LENGTH && CURSOR_Y_POSITION < LCD_LINES)
+		{
+			LCD_ShadowBuffer[CURSOR_Y_POSITION][CURSOR_X_POSITION] = character;
+			LCD_ShadowDirty = 1;
+		}
+		CURSOR_X_POSITION++;
+		return LCD_OK;
+	
+	#else
+	
+		return prvLCD_WRITE_DATA(character);
+	
+	#endif
+}
+
+/*****************************************************************************/
+/*************************/
+/*Library Clear Functions*/
+/*************************/
+
+/*!****************************************************************************
+*
+* \fn vLCD_CLEAR(void)
+*
+* \brief Function to clear the LCD Display
+*
+* \details Function is called to clear all data displayed on the LCD. Also
+*		   returns the cursor to the home location on the top row. The command
+*		   used to clear the display takes 1.53ms to run. Proper time needs
+*		   allocated to ensure no commands are sent to the display for that time
+*	
+* \params[in] nothing
+*	
+* \returns nothing	
+*
+* Modification History:
+*
+* 11/17/2013 - Original Function
+* 11/24/2013 - Added code to function
+* 10/18/2026 - Clear the shadow buffer when it is enabled
+* 10/18/2026 - Counted by the instrumentation
+* 10/18/2026 - Leave the warm start signature after the clear
+* 10/18/2026 - Block the calling task while the clear runs when it can
+*
+******************************************************************************
+*/
+void vLCD_CLEAR(void)
+{
+	LCD_STATS_ENTER(LCD_API_CLEAR);
+	
+	#if configUSE_SHADOW_BUFFER == 1
+		/*! Blank the shadow, the flush decides what needs sending */
+		prvLCD_SHADOW_FILL(0, LCD_LINES * LCD_LINE_LENGTH, ' ');
+		CURSOR_X_POSITION = 0;
+		CURSOR_Y_POSITION = 0;
+		return;
+	#endif
+	
+	/*! Call write command to send 0x01 command (clear) to the controller */
+	vWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_CLEAR_INSTRUCTION);
+	/*! Delay 1.53 ms to allow clear to finish */
+	LCD_EXECUTION_WAIT_US(1530);
+	
+	#if configUSE_WARM_START == 1
+		/*! The clear blanked the signature too */
+		prvLCD_WARM_SIGN();
+	#endif
+}
+
+/*!****************************************************************************
+*
+* \fn vLCD_CLEAR_TOP(void)
+*
+* \brief Function to clear the top line of the LCD Display
+*
+* \details Calls the function to clear line 0, which writes 24 spaces
+*		   and returns to the home position of the top row.
+*	
+* \params[in] nothing
+*	
+* \returns nothing	
+*
+* Modification History:
+*
+* 11/17/2013 - Original Function
+* 11/24/2013 - Added code to function
+* 10/18/2026 - Use the set-DDRAM based line clear
+*
+******************************************************************************
+*/
+void vLCD_CLEAR_TOP(void)
+{
+	/*! Call function to clear the top row */
+	vLCD_CLEAR_LINE(0);
+}
+
+/*!****************************************************************************
+*
+* \fn vLCD_CLEAR_BOTTOM(void)
+*
+* \brief Function to clear the bottom line of the LCD Display
+*
+* \details Calls the function to clear line 1, which writes 24 spaces
+*		   and returns to the home position of the bottom row.
+*	
+* \params[in] nothing
+*	
+* \returns nothing	
+*
+* Modification History:
+*
+* 11/17/2013 - Original Function
+* 11/24/2013 - Added code to function
+* 10/18/2026 - Use the set-DDRAM based line clear
+*
+******************************************************************************
+*/
+void vLCD_CLEAR_BOTTOM(void)
+{
+	/*! Call function to clear the bottom row */
+	vLCD_CLEAR_LINE(1);
+}
+
+/*!****************************************************************************
+*
+* \fn vLCD_CLEAR_LINE(uint8_t)
+*
+* \brief Function to clear one line of the LCD Display
+*
+* \details Writes spaces over the whole line, then sets the cursor to the
+*		   home position of that line. Only set-DDRAM instructions are used,
+*		   so neither the 1.53 ms clear nor the 1.53 ms return home is
+*		   needed.
+*	
+* \params[in] y - line to clear, 0 or 1
+*	
+* \returns nothing	
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Counted by the instrumentation
+*
+******************************************************************************
+*/
+void vLCD_CLEAR_LINE(uint8_t y)
+{
+	LCD_STATS_ENTER(LCD_API_CLEAR_LINE);
+	
+	/*! Blank every cell of the line */
+	vLCD_CLEAR_RANGE(0, y, LCD_LINE_LENGTH);
+	/*! Leave the cursor at the start of the line */
+	vLCD_HOME_LINE(y);
+}
+
+/*!****************************************************************************
+*
+* \fn vLCD_CLEAR_RANGE(uint8_t, uint8_t, uint8_t)
+*
+* \brief Function to clear part of a line of the LCD Display
+*
+* \details Writes spaces over length cells starting at x on line y. The
+*		   cursor is left on the cell after the range.
+*	
+* \params[in] x - first cell, y - line, length - number of cells
+*	
+* \returns nothing	
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+*
+******************************************************************************
+*/
+void vLCD_CLEAR_RANGE(uint8_t x, uint8_t y, uint8_t length)
+{
+	vLCD_FILL_RANGE(x, y, length, ' ');
+}
+
+/*!****************************************************************************
+*
+* \fn vLCD_FILL_RANGE(uint8_t, uint8_t, uint8_t, char)
+*
+* \brief Function to fill part of a line of the LCD Display
+*
+* \details Sets the DDRAM address once, then writes character into length
+*		   cells starting at x on line y. The range is clipped to the end of
+*		   the line and does not wrap onto the other line. The cursor is
+*		   left on the cell after the range.
+*	
+* \params[in] x - first cell, y - line, length - number of cells,
+*			  character - character to write
+*	
+* \returns nothing	
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Counted by the instrumentation
+*
+******************************************************************************
+*/
+void vLCD_FILL_RANGE(uint8_t x, uint8_t y, uint8_t length, char character)
+{
+	LCD_STATS_ENTER(LCD_API_FILL_RANGE);
+	
+	/*! Ignore ranges that start off the display */
+	if((y >= LCD_LINES) || (x >= LCD_LINE_LENGTH))
+	{
+		return;
+	}
+	
+	/*! Clip the range to the end of the line */
+	if(length > (LCD_LINE_LENGTH - x))
+	{
+		length = LCD_LINE_LENGTH - x;
+	}
+	
+	/*! One set-DDRAM instruction, then the data writes auto increment */
+	vLCD_GO_TO_POSITION(x, y);
+	
+	while(length--)
+	{
+		if(xLCD_WRITE_CHAR(character) != LCD_OK)
+		{
+			return;
+		}
+	}
+}
+
+/*!****************************************************************************
+*
+* \fn vLCD_ON_OFF(void)
+*
+* \brief Function to toggle LCD on and off
+*
+* \details Checks the current status of the LCD. If the LCD is on, toggle it
+*		   so it's off. If the LCD is off, turn it on. Uses the vLCD_WRITE
+*		   command to send instructions to the LCD.
+*	
+* \params[in] nothing
+*	
+* \returns nothing	
+*
+* Modification History:
+*
+* 11/18/2013 - Original Function
+* 11/24/2013 - Added code to function
+* 10/18/2026 - Counted by the instrumentation
+*
+******************************************************************************
+*/
+void vLCD_ON_OFF(void)
+{
+	LCD_STATS_ENTER(LCD_API_ON_OFF);
+	
+	/*! Create command to toggle LCD Display */
+	uint8_t LCD_Command = 
+		(1 << LCD_ON_OFF_INSTRCUTION) |
+		(OnOffStatus << LCD_ON_INSTRUCTION) |
+		(configCURSOR_SHOW << LCD_CURSOR_SHOW_INSTRUCTION) |
+		(configCURSOR_BLINK << LCD_CURSOR_BLINK_INSTRUCTION);
+	
+	/*! Toggle the OnOffStatus tracker variable */
+	OnOffStatus = OnOffStatus ^ 0x01;
+	
+	/*! Toggle LCD */
+	vWRITE_COMMAND_TO_LCD(0, LCD_Command);
+	/*! Delay greater than 39us to allow LCD to complete operation */
+	LCD_EXECUTION_DELAY_US(50);
+}
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***************************/
+/*Library Length Functions*/
+/*************************/
+
+/*!****************************************************************************
+ *
+ * \fn xGet_Top_Length(void)
+ *
+ * \brief Function to get the remaining characters on the LCD
+ *
+ * \details Function is called to calculate the amount of characters
+ *			remaining on the current line
+ *
+ *			This allows for tracking the amount of line space available.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns Number of characters remaining on the current line			
+ *
+ * Modification History:
+ *
+ * 11/17/2013 - Original Function
+ * 11/23/2013 - Added Code
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_Get_Length(void)
+{
+	return  (24 - CURSOR_X_POSITION); //returns number of characters left in the line
+}
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/************************/
+/*Library Home Functions*/
+/************************/
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_GO_TO_Position(uint8_t, uint8_t)
+ *
+ * \brief Function to directly control LCD cursor Position
+ *
+ * \details Function is called to move the LCD cursor to a specific location 
+ *				on the LCD.
+ *
+ *			Allows for direct control of where data can be written, rather
+ *				than only from the beginning of a line
+ *
+ *			Saves current cursor position for text wrapping
+ *
+ *			While the marquee or a page flip has the display shifted, x 
+ *				is the column showing on the glass, not the DDRAM cell
+ *			
+ * \params[in] 	Character, Row 	
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 11/15/2013 - Original Function
+ * 10/18/2026 - Only move the cursor when the shadow buffer is enabled
+ * 10/18/2026 - Removed the second delay, the write already waits
+ * 10/18/2026 - Counted by the instrumentation
+ * 10/18/2026 - Address the column showing while the display is shifted
+ *
+ ******************************************************************************
+ */
+void vLCD_GO_TO_POSITION(uint8_t x, uint8_t y)
+{
+	LCD_STATS_ENTER(LCD_API_GO_TO_POSITION);
+	
+	//save the current position
+	register uint8_t DDRAMAddr;
+	
+	// For each line o the LCD
+	switch(y)
+	{
+		case 0: 
+			//for the top line, set the DDRAM address 
+			//move a certain number of characters to the right
+			DDRAMAddr = LCD_LINE0_DDRAMADDR + LCD_SHIFTED_CELL(x);
+		break;
+		
+		case 1: 
+			//for the bottom line, set the DDRAM address 
+			//move a certain number of characters to the right
+			DDRAMAddr = LCD_LINE1_DDRAMADDR + LCD_SHIFTED_CELL(x);
+		break;
+		
+		default: 
+			//default to the top left of the LCD if nothing is specified
+			DDRAMAddr = LCD_LINE0_DDRAMADDR + LCD_SHIFTED_CELL(x);
+	}
+	
+	//save current cursor position X
+	CURSOR_X_POSITION = x;
+	//save current cursor position Y
+	CURSOR_Y_POSITION = y;
+	
+	#if configUSE_SHADOW_BUFFER == 1
+		// the flush places the cursor, nothing to send yet
+		(void)DDRAMAddr;
+		return;
+	#endif
+	
+	// send a command to set the data address
+	vWRITE_COMMAND_TO_LCD(INSTR_WR, 1 <<LCD_DDRAM | DDRAMAddr);
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_HOME_TOP_LINE(void)
+ *
+ * \brief Function to return to home position on the top line of the LCD
+ *
+ * \details Function is called to return the cursor to the first position
+ *				on the top line of the LCD.
+ *			
+ *			This allows for the the top line to be ready to write 
+ *				independently from the bottom line.
+ *			
+ * \params[in] none		
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 11/15/2013 - Original Function
+ * 10/18/2026 - Only move the cursor when the shadow buffer is enabled
+ * 10/18/2026 - Set the DDRAM address instead of the 1.53ms return home
+ *
+ ******************************************************************************
+ */
+void vLCD_HOME_TOP_LINE(void)
+{
+	//move cursor to the top left position of the LCD
+	vLCD_HOME_LINE(0);
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_HOME_BOTTOM_LINE(void)
+ *
+ * \brief Function to return to home position on the bottom line of the LCD
+ *
+ * \details Function is called to return the cursor to the first position
+ *				on the bottom line of the LCD.
+ *			
+ *			This allows for the the bottom line to be ready to write 
+ *				independently from the top line.
+ *			
+ * \params[in] none		
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 11/15/2013 - Original Function
+ * 10/18/2026 - Use the shared line home function
+ *
+ ******************************************************************************
+ */
+void vLCD_HOME_BOTTOM_LINE(void)
+{
+	//move the cursor to the bottom left position on the LCD
+	vLCD_HOME_LINE(1);
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_HOME_LINE(uint8_t)
+ *
+ * \brief Function to return to home position on any line of the LCD
+ *
+ * \details Function is called to move the cursor to the first position
+ *				of line y with a set-DDRAM instruction (39us), rather than
+ *				the return home instruction (1.53ms).
+ *			
+ *			Unlike return home this does not undo a display shift. While
+ *				the marquee or a page flip has the display shifted, the 
+ *				address is the cell showing in the first column.
+ *			
+ * \params[in] y - line, 0 or 1		
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Counted by the instrumentation
+ * 10/18/2026 - Home to the first column showing while the display is shifted
+ *
+ ******************************************************************************
+ */
+void vLCD_HOME_LINE(uint8_t y)
+{
+	LCD_STATS_ENTER(LCD_API_HOME);
+	
+	//move the cursor to the left position of the line
+	vLCD_GO_TO_POSITION(0, y);
+}
+
+/*****************************************************************************/
+ 
+ 
+
+/*****************************************************************************/
+/**********************************/
+/*Library Scatter Gather Functions*/
+/**********************************/
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_WRITE_SEGMENTS(LCD_Segment_t *, uint8_t)
+ *
+ * \brief Function to write several fields at different positions in one pass
+ *
+ * \details The segments are sorted in place by DDRAM address (line, then
+ *			column) and written in that order. A set DDRAM address is only
+ *			sent when the address counter is not already on the first cell
+ *			of a segment, so segments that follow on from each other cost
+ *			no extra instruction. Each segment writes exactly Length bytes,
+ *			clipped to the end of its line; no terminator is needed and
+ *			there is no text wrapping. The cursor is left after the last
+ *			segment. With the shadow buffer enabled the segments are copied
+ *			into the shadow and sent by the next vLCD_FLUSH.
+ *			
+ * \params[in] 	segments - array of segments, reordered by this function
+ *				count - number of segments
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Counted by the instrumentation
+ * 10/18/2026 - Address the columns showing while the display is shifted
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_WRITE_SEGMENTS(LCD_Segment_t *segments, uint8_t count)
+{
+	LCD_STATS_ENTER(LCD_API_SEGMENTS);
+	
+	LCD_Segment_t Key;
+	const char *Text;
+	uint8_t Length;
+	uint8_t i;
+	uint8_t j;
+	
+	/*! Insertion sort, status screens only have a handful of fields */
+	for (i = 1; i < count; i++)
+	{
+		Key = segments[i];
+		j = i;
+		while ((j > 0) &&
+			((segments[j - 1].Y > Key.Y) ||
+			((segments[j - 1].Y == Key.Y) && (segments[j - 1].X > Key.X))))
+		{
+			segments[j] = segments[j - 1];
+			j--;
+		}
+		segments[j] = Key;
+	}
+	
+	for (i = 0; i < count; i++)
+	{
+		Text = segments[i].Text;
+		Length = segments[i].Length;
+		
+		/*! Skip segments that start off the display, clip the rest */
+		if ((segments[i].Y >= LCD_LINES) || (segments[i].X >= LCD_LINE_LENGTH))
+		{
+			continue;
+		}
+		if (Length > (LCD_LINE_LENGTH - segments[i].X))
+		{
+			Length = LCD_LINE_LENGTH - segments[i].X;
+		}
+		
+		CURSOR_X_POSITION = segments[i].X;
+		CURSOR_Y_POSITION = segments[i].Y;
+		
+		#if configUSE_SHADOW_BUFFER == 1
+		
+			while (Length--)
+			{
+				LCD_ShadowBuffer[CURSOR_Y_POSITION][CURSOR_X_POSITION++] = *Text++;
+			}
+			LCD_ShadowDirty = 1;
+		
+		#else
+		
+			{
+				uint8_t Address = (segments[i].Y ? LCD_LINE1_DDRAMADDR :
+					LCD_LINE0_DDRAMADDR) + LCD_SHIFTED_CELL(segments[i].X);
+				
+				/*! Adjacent segments carry on from the auto increment */
+				if (LCD_AddressCounter != Address)
+				{
+					if (xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_DDRAM) | Address) != LCD_OK)
+					{
+						return LCD_ERROR_TIMEOUT;
+					}
+				}
+			}
+			
+			while (Length--)
+			{
+				if (prvLCD_WRITE_DATA(*Text++) != LCD_OK)
+				{
+					return LCD_ERROR_TIMEOUT;
+				}
+			}
+		
+		#endif
+	}
+	
+	return LCD_OK;
+}
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**************************/
+/*Library Layout Functions*/
+/**************************/
+
+#if configUSE_LAYOUT == 1
+
+/*! Cell the value compare is made against for column x of line y */
+#if configUSE_SHADOW_BUFFER == 1
+	#define LCD_LAYOUT_CURRENT(y, x)	LCD_ShadowBuffer[y][x]
+	#define LCD_LAYOUT_KNOWN()			1
+#else
+	#define LCD_LAYOUT_CURRENT(y, x)	LCD_GlassBuffer[y][LCD_SHIFTED_CELL(x)]
+	/*! Data written while the address counter is lost is not in the copy */
+	#define LCD_LAYOUT_KNOWN()			(LCD_AddressCounter != LCD_ADDRESS_UNKNOWN)
+#endif
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_LAYOUT_SHOW(const LCD_Field_t *, uint8_t)
+ *
+ * \brief Function to clear the display and draw the labels of a layout
+ *
+ * \details Makes fields, a table in flash, the layout xLCD_FIELD_SET works
+ *			on, clears the display and writes each label at its X,Y. The
+ *			value cells are left blank until set. This is the only place a
+ *			label is written, so call it once each time the screen is
+ *			entered. Give each field a name with an enum in table order:
+ *
+ *			static const char LabelTemp[] PROGMEM = "Temp ";
+ *			enum { FIELD_TEMP, FIELD_STATE, FIELDS };
+ *			static const LCD_Field_t Screen[FIELDS] PROGMEM =
+ *			{
+ *				LCD_FIELD(0, 0, LabelTemp, 6, LCD_ALIGN_RIGHT),
+ *				LCD_FIELD_VALUE(18, 0, 6, LCD_ALIGN_LEFT),
+ *			};
+ *			
+ * \params[in] 	fields - table of fields in flash
+ *				count - number of fields
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_LAYOUT_SHOW(const LCD_Field_t *fields, uint8_t count)
+{
+	LCD_STATS_ENTER(LCD_API_LAYOUT_SHOW);
+	
+	const LCD_Field_t *Field = fields;
+	const char *Label;
+	uint8_t Length;
+	
+	LCD_Layout = fields;
+	LCD_LayoutFields = count;
+	
+	vLCD_CLEAR();
+	
+	while (count--)
+	{
+		Label = (const char *)pgm_read_ptr(&Field->Label);
+		Length = pgm_read_byte(&Field->LabelLength);
+		
+		if (Label != NULL && Length)
+		{
+			vLCD_GO_TO_POSITION(pgm_read_byte(&Field->X), pgm_read_byte(&Field->Y));
+			while (Length--)
+			{
+				if (xLCD_WRITE_CHAR(pgm_read_byte(Label++)) != LCD_OK) return;
+			}
+		}
+		Field++;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_FIELD_SET(uint8_t, const char *)
+ *
+ * \brief Function to write the value of a field where it changed
+ *
+ * \details Renders text into the cells after the field's label, cut to
+ *			its width and padded with spaces on the side its alignment
+ *			says, and compares them with what the display holds, or with
+ *			the shadow buffer when it is enabled. Nothing is sent when they
+ *			match; otherwise the cells from the first to the last that
+ *			differ are written, with a set DDRAM address only when the
+ *			address counter is not already on the first. Without the shadow
+ *			buffer every cell is written while the address counter is
+ *			lost, since what the display holds is not known then. The
+ *			cursor is left after the last cell written.
+ *			
+ * \params[in] 	field - number of the field in the layout on the display
+ *				text - zero terminated value
+ *			
+ * \returns LCD_OK, LCD_ERROR_NO_FIELD, or LCD_ERROR_TIMEOUT if the
+ *			controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Compare and address the columns showing while the display is shifted
+ * 10/18/2026 - Write every cell while the address counter is lost
+ * 10/18/2026 - Return at once for a label only field
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_FIELD_SET(uint8_t field, const char *text)
+{
+	LCD_STATS_ENTER(LCD_API_FIELD_SET);
+	
+	const LCD_Field_t *Field;
+	char Cells[LCD_LINE_LENGTH];
+	uint8_t X;
+	uint8_t Y;
+	uint8_t Width;
+	uint8_t Length;
+	uint8_t Pad;
+	uint8_t First;
+	uint8_t Last;
+	
+	if (field >= LCD_LayoutFields) return LCD_ERROR_NO_FIELD;
+	
+	Field = &LCD_Layout[field];
+	X = pgm_read_byte(&Field->X) + pgm_read_byte(&Field->LabelLength);
+	Y = pgm_read_byte(&Field->Y);
+	Width = pgm_read_byte(&Field->Width);
+	
+	/*! Clip the field to the line, a label only field has no cells */
+	if ((Y >= LCD_LINES) || (X >= LCD_LINE_LENGTH) || (Width == 0)) return LCD_OK;
+	if (Width > (LCD_LINE_LENGTH - X)) Width = LCD_LINE_LENGTH - X;
+	
+	/*! Render the value as it will look, padded to the width */
+	for (Length = 0; (Length < Width) && text[Length]; Length++);
+	switch (pgm_read_byte(&Field->Align))
+	{
+		case LCD_ALIGN_RIGHT:
+			Pad = Width - Length;
+		break;
+		
+		case LCD_ALIGN_CENTER:
+			Pad = (Width - Length) / 2;
+		break;
+		
+		default:
+			Pad = 0;
+		break;
+	}
+	for (First = 0; First < Width; First++)
+	{
+		Cells[First] = ((First >= Pad) && (First < Pad + Length)) ?
+			text[First - Pad] : ' ';
+	}
+	
+	/*! Only the cells from the first to the last change are written */
+	First = 0;
+	Last = Width - 1;
+	if (LCD_LAYOUT_KNOWN())
+	{
+		for (; (First < Width) &&
+			(LCD_LAYOUT_CURRENT(Y, X + First) == (uint8_t)Cells[First]); First++);
+		if (First == Width) return LCD_OK;
+		for (; LCD_LAYOUT_CURRENT(Y, X + Last) == (uint8_t)Cells[Last]; Last--);
+	}
+	
+	CURSOR_X_POSITION = X + First;
+	CURSOR_Y_POSITION = Y;
+	
+	#if configUSE_SHADOW_BUFFER == 0
+		{
+			uint8_t Address = (Y ? LCD_LINE1_DDRAMADDR : LCD_LINE0_DDRAMADDR) +
+				LCD_SHIFTED_CELL(X + First);
+			
+			if (LCD_AddressCounter != Address)
+			{
+				if (xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_DDRAM) | Address) != LCD_OK)
+				{
+					return LCD_ERROR_TIMEOUT;
+				}
+			}
+		}
+	#endif
+	
+	for (; First <= Last; First++)
+	{
+		if (xLCD_WRITE_CHAR(Cells[First]) != LCD_OK) return LCD_ERROR_TIMEOUT;
+	}
+	
+	return LCD_OK;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***************************/
+/*Library Number Functions*/
+/***************************/
+
+/*! Powers of ten for the decimal digits, kept in flash */
+static const uint32_t LCD_PowersOfTen[10] PROGMEM =
+{
+	1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL,
+	1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_WRITE_REPEAT(char, uint8_t)
+ *
+ * \brief Function to write the same character several times
+ *			
+ * \params[in] 	character, count
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_WRITE_REPEAT(char character, uint8_t count)
+{
+	while (count--)
+	{
+		if (xLCD_WRITE_CHAR(character) != LCD_OK)
+		{
+			return LCD_ERROR_TIMEOUT;
+		}
+	}
+	
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_WRITE_NUMBER(uint32_t, uint8_t, uint8_t, uint8_t, uint8_t, uint8_t)
+ *
+ * \brief Function to write a magnitude with sign, padding and decimal point
+ *
+ * \details Works out the number of digits first, so the padding can be
+ *			written before the digits and nothing has to be buffered. Decimal
+ *			digits are found by subtracting powers of ten, which avoids the
+ *			32-bit division the AVR has no instruction for. Hex digits are
+ *			taken four bits at a time.
+ *			
+ * \params[in] 	magnitude - value without its sign
+ *				negative - write a minus sign
+ *				decimals - digits after the decimal point, decimal only
+ *				width - minimum characters to write
+ *				flags - LCD_NUM_ flags
+ *				hex - write in base 16 instead of base 10
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Counted by the instrumentation
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_WRITE_NUMBER(uint32_t magnitude, uint8_t negative,
+	uint8_t decimals, uint8_t width, uint8_t flags, uint8_t hex)
+{
+	LCD_STATS_ENTER(LCD_API_NUMBER);
+	
+	uint8_t Digits = 1;
+	uint8_t Length;
+	uint8_t Pad = 0;
+	char Sign = 0;
+	
+	/*! Count the digits */
+	if (hex)
+	{
+		while ((Digits < 8) && (magnitude >> (Digits * 4)))
+		{
+			Digits++;
+		}
+	}
+	else
+	{
+		while ((Digits < 10) && (magnitude >= pgm_read_dword(&LCD_PowersOfTen[Digits])))
+		{
+			Digits++;
+		}
+		/*! Always one digit in front of the decimal point */
+		if (Digits <= decimals)
+		{
+			Digits = decimals + 1;
+		}
+	}
+	
+	if (negative)
+	{
+		Sign = '-';
+	}
+	else if (flags & LCD_NUM_PLUS)
+	{
+		Sign = '+';
+	}
+	
+	Length = Digits + (decimals ? 1 : 0) + (Sign ? 1 : 0);
+	if (width > Length)
+	{
+		Pad = width - Length;
+	}
+	
+	/*! Leading spaces, then the sign, then leading zeros */
+	if (!(flags & (LCD_NUM_LEFT | LCD_NUM_ZERO)))
+	{
+		if (prvLCD_WRITE_REPEAT(' ', Pad) != LCD_OK) return LCD_ERROR_TIMEOUT;
+	}
+	if (Sign)
+	{
+		if (xLCD_WRITE_CHAR(Sign) != LCD_OK) return LCD_ERROR_TIMEOUT;
+	}
+	if ((flags & LCD_NUM_ZERO) && !(flags & LCD_NUM_LEFT))
+	{
+		if (prvLCD_WRITE_REPEAT('0', Pad) != LCD_OK) return LCD_ERROR_TIMEOUT;
+	}
+	
+	while (Digits--)
+	{
+		char Digit;
+		
+		if (hex)
+		{
+			Digit = (magnitude >> (Digits * 4)) & 0x0F;
+			Digit = (Digit < 10) ? (Digit + '0') : (Digit - 10 + 'A');
+		}
+		else
+		{
+			uint32_t Power = pgm_read_dword(&LCD_PowersOfTen[Digits]);
+			
+			Digit = '0';
+			while (magnitude >= Power)
+			{
+				magnitude -= Power;
+				Digit++;
+			}
+		}
+		
+		if (xLCD_WRITE_CHAR(Digit) != LCD_OK) return LCD_ERROR_TIMEOUT;
+		
+		if (decimals && (Digits == decimals))
+		{
+			if (xLCD_WRITE_CHAR('.') != LCD_OK) return LCD_ERROR_TIMEOUT;
+		}
+	}
+	
+	/*! Trailing spaces when left aligned */
+	if (flags & LCD_NUM_LEFT)
+	{
+		if (prvLCD_WRITE_REPEAT(' ', Pad) != LCD_OK) return LCD_ERROR_TIMEOUT;
+	}
+	
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_WRITE_UNSIGNED(uint32_t, uint8_t, uint8_t)
+ *
+ * \brief Function to write an unsigned integer at the cursor
+ *
+ * \details Writes value in decimal, padded to at least width characters.
+ *			Right aligned with spaces unless flags has LCD_NUM_LEFT
+ *			(spaces after) or LCD_NUM_ZERO (zeros in front).
+ *			
+ * \params[in] 	value, width, flags
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_WRITE_UNSIGNED(uint32_t value, uint8_t width, uint8_t flags)
+{
+	return prvLCD_WRITE_NUMBER(value, 0, 0, width, flags, 0);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_WRITE_SIGNED(int32_t, uint8_t, uint8_t)
+ *
+ * \brief Function to write a signed integer at the cursor
+ *
+ * \details Same as xLCD_WRITE_UNSIGNED with a leading minus sign for
+ *			negative values, or a plus sign for the others when flags has
+ *			LCD_NUM_PLUS. Zero padding goes between the sign and the digits.
+ *			
+ * \params[in] 	value, width, flags
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_WRITE_SIGNED(int32_t value, uint8_t width, uint8_t flags)
+{
+	return xLCD_WRITE_FIXED(value, 0, width, flags);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_WRITE_FIXED(int32_t, uint8_t, uint8_t, uint8_t)
+ *
+ * \brief Function to write a fixed point number at the cursor
+ *
+ * \details value holds the number scaled by 10 to the power decimals, so
+ *			xLCD_WRITE_FIXED(-1234, 2, 0, 0) writes "-12.34" and
+ *			xLCD_WRITE_FIXED(5, 2, 0, 0) writes "0.05". Sign, width and
+ *			flags work as in xLCD_WRITE_SIGNED, the point counts towards
+ *			the width.
+ *			
+ * \params[in] 	value, decimals (0-9), width, flags
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_WRITE_FIXED(int32_t value, uint8_t decimals, uint8_t width, uint8_t flags)
+{
+	/*! Negate as unsigned so the most negative value survives */
+	uint32_t Magnitude = (value < 0) ? (0UL - (uint32_t)value) : (uint32_t)value;
+	
+	if (decimals > 9)
+	{
+		decimals = 9;
+	}
+	
+	return prvLCD_WRITE_NUMBER(Magnitude, (value < 0), decimals, width, flags, 0);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_WRITE_HEX(uint32_t, uint8_t, uint8_t)
+ *
+ * \brief Function to write a number in hexadecimal at the cursor
+ *
+ * \details Upper case digits with no prefix. Use LCD_NUM_ZERO with a
+ *			width to get a fixed number of digits, e.g. width 4 for a
+ *			16-bit register.
+ *			
+ * \params[in] 	value, width, flags
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_WRITE_HEX(uint32_t value, uint8_t width, uint8_t flags)
+{
+	return prvLCD_WRITE_NUMBER(value, 0, 0, width, flags & (uint8_t)~LCD_NUM_PLUS, 1);
+}
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library UTF-8 Functions*/
+/*************************/
+
+#if configUSE_UTF8 == 1
+
+/*! Returned by the decoder for malformed text and code points past U+FFFF */
+#define LCD_UTF8_INVALID	0xFFFF
+
+/*! Code points the character ROM has, sorted, kept in flash */
+#if configLCD_ROM == LCD_ROM_A00
+static const LCD_Utf8Range_t LCD_Utf8Rom[] PROGMEM =
+{
+	{ 0x00A2, 0x00A3, 0xEC, 0x00 },	// cent sign to pound sign
+	{ 0x00A5, 0x00A5, 0x5C, 0x00 },	// yen sign
+	{ 0x00B0, 0x00B0, 0xDF, 0x00 },	// degree sign
+	{ 0x00B5, 0x00B5, 0xE4, 0x00 },	// micro sign
+	{ 0x00B7, 0x00B7, 0xA5, 0x00 },	// middle dot
+	{ 0x00DF, 0x00DF, 0xE2, 0x00 },	// latin small letter sharp s
+	{ 0x00E4, 0x00E4, 0xE1, 0x00 },	// latin small letter a with diaeresis
+	{ 0x00F1, 0x00F1, 0xEE, 0x00 },	// latin small letter n with tilde
+	{ 0x00F6, 0x00F6, 0xEF, 0x00 },	// latin small letter o with diaeresis
+	{ 0x00F7, 0x00F7, 0xFD, 0x00 },	// division sign
+	{ 0x00FC, 0x00FC, 0xF5, 0x00 },	// latin small letter u with diaeresis
+	{ 0x03A3, 0x03A3, 0xF6, 0x00 },	// greek capital letter sigma
+	{ 0x03A9, 0x03A9, 0xF4, 0x00 },	// greek capital letter omega
+	{ 0x03B1, 0x03B1, 0xE0, 0x00 },	// greek small letter alpha
+	{ 0x03B2, 0x03B2, 0xE2, 0x00 },	// greek small letter beta
+	{ 0x03B5, 0x03B5, 0xE3, 0x00 },	// greek small letter epsilon
+	{ 0x03B8, 0x03B8, 0xF2, 0x00 },	// greek small letter theta
+	{ 0x03BC, 0x03BC, 0xE4, 0x00 },	// greek small letter mu
+	{ 0x03C0, 0x03C0, 0xF7, 0x00 },	// greek small letter pi
+	{ 0x03C1, 0x03C1, 0xE6, 0x00 },	// greek small letter rho
+	{ 0x03C3, 0x03C3, 0xE5, 0x00 },	// greek small letter sigma
+	{ 0x2126, 0x2126, 0xF4, 0x00 },	// ohm sign
+	{ 0x2190, 0x2190, 0x7F, 0x00 },	// leftwards arrow
+	{ 0x2192, 0x2192, 0x7E, 0x00 },	// rightwards arrow
+	{ 0x221A, 0x221A, 0xE8, 0x00 },	// square root
+	{ 0x221E, 0x221E, 0xF3, 0x00 },	// infinity
+	{ 0x2588, 0x2588, 0xFF, 0x00 },	// full block
+	{ 0x3001, 0x3001, 0xA4, 0x00 },	// comma
+	{ 0x3002, 0x3002, 0xA1, 0x00 },	// full stop
+	{ 0x300C, 0x300D, 0xA2, 0x00 },	// corner brackets
+	{ 0x309B, 0x309C, 0xDE, 0x00 },	// voiced sound mark to semi-voiced sound mark
+	{ 0x30A1, 0x30A1, 0xA7, 0x00 },	// small a
+	{ 0x30A2, 0x30A2, 0xB1, 0x00 },	// a
+	{ 0x30A3, 0x30A3, 0xA8, 0x00 },	// small i
+	{ 0x30A4, 0x30A4, 0xB2, 0x00 },	// i
+	{ 0x30A5, 0x30A5, 0xA9, 0x00 },	// small u
+	{ 0x30A6, 0x30A6, 0xB3, 0x00 },	// u
+	{ 0x30A7, 0x30A7, 0xAA, 0x00 },	// small e
+	{ 0x30A8, 0x30A8, 0xB4, 0x00 },	// e
+	{ 0x30A9, 0x30A9, 0xAB, 0x00 },	// small o
+	{ 0x30AA, 0x30AB, 0xB5, 0x00 },	// o to ka
+	{ 0x30AC, 0x30AC, 0xB6, 0xDE },	// ga
+	{ 0x30AD, 0x30AD, 0xB7, 0x00 },	// ki
+	{ 0x30AE, 0x30AE, 0xB7, 0xDE },	// gi
+	{ 0x30AF, 0x30AF, 0xB8, 0x00 },	// ku
+	{ 0x30B0, 0x30B0, 0xB8, 0xDE },	// gu
+	{ 0x30B1, 0x30B1, 0xB9, 0x00 },	// ke
+	{ 0x30B2, 0x30B2, 0xB9, 0xDE },	// ge
+	{ 0x30B3, 0x30B3, 0xBA, 0x00 },	// ko
+	{ 0x30B4, 0x30B4, 0xBA, 0xDE },	// go
+	{ 0x30B5, 0x30B5, 0xBB, 0x00 },	// sa
+	{ 0x30B6, 0x30B6, 0xBB, 0xDE },	// za
+	{ 0x30B7, 0x30B7, 0xBC, 0x00 },	// si
+	{ 0x30B8, 0x30B8, 0xBC, 0xDE },	// zi
+	{ 0x30B9, 0x30B9, 0xBD, 0x00 },	// su
+	{ 0x30BA, 0x30BA, 0xBD, 0xDE },	// zu
+	{ 0x30BB, 0x30BB, 0xBE, 0x00 },	// se
+	{ 0x30BC, 0x30BC, 0xBE, 0xDE },	// ze
+	{ 0x30BD, 0x30BD, 0xBF, 0x00 },	// so
+	{ 0x30BE, 0x30BE, 0xBF, 0xDE },	// zo
+	{ 0x30BF, 0x30BF, 0xC0, 0x00 },	// ta
+	{ 0x30C0, 0x30C0, 0xC0, 0xDE },	// da
+	{ 0x30C1, 0x30C1, 0xC1, 0x00 },	// ti
+	{ 0x30C2, 0x30C2, 0xC1, 0xDE },	// di
+	{ 0x30C3, 0x30C3, 0xAF, 0x00 },	// small tu
+	{ 0x30C4, 0x30C4, 0xC2, 0x00 },	// tu
+	{ 0x30C5, 0x30C5, 0xC2, 0xDE },	// du
+	{ 0x30C6, 0x30C6, 0xC3, 0x00 },	// te
+	{ 0x30C7, 0x30C7, 0xC3, 0xDE },	// de
+	{ 0x30C8, 0x30C8, 0xC4, 0x00 },	// to
+	{ 0x30C9, 0x30C9, 0xC4, 0xDE },	// do
+	{ 0x30CA, 0x30CF, 0xC5, 0x00 },	// na to ha
+	{ 0x30D0, 0x30D0, 0xCA, 0xDE },	// ba
+	{ 0x30D1, 0x30D1, 0xCA, 0xDF },	// pa
+	{ 0x30D2, 0x30D2, 0xCB, 0x00 },	// hi
+	{ 0x30D3, 0x30D3, 0xCB, 0xDE },	// bi
+	{ 0x30D4, 0x30D4, 0xCB, 0xDF },	// pi
+	{ 0x30D5, 0x30D5, 0xCC, 0x00 },	// hu
+	{ 0x30D6, 0x30D6, 0xCC, 0xDE },	// bu
+	{ 0x30D7, 0x30D7, 0xCC, 0xDF },	// pu
+	{ 0x30D8, 0x30D8, 0xCD, 0x00 },	// he
+	{ 0x30D9, 0x30D9, 0xCD, 0xDE },	// be
+	{ 0x30DA, 0x30DA, 0xCD, 0xDF },	// pe
+	{ 0x30DB, 0x30DB, 0xCE, 0x00 },	// ho
+	{ 0x30DC, 0x30DC, 0xCE, 0xDE },	// bo
+	{ 0x30DD, 0x30DD, 0xCE, 0xDF },	// po
+	{ 0x30DE, 0x30E2, 0xCF, 0x00 },	// ma to mo
+	{ 0x30E3, 0x30E3, 0xAC, 0x00 },	// small ya
+	{ 0x30E4, 0x30E4, 0xD4, 0x00 },	// ya
+	{ 0x30E5, 0x30E5, 0xAD, 0x00 },	// small yu
+	{ 0x30E6, 0x30E6, 0xD5, 0x00 },	// yu
+	{ 0x30E7, 0x30E7, 0xAE, 0x00 },	// small yo
+	{ 0x30E8, 0x30EE, 0xD6, 0x00 },	// yo to small wa
+	{ 0x30EF, 0x30EF, 0xDC, 0x00 },	// wa
+	{ 0x30F0, 0x30F0, 0xB2, 0x00 },	// wi
+	{ 0x30F1, 0x30F1, 0xB4, 0x00 },	// we
+	{ 0x30F2, 0x30F2, 0xA6, 0x00 },	// wo
+	{ 0x30F3, 0x30F3, 0xDD, 0x00 },	// n
+	{ 0x30F4, 0x30F4, 0xB3, 0xDE },	// vu
+	{ 0x30F5, 0x30F5, 0xB6, 0x00 },	// small ka
+	{ 0x30F6, 0x30F6, 0xB9, 0x00 },	// small ke
+	{ 0x30F7, 0x30F7, 0xDC, 0xDE },	// va
+	{ 0x30F8, 0x30F8, 0xB2, 0xDE },	// vi
+	{ 0x30F9, 0x30F9, 0xB4, 0xDE },	// ve
+	{ 0x30FA, 0x30FA, 0xA6, 0xDE },	// vo
+	{ 0x30FB, 0x30FB, 0xA5, 0x00 },	// katakana middle dot
+	{ 0x30FC, 0x30FC, 0xB0, 0x00 },	// prolonged sound mark
+	{ 0x4E07, 0x4E07, 0xFB, 0x00 },	// cjk unified ideograph-4e07
+	{ 0x5186, 0x5186, 0xFC, 0x00 },	// cjk unified ideograph-5186
+	{ 0x5343, 0x5343, 0xFA, 0x00 },	// cjk unified ideograph-5343
+	{ 0xFF61, 0xFF9F, 0xA1, 0x00 },	// halfwidth full stop to halfwidth semi-voiced sound mark
+};
+#else
+static const LCD_Utf8Range_t LCD_Utf8Rom[] PROGMEM =
+{
+	{ 0x00A1, 0x00FF, 0xA1, 0x00 },	// inverted exclamation mark to y with diaeresis
+};
+#endif
+
+/*! Number of ranges in LCD_Utf8Rom */
+#define LCD_UTF8_RANGES		(sizeof(LCD_Utf8Rom) / sizeof(LCD_Utf8Rom[0]))
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_UTF8_DECODE(const char **text)
+ *
+ * \brief Function to decode one character that is not ASCII
+ *
+ * \details Reads a lead byte and its continuation bytes and moves *text
+ *			past them. A stray continuation byte, a bad lead byte or an
+ *			overlong form is one malformed character; a sequence cut short
+ *			ends before the byte that cut it, so that byte is decoded next.
+ *			Four byte sequences are read whole but are past the tables.
+ *			
+ * \params[in] 	text, moved past the character
+ *			
+ * \returns The code point, or LCD_UTF8_INVALID
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint16_t prvLCD_UTF8_DECODE(const char **text)
+{
+	const uint8_t *Byte = (const uint8_t *)*text;
+	uint8_t Lead = *Byte++;
+	uint16_t CodePoint;
+	uint16_t Least;
+	uint8_t More;
+	
+	if ((Lead & 0xE0) == 0xC0)
+	{
+		CodePoint = Lead & 0x1F;
+		Least = 0x80;
+		More = 1;
+	}
+	else if ((Lead & 0xF0) == 0xE0)
+	{
+		CodePoint = Lead & 0x0F;
+		Least = 0x800;
+		More = 2;
+	}
+	else if ((Lead & 0xF8) == 0xF0)
+	{
+		/*! Past U+FFFF, read to keep in step and then refused */
+		CodePoint = 0;
+		Least = LCD_UTF8_INVALID;
+		More = 3;
+	}
+	else
+	{
+		*text = (const char *)Byte;
+		return LCD_UTF8_INVALID;
+	}
+	
+	while (More--)
+	{
+		if ((*Byte & 0xC0) != 0x80)
+		{
+			*text = (const char *)Byte;
+			return LCD_UTF8_INVALID;
+		}
+		CodePoint = (CodePoint << 6) | (*Byte++ & 0x3F);
+	}
+	*text = (const char *)Byte;
+	
+	return (CodePoint < Least) ? LCD_UTF8_INVALID : CodePoint;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_UTF8_ROM(uint16_t codepoint, uint8_t *mark)
+ *
+ * \brief Function to find the ROM code of a code point
+ *
+ * \details Binary search of LCD_Utf8Rom. On the A00 ROM hiragana is shown
+ *			as the katakana of the same sound, and voiced katakana as the
+ *			plain one followed by the voiced sound mark in *mark.
+ *			
+ * \params[in] 	codepoint
+ * \params[in] 	mark, second ROM code to write, 0 for none
+ *			
+ * \returns The ROM code, or 0 when the ROM has none
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_UTF8_ROM(uint16_t codepoint, uint8_t *mark)
+{
+	const LCD_Utf8Range_t *Range;
+	uint8_t Low = 0;
+	uint8_t High = LCD_UTF8_RANGES;
+	uint8_t Middle;
+	
+	#if configLCD_ROM == LCD_ROM_A00
+		if ((codepoint >= 0x3041) && (codepoint <= 0x3096))
+			codepoint += 0x60;
+	#endif
+	
+	while (Low < High)
+	{
+		Middle = (Low + High) / 2;
+		Range = &LCD_Utf8Rom[Middle];
+		
+		if (codepoint < pgm_read_word(&Range->First))
+			High = Middle;
+		else if (codepoint > pgm_read_word(&Range->Last))
+			Low = Middle + 1;
+		else
+		{
+			*mark = pgm_read_byte(&Range->Mark);
+			return pgm_read_byte(&Range->Rom) + (codepoint - pgm_read_word(&Range->First));
+		}
+	}
+	
+	return 0;
+}
+
+#endif
+
+#if configUSE_UTF8_GLYPHS == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_UTF8_GLYPH(uint16_t codepoint)
+ *
+ * \brief Function to load the glyph of a code point the ROM lacks
+ *
+ * \details Looks the code point up in the map given to vLCD_UTF8_GLYPHS
+ *			and gets its CGRAM code from the glyph cache.
+ *			
+ * \params[in] 	codepoint
+ *			
+ * \returns The CGRAM code, or 0 when the code point is not mapped or the
+ *			cache could not load it
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_UTF8_GLYPH(uint16_t codepoint)
+{
+	const LCD_Utf8Glyph_t *Entry = LCD_Utf8Glyphs;
+	uint8_t Count = LCD_Utf8GlyphCount;
+	char Code;
+	
+	while (Count--)
+	{
+		if (pgm_read_word(&Entry->CodePoint) == codepoint)
+		{
+			if (xLCD_GLYPH_CODE(pgm_read_byte(&Entry->Glyph), &Code) != LCD_OK)
+				return 0;
+			return (uint8_t)Code;
+		}
+		Entry++;
+	}
+	
+	return 0;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_UTF8_GLYPHS(const LCD_Utf8Glyph_t *map, uint8_t count)
+ *
+ * \brief Function to register the characters drawn from glyphs
+ *
+ * \details map is a table in flash pairing code points with IDs of the
+ *			glyph table given to vLCD_GLYPH_TABLE. It is only looked at for
+ *			characters the ROM table has no code for, for example the
+ *			capital umlauts on the A00 ROM.
+ *			
+ * \params[in] 	map, count
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_UTF8_GLYPHS(const LCD_Utf8Glyph_t *map, uint8_t count)
+{
+	LCD_Utf8Glyphs = map;
+	LCD_Utf8GlyphCount = count;
+}
+
+#endif
+
+#if configUSE_UTF8 == 1
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_WRITE_UTF8(const char *text)
+ *
+ * \brief Function to write UTF-8 text as character ROM codes
+ *
+ * \details Bytes below 0x80 are written as they are, the same loop as
+ *			vLCD_WRITE_STRING with one test of bit 7 and one of the mark
+ *			added. Anything else is decoded and looked up in the table for
+ *			configLCD_ROM, then with configUSE_UTF8_GLYPHS in the glyph map,
+ *			and written as configUTF8_REPLACEMENT when neither has it. A
+ *			character the ROM shows with a voiced sound mark takes two
+ *			cells. Note the A00 ROM shows a backslash as a yen sign and '~' as an
+ *			arrow.
+ *			
+ * \params[in] 	text, zero terminated UTF-8
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_WRITE_UTF8(const char *text)
+{
+	LCD_STATS_ENTER(LCD_API_WRITE_UTF8);
+	
+	uint16_t CodePoint;
+	uint8_t Code;
+	uint8_t Mark;
+	
+	while ((Code = (uint8_t)*text) != '\0')
+	{
+		Mark = 0;
+		
+		if (Code < 0x80)
+		{
+			text++;
+		}
+		else
+		{
+			CodePoint = prvLCD_UTF8_DECODE(&text);
+			Code = (CodePoint == LCD_UTF8_INVALID) ? 0 : prvLCD_UTF8_ROM(CodePoint, &Mark);
+			
+			#if configUSE_UTF8_GLYPHS == 1
+				if (!Code && CodePoint != LCD_UTF8_INVALID)
+					Code = prvLCD_UTF8_GLYPH(CodePoint);
+			#endif
+			
+			if (!Code)
+				Code = configUTF8_REPLACEMENT;
+		}
+		
+		for (;;)
+		{
+			/*! If text wrap is enabled */
+			#ifdef configTEXT_WRAP
+				#if configTEXT_WRAP == 1
+					if (xLCD_Get_Length() <= 0 && CURSOR_Y_POSITION == 0)
+						vLCD_HOME_BOTTOM_LINE();
+				#endif
+			#endif
+			
+			if (xLCD_WRITE_CHAR(Code) != LCD_OK)
+				return LCD_ERROR_TIMEOUT;
+			
+			if (!Mark) break;
+			Code = Mark;
+			Mark = 0;
+		}
+	}
+	
+	return LCD_OK;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library Glyph Functions*/
+/*************************/
+
+#if configUSE_GLYPH_CACHE == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_GLYPH_VISIBLE(uint8_t slot)
+ *
+ * \brief Function to check if a CGRAM slot is shown by any cell
+ *
+ * \details Character codes slot and slot + 8 both show the slot. With the
+ *			shadow buffer the cells still waiting for a flush count too.
+ *			
+ * \params[in] 	slot, 0 to 7
+ *			
+ * \returns 1 if a cell shows the slot, else 0
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Check every DDRAM cell the marquee can shift into view
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_GLYPH_VISIBLE(uint8_t slot)
+{
+	const uint8_t *Cell = &LCD_GlassBuffer[0][0];
+	uint8_t Count = LCD_LINES * LCD_GLASS_LENGTH;
+	
+	while (Count--)
+	{
+		if ((*Cell++ & (uint8_t)~LCD_GLYPH_SLOTS) == slot) return 1;
+	}
+	
+	#if configUSE_SHADOW_BUFFER == 1
+		Cell = &LCD_ShadowBuffer[0][0];
+		Count = LCD_LINES * LCD_LINE_LENGTH;
+		
+		while (Count--)
+		{
+			if ((*Cell++ & (uint8_t)~LCD_GLYPH_SLOTS) == slot) return 1;
+		}
+	#endif
+	
+	return 0;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_GLYPH_USE(uint8_t slot)
+ *
+ * \brief Function to move a slot to the front of LCD_GlyphLru
+ *			
+ * \params[in] 	slot, 0 to 7
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static void prvLCD_GLYPH_USE(uint8_t slot)
+{
+	uint8_t i = 0;
+	
+	while (LCD_GlyphLru[i] != slot) i++;
+	
+	/*! Shift the more recently used slots back one place */
+	while (i > 0)
+	{
+		LCD_GlyphLru[i] = LCD_GlyphLru[i - 1];
+		i--;
+	}
+	
+	LCD_GlyphLru[0] = slot;
+}
+
+#if configUSE_BAR_GRAPH == 1
+
+/*! Built in bar glyphs, LCD_GLYPH_BAR(1) to (4) then LCD_GLYPH_SPARK(1) to (7) */
+static const uint8_t LCD_BarGlyphs[LCD_GLYPH_BUILTIN_COUNT * LCD_GLYPH_ROWS] PROGMEM =
+{
+	0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+	0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F,
+	0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F
+};
+
+#endif
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_GLYPH_PATTERN(uint8_t id)
+ *
+ * \brief Function to find the rows of a glyph in flash
+ *			
+ * \params[in] 	id, from the application table or LCD_GLYPH_BUILTIN on
+ *			
+ * \returns The first row, or 0 if there is no such glyph
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static const uint8_t *prvLCD_GLYPH_PATTERN(uint8_t id)
+{
+	#if configUSE_BAR_GRAPH == 1
+		if ((id >= LCD_GLYPH_BUILTIN) && (id < LCD_GLYPH_BUILTIN + LCD_GLYPH_BUILTIN_COUNT))
+		{
+			return LCD_BarGlyphs + (uint16_t)(id - LCD_GLYPH_BUILTIN) * LCD_GLYPH_ROWS;
+		}
+	#endif
+	
+	if (id >= LCD_GlyphCount)
+	{
+		return 0;
+	}
+	
+	return LCD_GlyphTable + (uint16_t)id * LCD_GLYPH_ROWS;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_GLYPH_LOAD(uint8_t slot, uint8_t id)
+ *
+ * \brief Function to send a glyph to a CGRAM slot
+ *
+ * \details Sends set CGRAM address and the eight rows, then points the
+ *			address counter back at the DDRAM cell it was on, or at the
+ *			cursor if that was not known. The cursor does not move.
+ *			
+ * \params[in] 	slot, 0 to 7, and the glyph id
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Patterns found with prvLCD_GLYPH_PATTERN
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_GLYPH_LOAD(uint8_t slot, uint8_t id)
+{
+	const uint8_t *Pattern = prvLCD_GLYPH_PATTERN(id);
+	uint8_t Address = LCD_AddressCounter;
+	uint8_t SavedX = CURSOR_X_POSITION;
+	uint8_t Result;
+	uint8_t Row;
+	
+	/*! The slot holds nothing known until every row is in */
+	LCD_GlyphSlot[slot] = LCD_GLYPH_NONE;
+	
+	Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_CGRAM) | (slot * LCD_GLYPH_ROWS));
+	
+	for (Row = 0; (Row < LCD_GLYPH_ROWS) && (Result == LCD_OK); Row++)
+	{
+		Result = xWRITE_COMMAND_TO_LCD(DATA_WR, pgm_read_byte(Pattern + Row));
+	}
+	
+	/*! CGRAM writes do not move the cursor */
+	CURSOR_X_POSITION = SavedX;
+	
+	if (Result != LCD_OK)
+	{
+		return Result;
+	}
+	
+	LCD_GlyphSlot[slot] = id;
+	
+	if (Address != LCD_ADDRESS_UNKNOWN)
+	{
+		return xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_DDRAM) | Address);
+	}
+	
+	vLCD_GO_TO_POSITION(CURSOR_X_POSITION, CURSOR_Y_POSITION);
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_GLYPH_TABLE(const uint8_t *patterns, uint8_t count)
+ *
+ * \brief Function to register the glyph table
+ *
+ * \details patterns is a table in flash of count glyphs, LCD_GLYPH_ROWS
+ *			bytes each, top row first with the dots in the low five bits.
+ *			A glyph's ID is its place in the table. Glyphs loaded from an
+ *			earlier table are forgotten, cells still showing them keep
+ *			their slots until they are overwritten. IDs from
+ *			LCD_GLYPH_BUILTIN on are the bar graph glyphs and do not
+ *			need a table.
+ *			
+ * \params[in] 	patterns, count
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_GLYPH_TABLE(const uint8_t *patterns, uint8_t count)
+{
+	uint8_t Slot;
+	
+	LCD_GlyphTable = patterns;
+	LCD_GlyphCount = count;
+	
+	for (Slot = 0; Slot < LCD_GLYPH_SLOTS; Slot++)
+	{
+		LCD_GlyphSlot[Slot] = LCD_GLYPH_NONE;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_GLYPH_CODE(uint8_t id, char *code)
+ *
+ * \brief Function to load a glyph into CGRAM and get its character code
+ *
+ * \details A glyph already in a slot is not sent again. Otherwise the
+ *			least recently used slot that no visible cell shows is loaded,
+ *			nine writes. The code is 8 to 15 so it can go in a string. It
+ *			stays valid while a cell shows it; a slot only used by codes
+ *			not yet written can be taken by the next eight other glyphs.
+ *			
+ * \params[in] 	id, code
+ *			
+ * \returns LCD_OK with the character in code, LCD_ERROR_NO_GLYPH if the
+ *			id is not in the table or every slot is shown, or
+ *			LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Accepts the built in bar glyphs
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_GLYPH_CODE(uint8_t id, char *code)
+{
+	LCD_STATS_ENTER(LCD_API_GLYPH);
+	
+	uint8_t Slot;
+	uint8_t i;
+	
+	if (!prvLCD_GLYPH_PATTERN(id))
+	{
+		return LCD_ERROR_NO_GLYPH;
+	}
+	
+	for (Slot = 0; Slot < LCD_GLYPH_SLOTS; Slot++)
+	{
+		if (LCD_GlyphSlot[Slot] == id) break;
+	}
+	
+	if (Slot < LCD_GLYPH_SLOTS)
+	{
+		LCD_GlyphStats.Hits++;
+	}
+	else
+	{
+		/*! Take the least recently used slot that is not on the display */
+		for (i = LCD_GLYPH_SLOTS; i > 0; i--)
+		{
+			Slot = LCD_GlyphLru[i - 1];
+			if (!prvLCD_GLYPH_VISIBLE(Slot)) break;
+		}
+		
+		if (i == 0)
+		{
+			LCD_GlyphStats.Refused++;
+			return LCD_ERROR_NO_GLYPH;
+		}
+		
+		if (prvLCD_GLYPH_LOAD(Slot, id) != LCD_OK)
+		{
+			return LCD_ERROR_TIMEOUT;
+		}
+		
+		LCD_GlyphStats.Loads++;
+	}
+	
+	prvLCD_GLYPH_USE(Slot);
+	
+	/*! Codes 8-15 show the same slots as 0-7 and are never a terminator */
+	*code = Slot | LCD_GLYPH_SLOTS;
+	
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_WRITE_GLYPH(uint8_t id)
+ *
+ * \brief Function to write a glyph at the cursor
+ *			
+ * \params[in] 	id
+ *			
+ * \returns LCD_OK, LCD_ERROR_NO_GLYPH or LCD_ERROR_TIMEOUT as for 
+ *			xLCD_GLYPH_CODE. Nothing is written unless LCD_OK.
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_WRITE_GLYPH(uint8_t id)
+{
+	char Code;
+	uint8_t Result = xLCD_GLYPH_CODE(id, &Code);
+	
+	if (Result != LCD_OK)
+	{
+		return Result;
+	}
+	
+	return xLCD_WRITE_CHAR(Code);
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_GLYPH_GET_STATS(LCD_GlyphStats_t *stats)
+ *
+ * \brief Function to copy the glyph cache counters
+ *			
+ * \params[in] 	stats, where to copy the counters
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_GLYPH_GET_STATS(LCD_GlyphStats_t *stats)
+{
+	*stats = LCD_GlyphStats;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_GLYPH_RESET_STATS(void)
+ *
+ * \brief Function to zero the glyph cache counters
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_GLYPH_RESET_STATS(void)
+{
+	LCD_GlyphStats.Hits = 0;
+	LCD_GlyphStats.Loads = 0;
+	LCD_GlyphStats.Refused = 0;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*****************************/
+/*Library Bar Graph Functions*/
+/*****************************/
+
+#if configUSE_BAR_GRAPH == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_BAR_LEVEL(uint16_t value, uint16_t full, uint8_t levels)
+ *
+ * \brief Function to scale value out of full to 0 to levels, rounded
+ *			
+ * \params[in] 	value, full, levels
+ *			
+ * \returns The level, levels when value is full or more
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_BAR_LEVEL(uint16_t value, uint16_t full, uint8_t levels)
+{
+	if (full == 0)
+	{
+		return 0;
+	}
+	
+	if (value >= full)
+	{
+		return levels;
+	}
+	
+	return ((uint32_t)value * levels + full / 2) / full;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_BAR_CELL(uint8_t x, uint8_t y, uint8_t level, uint8_t levels,
+ *			uint8_t glyph, uint8_t *next, uint8_t *shown)
+ *
+ * \brief Function to write one bar cell
+ *
+ * \details level 0 is a space and levels is the full block from the
+ *			character ROM, the levels between are the glyphs from glyph
+ *			on. When the cache has no slot for one the next lower level
+ *			that it has is written instead. The cursor is only moved when
+ *			x is not next, the cell after the last one written.
+ *			
+ * \params[in] 	x, y, level, levels, glyph, the ID of level 1
+ * \params[out]	next, x + 1, and shown, the level written
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_BAR_CELL(uint8_t x, uint8_t y, uint8_t level,
+	uint8_t levels, uint8_t glyph, uint8_t *next, uint8_t *shown)
+{
+	char Code = LCD_FULL_BLOCK;
+	
+	if (level < levels)
+	{
+		while ((level > 0) && (xLCD_GLYPH_CODE(glyph + level - 1, &Code) != LCD_OK))
+		{
+			level--;
+		}
+		
+		if (level == 0)
+		{
+			Code = ' ';
+		}
+	}
+	
+	*shown = level;
+	
+	if (x != *next)
+	{
+		vLCD_GO_TO_POSITION(x, y);
+	}
+	*next = x + 1;
+	
+	return xLCD_WRITE_CHAR(Code);
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_BAR_INIT(LCD_Bar_t *bar, uint8_t x, uint8_t y, uint8_t width)
+ *
+ * \brief Function to place a horizontal bar
+ *
+ * \details Nothing is written, the first xLCD_BAR_SET draws every cell.
+ *			The bar is cut at the end of the line.
+ *			
+ * \params[in] 	bar, x, y, the first cell, width, in cells
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_BAR_INIT(LCD_Bar_t *bar, uint8_t x, uint8_t y, uint8_t width)
+{
+	if (x >= LCD_LINE_LENGTH)
+	{
+		width = 0;
+	}
+	else if (width > LCD_LINE_LENGTH - x)
+	{
+		width = LCD_LINE_LENGTH - x;
+	}
+	
+	bar->X = x;
+	bar->Y = y;
+	bar->Width = width;
+	bar->Level = LCD_BAR_UNKNOWN;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_BAR_SET(LCD_Bar_t *bar, uint16_t value, uint16_t full)
+ *
+ * \brief Function to show value out of full on a horizontal bar
+ *
+ * \details The bar fills from the left, one dot column per step, so a 
+ *			24 cell bar has 120 steps. Only the cells between the old and
+ *			new ends that change are written, one set DDRAM address and 
+ *			the cells, of which at most one is a partial glyph. Glyph 
+ *			loads add nine writes. The cursor is left after the last cell
+ *			written.
+ *			
+ * \params[in] 	bar, value, full
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_BAR_SET(LCD_Bar_t *bar, uint16_t value, uint16_t full)
+{
+	LCD_STATS_ENTER(LCD_API_BAR);
+	
+	uint8_t Level = prvLCD_BAR_LEVEL(value, full, bar->Width * LCD_BAR_COLUMNS);
+	uint8_t Old = bar->Level;
+	uint8_t Next = LCD_ADDRESS_UNKNOWN;
+	uint8_t Result = LCD_OK;
+	uint8_t Cell = 0;
+	uint8_t Last = bar->Width - 1;
+	
+	if (Level == Old)
+	{
+		return LCD_OK;
+	}
+	
+	/*! Only the cells from the lower end to the higher end can change */
+	if (Old != LCD_BAR_UNKNOWN)
+	{
+		Cell = ((Old < Level) ? Old : Level) / LCD_BAR_COLUMNS;
+		if ((Old > Level ? Old : Level) / LCD_BAR_COLUMNS < Last)
+		{
+			Last = (Old > Level ? Old : Level) / LCD_BAR_COLUMNS;
+		}
+	}
+	
+	bar->Level = Level;
+	
+	for (; (Cell <= Last) && (Cell < bar->Width); Cell++)
+	{
+		uint8_t Start = Cell * LCD_BAR_COLUMNS;
+		uint8_t Want = (Level <= Start) ? 0 : (Level - Start > LCD_BAR_COLUMNS) ?
+			LCD_BAR_COLUMNS : Level - Start;
+		uint8_t Had = (Old == LCD_BAR_UNKNOWN) ? LCD_BAR_UNKNOWN : (Old <= Start) ?
+			0 : (Old - Start > LCD_BAR_COLUMNS) ? LCD_BAR_COLUMNS : Old - Start;
+		uint8_t Shown;
+		
+		if (Want == Had)
+		{
+			continue;
+		}
+		
+		Result = prvLCD_BAR_CELL(bar->X + Cell, bar->Y, Want, LCD_BAR_COLUMNS,
+			LCD_GLYPH_BAR(1), &Next, &Shown);
+		
+		/*! Only the end cell is partial, a level dropped there is the bar's */
+		if (Shown != Want)
+		{
+			bar->Level = Start + Shown;
+		}
+		
+		if (Result != LCD_OK)
+		{
+			bar->Level = LCD_BAR_UNKNOWN;
+			break;
+		}
+	}
+	
+	return Result;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_SPARK_INIT(LCD_Spark_t *spark, uint8_t x, uint8_t y, uint8_t width)
+ *
+ * \brief Function to place an empty sparkline
+ *
+ * \details Nothing is written, the first xLCD_SPARK_PUSH draws every cell.
+ *			The sparkline is cut at the end of the line.
+ *			
+ * \params[in] 	spark, x, y, the first cell, width, in cells
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_SPARK_INIT(LCD_Spark_t *spark, uint8_t x, uint8_t y, uint8_t width)
+{
+	uint8_t Cell;
+	
+	if (x >= LCD_LINE_LENGTH)
+	{
+		width = 0;
+	}
+	else if (width > LCD_LINE_LENGTH - x)
+	{
+		width = LCD_LINE_LENGTH - x;
+	}
+	
+	spark->X = x;
+	spark->Y = y;
+	spark->Width = width;
+	
+	for (Cell = 0; Cell < LCD_LINE_LENGTH; Cell++)
+	{
+		spark->Samples[Cell] = 0;
+		spark->Shown[Cell] = LCD_BAR_UNKNOWN;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_SPARK_PUSH(LCD_Spark_t *spark, uint16_t value, uint16_t full)
+ *
+ * \brief Function to scroll a sparkline left and add value out of full
+ *
+ * \details Each cell is a column of 0 to 8 lit rows. After the scroll a
+ *			cell is only written when its level differs from the one it
+ *			shows, so flat stretches cost nothing and each run of changed
+ *			cells costs one set DDRAM address. A whole line is 25 writes.
+ *			Levels 1 to 7 take seven CGRAM slots; when the cache cannot
+ *			give one a cell shows a lower level and is put right by a
+ *			later push once a slot is free. The cursor is left after the
+ *			last cell written.
+ *			
+ * \params[in] 	spark, value, full
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_SPARK_PUSH(LCD_Spark_t *spark, uint16_t value, uint16_t full)
+{
+	LCD_STATS_ENTER(LCD_API_BAR);
+	
+	uint8_t Next = LCD_ADDRESS_UNKNOWN;
+	uint8_t Result = LCD_OK;
+	uint8_t Cell;
+	
+	if (spark->Width == 0)
+	{
+		return LCD_OK;
+	}
+	
+	for (Cell = 1; Cell < spark->Width; Cell++)
+	{
+		spark->Samples[Cell - 1] = spark->Samples[Cell];
+	}
+	spark->Samples[spark->Width - 1] = prvLCD_BAR_LEVEL(value, full, LCD_SPARK_LEVELS);
+	
+	for (Cell = 0; Cell < spark->Width; Cell++)
+	{
+		if (spark->Samples[Cell] == spark->Shown[Cell])
+		{
+			continue;
+		}
+		
+		Result = prvLCD_BAR_CELL(spark->X + Cell, spark->Y, spark->Samples[Cell],
+			LCD_SPARK_LEVELS, LCD_GLYPH_SPARK(1), &Next, &spark->Shown[Cell]);
+		
+		if (Result != LCD_OK)
+		{
+			spark->Shown[Cell] = LCD_BAR_UNKNOWN;
+			break;
+		}
+	}
+	
+	return Result;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***************************/
+/*Library Marquee Functions*/
+/***************************/
+
+#if configUSE_MARQUEE == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_MARQUEE_DRAW(const char *text, uint16_t length, uint16_t index,
+ *			uint16_t period, uint8_t cell, uint8_t count)
+ *
+ * \brief Function to write count cells of the marquee line
+ *
+ * \details Writes text from index on into the DDRAM cells from cell on,
+ *			padded with spaces to period characters and starting over. 
+ *			The cells wrap from 39 to 0 of the same line. The address 
+ *			counter is put back afterwards, the cursor does not move. 
+ *			With the shadow buffer the cells written that are showing are
+ *			copied into their columns of it so a flush leaves them alone.
+ *			
+ * \params[in] 	text, length, index, the first character, period, cell,
+ *				the first DDRAM cell, count
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Copy into the shadow columns the cells show in
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_MARQUEE_DRAW(const char *text, uint16_t length,
+	uint16_t index, uint16_t period, uint8_t cell, uint8_t count)
+{
+	uint8_t Base = LCD_Marquee.Y ? LCD_LINE1_DDRAMADDR : LCD_LINE0_DDRAMADDR;
+	uint8_t Address = LCD_AddressCounter;
+	uint8_t Result = LCD_OK;
+	uint8_t First = 1;
+	
+	while ((count > 0) && (Result == LCD_OK))
+	{
+		char Character = (index < length) ? text[index] : ' ';
+		
+		/*! After cell 39 the address counter runs on to the other line */
+		if (First || (cell == 0))
+		{
+			Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_DDRAM) | (Base + cell));
+			First = 0;
+		}
+		
+		if (Result == LCD_OK)
+		{
+			Result = xWRITE_COMMAND_TO_LCD(DATA_WR, Character);
+		}
+		
+		#if configUSE_SHADOW_BUFFER == 1
+			{
+				uint8_t Column = (cell + LCD_DDRAM_LINE_LENGTH - LCD_DisplayShift) %
+					LCD_DDRAM_LINE_LENGTH;
+				
+				if (Column < LCD_LINE_LENGTH)
+				{
+					LCD_ShadowBuffer[LCD_Marquee.Y][Column] = Character;
+				}
+			}
+		#endif
+		
+		cell = (cell + 1) % LCD_DDRAM_LINE_LENGTH;
+		index = (index + 1) % period;
+		count--;
+	}
+	
+	if (Result != LCD_OK)
+	{
+		return Result;
+	}
+	
+	if (Address != LCD_ADDRESS_UNKNOWN)
+	{
+		return xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_DDRAM) | Address);
+	}
+	
+	vLCD_GO_TO_POSITION(CURSOR_X_POSITION, CURSOR_Y_POSITION);
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_MARQUEE_START(uint8_t y, const char *text)
+ *
+ * \brief Function to start scrolling text on a line
+ *
+ * \details Text of up to 40 characters is written once into all 40 DDRAM
+ *			cells of line y, padded with spaces, starting in the first 
+ *			column. Each xLCD_MARQUEE_STEP is then one display shift. The
+ *			shift moves the other line with it, so it should be blank or 
+ *			hold 40 cells meant to scroll along.
+ *
+ *			Longer text is scrolled by rewriting the 24 visible cells each
+ *			step, with LCD_MARQUEE_GAP spaces between its end and start. 
+ *			text is read again on every step and must stay valid until 
+ *			xLCD_MARQUEE_STOP.
+ *			
+ * \params[in] 	y, text
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_MARQUEE_START(uint8_t y, const char *text)
+{
+	LCD_STATS_ENTER(LCD_API_MARQUEE);
+	
+	uint16_t Length = 0;
+	
+	while (text[Length] && (Length < 0xFFFF - LCD_MARQUEE_GAP))
+	{
+		Length++;
+	}
+	
+	LCD_Marquee.Length = Length;
+	LCD_Marquee.Offset = 0;
+	LCD_Marquee.Y = y ? 1 : 0;
+	LCD_Marquee.Running = 1;
+	
+	if (Length <= LCD_DDRAM_LINE_LENGTH)
+	{
+		LCD_Marquee.Text = 0;
+		return prvLCD_MARQUEE_DRAW(text, Length, 0, LCD_DDRAM_LINE_LENGTH,
+			LCD_DisplayShift, LCD_DDRAM_LINE_LENGTH);
+	}
+	
+	LCD_Marquee.Text = text;
+	return prvLCD_MARQUEE_DRAW(text, Length, 0, Length + LCD_MARQUEE_GAP,
+		LCD_DisplayShift, LCD_LINE_LENGTH);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_MARQUEE_STEP(void)
+ *
+ * \brief Function to scroll the marquee one character left
+ *
+ * \details One shift display left instruction, 39us, or for text longer 
+ *			than DDRAM a set DDRAM address and 24 characters, plus one more
+ *			set DDRAM address to put the address counter back. Does 
+ *			nothing when no marquee is running. 
+ *
+ *			While the display is shifted the other functions write to the
+ *			columns showing, and the shadow buffer follows the shift.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Move the shadow buffer along with the shift
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_MARQUEE_STEP(void)
+{
+	LCD_STATS_ENTER(LCD_API_MARQUEE);
+	
+	uint16_t Period = LCD_Marquee.Length + LCD_MARQUEE_GAP;
+	uint8_t Result;
+	
+	if (!LCD_Marquee.Running)
+	{
+		return LCD_OK;
+	}
+	
+	if (!LCD_Marquee.Text)
+	{
+		Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_MOVE) | (1 << LCD_MOVE_DISP));
+		
+		#if configUSE_SHADOW_BUFFER == 1
+			prvLCD_SHADOW_SHIFTED((LCD_DisplayShift + LCD_DDRAM_LINE_LENGTH - 1) %
+				LCD_DDRAM_LINE_LENGTH);
+		#endif
+		
+		return Result;
+	}
+	
+	LCD_Marquee.Offset = (LCD_Marquee.Offset + 1) % Period;
+	
+	return prvLCD_MARQUEE_DRAW(LCD_Marquee.Text, LCD_Marquee.Length,
+		LCD_Marquee.Offset, Period, LCD_DisplayShift, LCD_LINE_LENGTH);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_MARQUEE_STOP(void)
+ *
+ * \brief Function to stop the marquee and undo the display shift
+ *
+ * \details Shifts the display back the shorter way round, at most 20 
+ *			shifts, which is quicker than return home. The marquee text 
+ *			stays in DDRAM until it is overwritten, and the shadow buffer
+ *			follows the shift back.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Move the shadow buffer back with the shift
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_MARQUEE_STOP(void)
+{
+	LCD_STATS_ENTER(LCD_API_MARQUEE);
+	
+	uint8_t Result = LCD_OK;
+	uint8_t Shift = (1 << LCD_MOVE) | (1 << LCD_MOVE_DISP) | (1 << LCD_MOVE_RIGHT);
+	#if configUSE_SHADOW_BUFFER == 1
+		uint8_t From = LCD_DisplayShift;
+	#endif
+	
+	LCD_Marquee.Running = 0;
+	
+	if (LCD_DisplayShift > LCD_DDRAM_LINE_LENGTH / 2)
+	{
+		Shift = (1 << LCD_MOVE) | (1 << LCD_MOVE_DISP);
+	}
+	
+	while ((LCD_DisplayShift != 0) && (Result == LCD_OK))
+	{
+		Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, Shift);
+	}
+	
+	#if configUSE_SHADOW_BUFFER == 1
+		prvLCD_SHADOW_SHIFTED(From);
+	#endif
+	
+	return Result;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*****************************/
+/*Library Page Flip Functions*/
+/*****************************/
+
+#if configUSE_PAGE_FLIP == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_PAGE_WRITE(uint8_t y, uint8_t cell, const char *text, uint8_t count)
+ *
+ * \brief Function to write count characters into line y from a DDRAM cell
+ *
+ * \details The cells wrap from 39 to 0 of the same line, with a second
+ *			set DDRAM address. The address counter is left after the last.
+ *			
+ * \params[in] 	y, cell, text, count
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_PAGE_WRITE(uint8_t y, uint8_t cell, const char *text, uint8_t count)
+{
+	uint8_t Base = y ? LCD_LINE1_DDRAMADDR : LCD_LINE0_DDRAMADDR;
+	uint8_t Result = LCD_OK;
+	uint8_t First = 1;
+	
+	while ((count > 0) && (Result == LCD_OK))
+	{
+		if (First || (cell == 0))
+		{
+			Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_DDRAM) | (Base + cell));
+			First = 0;
+		}
+		
+		if (Result == LCD_OK)
+		{
+			Result = xWRITE_COMMAND_TO_LCD(DATA_WR, *text++);
+		}
+		
+		cell = (cell + 1) % LCD_DDRAM_LINE_LENGTH;
+		count--;
+	}
+	
+	return Result;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_PAGE_PREPARE(const char *top, const char *bottom)
+ *
+ * \brief Function to write the next page off screen
+ *
+ * \details Each line of DDRAM has 40 cells and 24 are on screen, so the
+ *			next page goes 16 cells to the right of the one showing. Its
+ *			last 16 columns land in the 16 cells off screen and are 
+ *			written now, 2 set DDRAM addresses and 32 characters, without
+ *			anything visible changing. Its first 8 columns would land on
+ *			cells still showing and are kept until xLCD_PAGE_FLIP. Lines
+ *			shorter than 24 characters are padded with spaces. The address
+ *			counter is put back and the cursor does not move.
+ *
+ *			Once pages are flipped the display is shifted. The other write
+ *			functions and the shadow buffer take the columns showing, but
+ *			text written to a page that is showing is gone after the next
+ *			flip, and the marquee shifts both lines so it should not run
+ *			until xLCD_PAGE_END.
+ *			
+ * \params[in] 	top, bottom
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - The other write functions take the columns showing
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_PAGE_PREPARE(const char *top, const char *bottom)
+{
+	LCD_STATS_ENTER(LCD_API_PAGE_PREPARE);
+	
+	uint8_t Cell = (LCD_DisplayShift + LCD_PAGE_SHIFT + LCD_PAGE_OVERLAP) % LCD_DDRAM_LINE_LENGTH;
+	uint8_t Address = LCD_AddressCounter;
+	uint8_t Result = LCD_OK;
+	char Line[LCD_LINE_LENGTH];
+	uint8_t y;
+	uint8_t i;
+	
+	for (y = 0; (y < LCD_LINES) && (Result == LCD_OK); y++)
+	{
+		const char *Text = y ? bottom : top;
+		
+		for (i = 0; i < LCD_LINE_LENGTH; i++)
+		{
+			Line[i] = *Text ? *Text++ : ' ';
+		}
+		
+		for (i = 0; i < LCD_PAGE_OVERLAP; i++)
+		{
+			LCD_PageOverlap[y][i] = Line[i];
+		}
+		
+		Result = prvLCD_PAGE_WRITE(y, Cell, &Line[LCD_PAGE_OVERLAP], LCD_PAGE_SHIFT);
+	}
+	
+	if (Result != LCD_OK)
+	{
+		return Result;
+	}
+	
+	LCD_PageReady = 1;
+	
+	if (Address != LCD_ADDRESS_UNKNOWN)
+	{
+		return xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_DDRAM) | Address);
+	}
+	
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_PAGE_FLIP(void)
+ *
+ * \brief Function to bring the prepared page into view
+ *
+ * \details While the display is switched off the first 8 columns of each
+ *			line are written, then 16 shift display left instructions move
+ *			the page into view and the display is switched back on. The
+ *			screen is blank for about 1.7ms with the busy flag, far less
+ *			than the liquid crystal takes to respond, and never shows half
+ *			old and half new lines. Its cost is counted as 
+ *			LCD_API_PAGE_FLIP when instrumentation is enabled. The last 
+ *			display control sent is put back, so the cursor and blink stay
+ *			as they were and a display switched off stays off. With the
+ *			shadow buffer the new page is copied into it. Does nothing 
+ *			unless a page was prepared.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Put back the display control in use, copy the page into the shadow
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_PAGE_FLIP(void)
+{
+	LCD_STATS_ENTER(LCD_API_PAGE_FLIP);
+	
+	uint8_t Cell = (LCD_DisplayShift + LCD_PAGE_SHIFT) % LCD_DDRAM_LINE_LENGTH;
+	uint8_t Address = LCD_AddressCounter;
+	uint8_t Control = LCD_DisplayControl;
+	uint8_t Blank = Control & (1 << LCD_ON_DISPLAY);
+	uint8_t Result = LCD_OK;
+	uint8_t i;
+	
+	if (!LCD_PageReady)
+	{
+		return LCD_OK;
+	}
+	
+	if (Blank)
+	{
+		Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_ON_CTRL));
+	}
+	
+	for (i = 0; (i < LCD_LINES) && (Result == LCD_OK); i++)
+	{
+		Result = prvLCD_PAGE_WRITE(i, Cell, LCD_PageOverlap[i], LCD_PAGE_OVERLAP);
+	}
+	
+	for (i = 0; (i < LCD_PAGE_SHIFT) && (Result == LCD_OK); i++)
+	{
+		Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_MOVE) | (1 << LCD_MOVE_DISP));
+	}
+	
+	if ((Result == LCD_OK) && (Address != LCD_ADDRESS_UNKNOWN))
+	{
+		Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_DDRAM) | Address);
+	}
+	
+	if (Blank && (Result == LCD_OK))
+	{
+		Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, Control);
+	}
+	
+	#if configUSE_SHADOW_BUFFER == 1
+		prvLCD_SHADOW_SHIFTED(LCD_ADDRESS_UNKNOWN);
+	#endif
+	
+	LCD_PageReady = 0;
+	
+	return Result;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_PAGE_END(void)
+ *
+ * \brief Function to clear the display and undo the page shift
+ *
+ * \details Sends clear display, which also undoes the display shift. The
+ *			cursor goes to the top left and the shadow buffer is blanked to
+ *			match. Its cost is counted as LCD_API_PAGE_END.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Block the calling task while the clear runs when it can
+ * 10/18/2026 - Counted as LCD_API_PAGE_END
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_PAGE_END(void)
+{
+	LCD_STATS_ENTER(LCD_API_PAGE_END);
+	
+	uint8_t Result = xWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_CLEAR_INSTRUCTION);
+	
+	LCD_EXECUTION_WAIT_US(LCD_CLEAR_TIME_US);
+	
+	#if configUSE_SHADOW_BUFFER == 1
+		prvLCD_SHADOW_FILL(0, LCD_LINES * LCD_LINE_LENGTH, ' ');
+	#endif
+	
+	CURSOR_X_POSITION = 0;
+	CURSOR_Y_POSITION = 0;
+	LCD_PageReady = 0;
+	
+	return Result;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**********************************/
+/*Library Display Handle Functions*/
+/**********************************/
+
+#if configUSE_MULTI_DISPLAY == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_MULTI_ENQUEUE(char RS, char data)
+ *
+ * \brief Function to queue one write for the selected display
+ *
+ * \details When the queue is full the scheduler sends bytes to every 
+ *			display until this one has room.
+ *			
+ * \params[in] 	RS, data
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the display stopped responding
+ *			since the last flush
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_MULTI_ENQUEUE(char RS, char data)
+{
+	uint8_t Next = (LCD_Active->Head + 1) & (configLCD_MULTI_QUEUE_LENGTH - 1);
+	
+	while ((Next == LCD_Active->Tail) && !LCD_Active->Timeout)
+	{
+		(void)prvLCD_MULTI_SERVICE();
+	}
+	
+	if (LCD_Active->Timeout)
+	{
+		return LCD_ERROR_TIMEOUT;
+	}
+	
+	LCD_Active->Queue[LCD_Active->Head].RS = RS;
+	LCD_Active->Queue[LCD_Active->Head].Data = data;
+	LCD_Active->Head = Next;
+	
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_MULTI_SERVICE(void)
+ *
+ * \brief Function to give every display with queued writes one turn
+ *
+ * \details Reads the busy flag of each display that has bytes waiting 
+ *			and sends it one byte if it is ready. A display that is still
+ *			busy is passed over until the next turn, and its queue dropped
+ *			after configBUSY_TIMEOUT_POLLS reads. When no display was ready
+ *			waits 1us, so reads of the same display keep the E cycle time.
+ *			
+ * \params[in] 	none
+ *			
+ * \returns Number of displays that still have writes queued
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_MULTI_SERVICE(void)
+{
+	LCD_Display_t *Selected = LCD_Active;
+	LCD_Display_t *Display;
+	uint8_t Waiting = 0;
+	uint8_t Sent = 0;
+	
+	for (Display = LCD_DisplayList; Display != 0; Display = Display->Next)
+	{
+		if (Display->Head == Display->Tail) continue;
+		
+		/*! The bus functions strobe the E pin of LCD_Active */
+		LCD_Active = Display;
+		
+		if (prvLCD_READ_STATUS() & (1 << LCD_BUSY))
+		{
+			LCD_STATS_ADD(BusyPolls, 1);
+			
+			if (++Display->Polls >= configBUSY_TIMEOUT_POLLS)
+			{
+				/*! Give up on this display, the others carry on */
+				Display->Tail = Display->Head;
+				Display->Polls = 0;
+				Display->Timeout = 1;
+			}
+			else
+			{
+				Waiting++;
+			}
+			continue;
+		}
+		
+		prvLCD_BUS_WRITE(Display->Queue[Display->Tail].RS, 
+			Display->Queue[Display->Tail].Data);
+		Display->Tail = (Display->Tail + 1) & (configLCD_MULTI_QUEUE_LENGTH - 1);
+		Display->Polls = 0;
+		Sent = 1;
+		
+		if (Display->Head != Display->Tail) Waiting++;
+	}
+	
+	LCD_Active = Selected;
+	
+	if (Waiting && !Sent)
+	{
+		/*! E cycle time must be more than 500ns*/
+		LCD_DELAY_US(1);
+	}
+	
+	return Waiting;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_BROADCAST_WRITE(char RS, char data)
+ *
+ * \brief Function to strobe one write into every broadcast target at once
+ *
+ * \details Writes already queued for the targets are sent first, so the
+ *			broadcast lands after them and writes queued later land after
+ *			it. The busy flag of each target is then read in turn, since 
+ *			two displays cannot drive the data pins together, and the byte
+ *			is strobed into all that are ready in one bus cycle. The cursor
+ *			and tracked state of each of them are updated.
+ *			
+ * \params[in] 	RS, data
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if a target stayed busy. The 
+ *			targets that were ready still take the write.
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_BROADCAST_WRITE(char RS, char data)
+{
+	LCD_Display_t *Selected = LCD_Active;
+	LCD_Display_t *Display;
+	uint8_t Strobe = LCD_BroadcastStrobe;
+	uint8_t Ready = 0;
+	uint8_t Waiting;
+	
+	do
+	{
+		Waiting = 0;
+		for (Display = LCD_DisplayList; Display != 0; Display = Display->Next)
+		{
+			if ((LCD_TARGET(Display) & LCD_Broadcast) && (Display->Head != Display->Tail))
+				Waiting = 1;
+		}
+		if (Waiting) (void)prvLCD_MULTI_SERVICE();
+	} while (Waiting);
+	
+	/*! Busy flags are read one display at a time */
+	LCD_BroadcastStrobe = 0;
+	for (Display = LCD_DisplayList; Display != 0; Display = Display->Next)
+	{
+		if (!(LCD_TARGET(Display) & LCD_Broadcast)) continue;
+		
+		LCD_Active = Display;
+		if (xLCD_WAIT_WHILE_BUSY() == LCD_OK) Ready |= LCD_TARGET(Display);
+	}
+	
+	if (Ready)
+	{
+		LCD_BroadcastStrobe = Ready;
+		prvLCD_BUS_WRITE(RS, data);
+	}
+	LCD_BroadcastStrobe = Strobe;
+	
+	/*! Follow every display that took the write */
+	for (Display = LCD_DisplayList; Display != 0; Display = Display->Next)
+	{
+		if (!(LCD_TARGET(Display) & Ready)) continue;
+		
+		LCD_Active = Display;
+		if (RS == DATA_WR)
+		{
+			CURSOR_X_POSITION++;
+			LCD_STATS_ADD(Bytes, 1);
+		}
+		else
+		{
+			LCD_STATS_ADD(Commands, 1);
+		}
+		prvLCD_TRACK_WRITE(RS, data);
+	}
+	
+	LCD_Active = Selected;
+	
+	return (Ready == LCD_Broadcast) ? LCD_OK : LCD_ERROR_TIMEOUT;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_DISPLAY_INIT(LCD_Display_t *display, uint8_t enable)
+ *
+ * \brief Function to set up a display handle for the display with E on pin enable
+ *
+ * \details Holds the E pin low as an output, so the display ignores the
+ *			bus until it is written, and adds the handle to the displays
+ *			the scheduler visits, in the order they are set up. Until then
+ *			the functions work on LCD_PrimaryDisplay, the display on LCD_E,
+ *			which is not in the list. The first display set up is also 
+ *			selected. Call it for every display 
+ *			before any of them is used, then vLCD_SELECT and 
+ *			vLCD_INITIALIZATION for each. Setting up a handle again only
+ *			resets it.
+ *			
+ * \params[in] 	display - handle kept by the application for as long as it
+ *				runs, enable - LCP pin wired to E of the display
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Add the E pin to LCD_TARGET_ALL
+ * 10/18/2026 - Select the first display set up in place of LCD_PrimaryDisplay
+ *
+ ******************************************************************************
+ */
+void vLCD_DISPLAY_INIT(LCD_Display_t *display, uint8_t enable)
+{
+	LCD_Display_t **Link = &LCD_DisplayList;
+	
+	display->Enable = enable;
+	display->CursorX = 0;
+	display->CursorY = 0;
+	display->LengthTop = 0;
+	display->LengthBottom = 0;
+	display->OnOff = 0;
+	display->AddressCounter = LCD_ADDRESS_UNKNOWN;
+	display->EntryMode = (1 << LCD_ENTRY_MODE) | (INCREMENT_MODE << LCD_ENTRY_INC);
+	display->DisplayShift = 0;
+	display->DisplayControl = (1 << LCD_ON_CTRL) | (1 << LCD_ON_DISPLAY) |
+		(configCURSOR_SHOW << LCD_ON_CURSOR) | (configCURSOR_BLINK << LCD_ON_BLINK);
+	display->Head = 0;
+	display->Tail = 0;
+	display->Polls = 0;
+	display->Timeout = 0;
+	
+	/*! E low before the pin is driven, a floating E would take any write */
+	LCP = LCP & (uint8_t)~(1 << enable);
+	LCDR = LCDR | (1 << enable);
+	
+	LCD_DisplayMask = LCD_DisplayMask | (1 << enable);
+	
+	/*! Add it after the displays already set up, unless it is one of them */
+	while ((*Link != 0) && (*Link != display)) Link = &(*Link)->Next;
+	if (*Link == 0)
+	{
+		display->Next = 0;
+		*Link = display;
+	}
+	
+	if (LCD_Active == &LCD_PrimaryDisplay) LCD_Active = display;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_SELECT(LCD_Display_t *display)
+ *
+ * \brief Function to pick the display the other functions work on
+ *
+ * \details Every other function of the library writes to and tracks the
+ *			selected display only. Between vLCD_MULTI_BEGIN and 
+ *			xLCD_MULTI_FLUSH selecting another display only changes the
+ *			queue the writes go to.
+ *			
+ * \params[in] 	display - handle set up with vLCD_DISPLAY_INIT
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_SELECT(LCD_Display_t *display)
+{
+	LCD_Active = display;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_MULTI_BEGIN(void)
+ *
+ * \brief Function to queue writes per display until xLCD_MULTI_FLUSH
+ *
+ * \details The library functions return once their bytes are queued for
+ *			the selected display. When a queue is full the scheduler runs
+ *			until it has room. Writes to LCD_PrimaryDisplay, before any
+ *			display is set up, are not queued but sent at once.
+ *			vLCD_INITIALIZATION and xLCD_WAIT_WHILE_BUSY
+ *			need the bus to themselves, do not call them until the flush.
+ *			
+ * \params[in] 	none
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_MULTI_BEGIN(void)
+{
+	LCD_MultiQueued = 1;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_MULTI_FLUSH(void)
+ *
+ * \brief Function to send every queued write, interleaved across the displays
+ *
+ * \details Visits the displays in turn and sends each the next byte of
+ *			its queue once its busy flag clears, so while one display is
+ *			executing a write the bus carries bytes for the others. With N
+ *			displays written at once the bytes reach them close to N times
+ *			as fast as one display takes them. Writes go straight to the
+ *			selected display again afterwards.
+ *			
+ * \params[in] 	none
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if a display stayed busy for 
+ *			configBUSY_TIMEOUT_POLLS reads; the rest of its queue was 
+ *			dropped and writes to it refused until this returned. The other
+ *			displays are not held up.
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_MULTI_FLUSH(void)
+{
+	LCD_STATS_ENTER(LCD_API_MULTI_FLUSH);
+	
+	LCD_Display_t *Display;
+	uint8_t Result = LCD_OK;
+	
+	while (prvLCD_MULTI_SERVICE() != 0)
+	{
+	}
+	
+	LCD_MultiQueued = 0;
+	
+	for (Display = LCD_DisplayList; Display != 0; Display = Display->Next)
+	{
+		if (Display->Timeout)
+		{
+			Display->Timeout = 0;
+			Result = LCD_ERROR_TIMEOUT;
+		}
+	}
+	
+	return Result;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_BROADCAST_COMMAND(uint8_t targets, char RS, char data)
+ *
+ * \brief Function to write one instruction or data byte to several displays at once
+ *
+ * \details Like xWRITE_COMMAND_TO_LCD, but the byte is strobed into every
+ *			display in targets in one bus cycle. Writes queued for them
+ *			before are sent first. Use it for content they all show, for
+ *			example a set DDRAM address and the characters of a banner.
+ *			
+ * \params[in] 	targets - LCD_TARGET of each display combined with |, or
+ *				LCD_TARGET_ALL, RS, data
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if a target stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_BROADCAST_COMMAND(uint8_t targets, char RS, char data)
+{
+	uint8_t Result;
+	
+	/*! E pins that are not a display set up are never strobed */
+	LCD_Broadcast = targets & LCD_DisplayMask;
+	if (!LCD_Broadcast) return LCD_OK;
+	
+	Result = xWRITE_COMMAND_TO_LCD(RS, data);
+	
+	LCD_Broadcast = 0;
+	
+	return Result;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_BROADCAST_CLEAR(uint8_t targets)
+ *
+ * \brief Function to clear several displays at once
+ *
+ * \details vLCD_CLEAR with the clear instruction strobed into every 
+ *			display in targets together.
+ *			
+ * \params[in] 	targets - LCD_TARGET of each display combined with |, or
+ *				LCD_TARGET_ALL
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_BROADCAST_CLEAR(uint8_t targets)
+{
+	LCD_Broadcast = targets & LCD_DisplayMask;
+	if (!LCD_Broadcast) return;
+	
+	vLCD_CLEAR();
+	
+	LCD_Broadcast = 0;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_BROADCAST_INITIALIZATION(uint8_t targets)
+ *
+ * \brief Function to initialize several displays at once
+ *
+ * \details vLCD_INITIALIZATION with every step strobed into the displays
+ *			in targets together, so the power up wait and the instruction
+ *			delays are spent once however many displays there are. Each
+ *			display's busy flag is still read on its own.
+ *			
+ * \params[in] 	targets - LCD_TARGET of each display combined with |, or
+ *				LCD_TARGET_ALL
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_BROADCAST_INITIALIZATION(uint8_t targets)
+{
+	LCD_Display_t *Selected = LCD_Active;
+	LCD_Display_t *Display;
+	
+	LCD_Broadcast = targets & LCD_DisplayMask;
+	if (!LCD_Broadcast) return;
+	
+	/*! The initialization resets the cursor of LCD_Active, keep it on a target */
+	for (Display = LCD_DisplayList; !(LCD_TARGET(Display) & LCD_Broadcast); 
+		Display = Display->Next)
+	{
+	}
+	LCD_Active = Display;
+	
+	/*! The port directions and 4-bit nibbles go to every target too */
+	LCD_BroadcastStrobe = LCD_Broadcast;
+	vLCD_INITIALIZATION();
+	LCD_BroadcastStrobe = 0;
+	
+	for (Display = LCD_DisplayList; Display != 0; Display = Display->Next)
+	{
+		if (!(LCD_TARGET(Display) & LCD_Broadcast)) continue;
+		
+		Display->CursorX = 0;
+		Display->CursorY = 0;
+	}
+	
+	LCD_Active = Selected;
+	LCD_Broadcast = 0;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/****************************/
+/*Library Peephole Functions*/
+/****************************/
+
+#if configUSE_PEEPHOLE == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_PEEPHOLE_WRITE(char RS, char data)
+ *
+ * \brief Function to drop or hold back instructions that change nothing
+ *
+ * \details Compares each instruction with the controller state:
+ *
+ *			A set DDRAM address equal to LCD_AddressCounter is dropped.
+ *			While the last display control has the cursor and blink off
+ *				any other set DDRAM address is held in LCD_PeepholePending,
+ *				and a later one replaces it. Nothing shows where the
+ *				address counter points until a character is written.
+ *			A display control or entry mode equal to the last one sent is
+ *				dropped.
+ *			Set CGRAM address, clear and return home overwrite the address
+ *				counter, so a held back set DDRAM address in front of them
+ *				is dropped. Anything else sends it first.
+ *
+ *			The caller still tracks the write with prvLCD_TRACK_WRITE, so
+ *			LCD_AddressCounter always holds the address the controller will
+ *			have once the held back instruction is sent.
+ *
+ * \params[in] 	RS, data
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_PEEPHOLE_WRITE(char RS, char data)
+{
+	uint8_t Instruction = (uint8_t)data;
+	
+	if (RS == INSTR_WR)
+	{
+		LCD_PeepholeStats.Instructions++;
+		
+		if (Instruction & (1 << LCD_DDRAM))
+		{
+			if ((Instruction & 0x7F) == LCD_AddressCounter)
+			{
+				LCD_PeepholeStats.Elided++;
+				return LCD_OK;
+			}
+			
+			/*! Hold the move back while no cursor shows where it points */
+			if ((LCD_PeepholeDisplay != LCD_ADDRESS_UNKNOWN) &&
+				!(LCD_PeepholeDisplay & ((1 << LCD_ON_CURSOR) | (1 << LCD_ON_BLINK))))
+			{
+				if (LCD_PeepholePending != LCD_ADDRESS_UNKNOWN)
+				{
+					LCD_PeepholeStats.Merged++;
+				}
+				LCD_PeepholePending = Instruction;
+				return LCD_OK;
+			}
+		}
+		else if ((Instruction & 0xF8) == (1 << LCD_ON_CTRL))
+		{
+			if (Instruction == LCD_PeepholeDisplay)
+			{
+				LCD_PeepholeStats.Elided++;
+				return LCD_OK;
+			}
+		}
+		else if ((Instruction & 0xFC) == (1 << LCD_ENTRY_MODE))
+		{
+			if (Instruction == LCD_PeepholeEntry)
+			{
+				LCD_PeepholeStats.Elided++;
+				return LCD_OK;
+			}
+		}
+		else if (((Instruction & 0xC0) == (1 << LCD_CGRAM)) ||
+			(Instruction <= ((1 << LCD_HOME_TOP_LINE) | 1)))
+		{
+			/*! The held back address would be overwritten before it is used */
+			if (LCD_PeepholePending != LCD_ADDRESS_UNKNOWN)
+			{
+				LCD_PeepholePending = LCD_ADDRESS_UNKNOWN;
+				LCD_PeepholeStats.Merged++;
+			}
+		}
+	}
+	
+	if (xLCD_PEEPHOLE_FLUSH() != LCD_OK)
+	{
+		return LCD_ERROR_TIMEOUT;
+	}
+	
+	if (prvLCD_SEND(RS, data) != LCD_OK)
+	{
+		return LCD_ERROR_TIMEOUT;
+	}
+	
+	/*! Remember what the controller now holds */
+	if (RS == INSTR_WR)
+	{
+		if ((Instruction & 0xF8) == (1 << LCD_ON_CTRL))
+		{
+			LCD_PeepholeDisplay = Instruction;
+		}
+		else if ((Instruction & 0xFC) == (1 << LCD_ENTRY_MODE))
+		{
+			LCD_PeepholeEntry = Instruction;
+		}
+		else if ((Instruction == (1 << LCD_CLR)) &&
+			(LCD_PeepholeEntry != LCD_ADDRESS_UNKNOWN))
+		{
+			/*! Clear also sets increment mode */
+			LCD_PeepholeEntry = LCD_PeepholeEntry | (1 << LCD_ENTRY_INC);
+		}
+	}
+	
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_PEEPHOLE_FLUSH(void)
+ *
+ * \brief Function to send a held back set DDRAM address
+ *
+ * \details The next write sends it anyway. Call this before reading the
+ *			address counter back or handing the bus to other code.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Counted by the instrumentation
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_PEEPHOLE_FLUSH(void)
+{
+	LCD_STATS_ENTER(LCD_API_PEEPHOLE_FLUSH);
+	
+	if (LCD_PeepholePending == LCD_ADDRESS_UNKNOWN)
+	{
+		return LCD_OK;
+	}
+	
+	if (prvLCD_SEND(INSTR_WR, LCD_PeepholePending) != LCD_OK)
+	{
+		return LCD_ERROR_TIMEOUT;
+	}
+	
+	LCD_PeepholePending = LCD_ADDRESS_UNKNOWN;
+	
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_PEEPHOLE_GET_STATS(LCD_PeepholeStats_t *)
+ *
+ * \brief Function to copy the peephole counters
+ *
+ * \details Elided plus Merged against Instructions is the share of the
+ *			instruction stream that never reached the bus.
+ *			
+ * \params[in] 	Where to copy the counters
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_PEEPHOLE_GET_STATS(LCD_PeepholeStats_t *stats)
+{
+	*stats = LCD_PeepholeStats;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_PEEPHOLE_RESET_STATS(void)
+ *
+ * \brief Function to zero the peephole counters
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_PEEPHOLE_RESET_STATS(void)
+{
+	LCD_PeepholeStats.Instructions = 0;
+	LCD_PeepholeStats.Elided = 0;
+	LCD_PeepholeStats.Merged = 0;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library Yield Functions*/
+/*************************/
+
+#if configUSE_YIELD_WAIT == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_YIELD(uint16_t us)
+ *
+ * \brief Function to block the calling task for a long wait
+ *
+ * \details Used through LCD_WAIT_US and LCD_EXECUTION_WAIT_US. The task
+ *			is delayed one tick more than the wait needs, since the first
+ *			tick may come straight after the call. Before the scheduler
+ *			starts, while it is suspended and with interrupts off nothing
+ *			else can run, so the caller spins instead. Other tasks run
+ *			while the caller is part way through a library call, so they
+ *			must not call the library themselves; see configUSE_YIELD_WAIT.
+ *			
+ * \params[in] 	us, microseconds to wait
+ *			
+ * \returns 1 when the task was blocked, 0 when the caller has to spin
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - State that no other task may call the library meanwhile
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_YIELD(uint16_t us)
+{
+	if ((xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) || !(SREG & (1 << SREG_I)))
+	{
+		return 0;
+	}
+	
+	#if configUSE_LCD_STATS == 1
+		uint16_t Start = prvLCD_TIMER5_NOW();
+	#endif
+	
+	vTaskDelay((TickType_t)((us + LCD_YIELD_TICK_US - 1) / LCD_YIELD_TICK_US + 1));
+	
+	#if configUSE_LCD_STATS == 1
+		/*! Other tasks had the CPU, keep it out of the call's cycles */
+		LCD_Stats.BlockedCycles += (uint32_t)(uint16_t)(prvLCD_TIMER5_NOW() - Start) *
+			LCD_TIMER5_PRESCALE;
+	#endif
+	
+	return 1;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***********************************/
+/*Library Instrumentation Functions*/
+/***********************************/
+
+#if configUSE_LCD_STATS == 1 || configUSE_LCD_TRACE == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_TIMER5_NOW(void)
+ *
+ * \brief Function to read Timer 5
+ *
+ * \details Starts Timer 5 in normal mode at F_CPU/64 the first time. The
+ *			read is made with interrupts off, the 16-bit timers share one
+ *			temporary register and the transmit interrupt writes Timer 3.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns Timer 5 count, one count is LCD_TIMER5_PRESCALE cycles
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Shared with the bus trace
+ *
+ ******************************************************************************
+ */
+static uint16_t prvLCD_TIMER5_NOW(void)
+{
+	uint8_t SavedSREG = SREG;
+	uint16_t Count;
+	
+	cli();
+	
+	if (!(TCCR5B & ((1 << CS52) | (1 << CS51) | (1 << CS50))))
+	{
+		TCCR5A = 0x00;
+		/*! Normal mode, F_CPU/64 */
+		TCCR5B = (1 << CS51) | (1 << CS50);
+	}
+	
+	Count = TCNT5;
+	
+	SREG = SavedSREG;
+	
+	return Count;
+}
+
+#endif
+
+#if configUSE_LCD_STATS == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_STATS_ENTER(uint8_t api)
+ *
+ * \brief Function to count a call and note when it started
+ *
+ * \details Used through LCD_STATS_ENTER, which hands the frame to 
+ *			prvLCD_STATS_EXIT when the function returns.
+ *			
+ * \params[in] 	api, one of the LCD_API_ numbers
+ *			
+ * \returns The frame for prvLCD_STATS_EXIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Note the blocked cycles so far
+ *
+ ******************************************************************************
+ */
+static LCD_StatsFrame_t prvLCD_STATS_ENTER(uint8_t api)
+{
+	LCD_StatsFrame_t Frame;
+	
+	LCD_Stats.Calls[api]++;
+	LCD_StatsDepth++;
+	
+	Frame.Api = api;
+	Frame.Blocked = LCD_Stats.BlockedCycles;
+	Frame.Start = prvLCD_TIMER5_NOW();
+	
+	return Frame;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_STATS_EXIT(LCD_StatsFrame_t *frame)
+ *
+ * \brief Function to add the time of a call that is returning
+ *
+ * \details Cycles are counted for every function the call went through,
+ *			TotalCycles only for the outermost one so nested calls are not
+ *			added twice. A call longer than 65535 Timer 5 counts, 262ms at
+ *			16MHz, wraps and is under counted. Time the calling task spent
+ *			blocked in prvLCD_YIELD is taken off, the CPU ran other tasks.
+ *			
+ * \params[in] 	frame, from prvLCD_STATS_ENTER
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Leave out the cycles the caller was blocked
+ *
+ ******************************************************************************
+ */
+static void prvLCD_STATS_EXIT(LCD_StatsFrame_t *frame)
+{
+	uint32_t Cycles = (uint32_t)(uint16_t)(prvLCD_TIMER5_NOW() - frame->Start) * 
+		LCD_TIMER5_PRESCALE;
+	uint32_t Blocked = LCD_Stats.BlockedCycles - frame->Blocked;
+	
+	Cycles = (Cycles > Blocked) ? Cycles - Blocked : 0;
+	
+	LCD_Stats.Cycles[frame->Api] += Cycles;
+	
+	if (--LCD_StatsDepth == 0)
+	{
+		LCD_Stats.TotalCycles += Cycles;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_GET_STATS(LCD_Stats_t *stats)
+ *
+ * \brief Function to copy the instrumentation counters
+ *
+ * \details The copy is made with interrupts off so a task switch cannot
+ *			split it.
+ *			
+ * \params[in] 	stats, where to copy the counters
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_GET_STATS(LCD_Stats_t *stats)
+{
+	uint8_t SavedSREG = SREG;
+	
+	cli();
+	*stats = LCD_Stats;
+	SREG = SavedSREG;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_RESET_STATS(void)
+ *
+ * \brief Function to zero the instrumentation counters
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Zero the blocked cycles
+ *
+ ******************************************************************************
+ */
+void vLCD_RESET_STATS(void)
+{
+	uint8_t SavedSREG = SREG;
+	uint8_t i;
+	
+	cli();
+	
+	for (i = 0; i < LCD_API_COUNT; i++)
+	{
+		LCD_Stats.Calls[i] = 0;
+		LCD_Stats.Cycles[i] = 0;
+	}
+	LCD_Stats.TotalCycles = 0;
+	LCD_Stats.Bytes = 0;
+	LCD_Stats.Commands = 0;
+	LCD_Stats.DelayUs = 0;
+	LCD_Stats.BusyPolls = 0;
+	LCD_Stats.BlockedCycles = 0;
+	
+	SREG = SavedSREG;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library Trace Functions*/
+/*************************/
+
+#if configUSE_LCD_TRACE == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_TRACE_NOW(void)
+ *
+ * \brief Function to read the trace time
+ *
+ * \details Timer 5 gives the low 16 bits and LCD_TraceWraps, counted by
+ *			its compare interrupt at 0, the high 16 bits. A wrap that has
+ *			not reached the interrupt yet is counted here instead.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns Time in Timer 5 ticks
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint32_t prvLCD_TRACE_NOW(void)
+{
+	uint8_t SavedSREG = SREG;
+	uint16_t Count;
+	uint32_t Time;
+	
+	cli();
+	
+	Count = prvLCD_TIMER5_NOW();
+	
+	if (TIFR5 & (1 << OCF5A))
+	{
+		TIFR5 = 1 << OCF5A;
+		LCD_TraceWraps++;
+		/*! The count may have been read just before the wrap */
+		Count = TCNT5;
+	}
+	
+	Time = ((uint32_t)LCD_TraceWraps << 16) | Count;
+	
+	SREG = SavedSREG;
+	
+	return Time;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_TRACE_DROP(void)
+ *
+ * \brief Function to drop the oldest record in the trace
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static void prvLCD_TRACE_DROP(void)
+{
+	uint8_t Byte = LCD_TraceBuffer[LCD_TraceTail];
+	
+	LCD_TraceTail = (LCD_TraceTail + 1) & (configLCD_TRACE_LENGTH - 1);
+	
+	/*! Skip the ticks of a long gap */
+	if ((Byte & LCD_TRACE_DELTA) == LCD_TRACE_ESCAPE)
+	{
+		do
+		{
+			Byte = LCD_TraceBuffer[LCD_TraceTail];
+			LCD_TraceTail = (LCD_TraceTail + 1) & (configLCD_TRACE_LENGTH - 1);
+		} while (Byte & 0x80);
+	}
+	
+	/*! Skip the byte written */
+	LCD_TraceTail = (LCD_TraceTail + 1) & (configLCD_TRACE_LENGTH - 1);
+	
+	if (LCD_TraceDropped < 0xFFFF)
+	{
+		LCD_TraceDropped++;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_TRACE_RECORD(char RS, char data)
+ *
+ * \brief Function to add one write to the trace
+ *
+ * \details Writes less than LCD_TRACE_ESCAPE ticks, 508us at 16MHz, after
+ *			the one before take two bytes. Oldest records are dropped until
+ *			the new one fits.
+ *			
+ * \params[in] 	RS, data
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static void prvLCD_TRACE_RECORD(char RS, char data)
+{
+	uint8_t Record[LCD_TRACE_RECORD_MAX];
+	uint8_t Length = 1;
+	uint8_t i;
+	uint32_t Now;
+	uint32_t Delta;
+	
+	if (!LCD_TraceRunning)
+	{
+		return;
+	}
+	
+	Now = prvLCD_TRACE_NOW();
+	Delta = Now - LCD_TraceLast;
+	LCD_TraceLast = Now;
+	
+	if (Delta < LCD_TRACE_ESCAPE)
+	{
+		Record[0] = Delta;
+	}
+	else
+	{
+		Record[0] = LCD_TRACE_ESCAPE;
+		Delta = Delta - LCD_TRACE_ESCAPE;
+		while (Delta >= 0x80)
+		{
+			Record[Length++] = (Delta & 0x7F) | 0x80;
+			Delta = Delta >> 7;
+		}
+		Record[Length++] = Delta;
+	}
+	
+	if (RS == DATA_WR)
+	{
+		Record[0] = Record[0] | LCD_TRACE_RS;
+	}
+	Record[Length++] = data;
+	
+	/*! Make room, one byte is always left free */
+	while (((LCD_TraceTail - LCD_TraceHead - 1) & (configLCD_TRACE_LENGTH - 1)) < Length)
+	{
+		prvLCD_TRACE_DROP();
+	}
+	
+	for (i = 0; i < Length; i++)
+	{
+		LCD_TraceBuffer[LCD_TraceHead] = Record[i];
+		LCD_TraceHead = (LCD_TraceHead + 1) & (configLCD_TRACE_LENGTH - 1);
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_TRACE_START(void)
+ *
+ * \brief Function to empty the trace and start recording
+ *
+ * \details Starts Timer 5 and its compare interrupt if they are not
+ *			running. Call before vLCD_INITIALIZATION to record the start
+ *			up instructions too. Interrupts must be enabled for gaps
+ *			longer than 65535 ticks, 262ms at 16MHz, to be timed right.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_TRACE_START(void)
+{
+	uint8_t SavedSREG = SREG;
+	
+	cli();
+	
+	LCD_TraceHead = 0;
+	LCD_TraceTail = 0;
+	LCD_TraceDropped = 0;
+	
+	/*! Compare match at 0 is the counter wrapping */
+	(void)prvLCD_TIMER5_NOW();
+	if (!(TIMSK5 & (1 << OCIE5A)))
+	{
+		OCR5A = 0;
+		TIFR5 = 1 << OCF5A;
+		TIMSK5 = TIMSK5 | (1 << OCIE5A);
+	}
+	
+	LCD_TraceLast = prvLCD_TRACE_NOW();
+	LCD_TraceRunning = 1;
+	
+	SREG = SavedSREG;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_TRACE_STOP(void)
+ *
+ * \brief Function to stop recording
+ *
+ * \details The records are kept for vLCD_TRACE_DUMP and Timer 5 is left
+ *			running.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_TRACE_STOP(void)
+{
+	LCD_TraceRunning = 0;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_TRACE_DUMP(LCD_TraceWriter_t writer)
+ *
+ * \brief Function to pass the recorded trace to the application
+ *
+ * \details Calls writer with the dump header and then the records, in one
+ *			or two pieces as they lie in the ring buffer, and empties the
+ *			trace. Recording carries on, the first record after the dump is
+ *			timed from the last one in it, so dumps stored one after another
+ *			replay as one trace. Call from the task that owns the display.
+ *			
+ * \params[in] 	writer, stores or sends length bytes from data
+ *			
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_TRACE_DUMP(LCD_TraceWriter_t writer)
+{
+	uint8_t Header[LCD_TRACE_HEADER_LENGTH];
+	uint16_t Head = LCD_TraceHead;
+	uint16_t Tail = LCD_TraceTail;
+	uint16_t Length = (Head - Tail) & (configLCD_TRACE_LENGTH - 1);
+	
+	Header[0] = 'L';
+	Header[1] = 'T';
+	Header[2] = LCD_TRACE_VERSION;
+	Header[3] = (uint8_t)LCD_TRACE_TICK_NS;
+	Header[4] = (uint8_t)(LCD_TRACE_TICK_NS >> 8);
+	Header[5] = (uint8_t)LCD_TraceDropped;
+	Header[6] = (uint8_t)(LCD_TraceDropped >> 8);
+	Header[7] = (uint8_t)Length;
+	Header[8] = (uint8_t)(Length >> 8);
+	
+	writer(Header, LCD_TRACE_HEADER_LENGTH);
+	
+	if (Head < Tail)
+	{
+		/*! The records wrap round the end of the buffer */
+		writer(&LCD_TraceBuffer[Tail], configLCD_TRACE_LENGTH - Tail);
+		Tail = 0;
+	}
+	if (Head > Tail)
+	{
+		writer(&LCD_TraceBuffer[Tail], Head - Tail);
+	}
+	
+	LCD_TraceTail = Head;
+	LCD_TraceDropped = 0;
+}
+
+/*!****************************************************************************
+ *
+ * \fn ISR(TIMER5_COMPA_vect)
+ *
+ * \brief Timer 5 compare interrupt that counts the trace clock wraps
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+ISR(TIMER5_COMPA_vect)
+{
+	LCD_TraceWraps++;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*********************************/
+/*Library Shadow Buffer Functions*/
+/*********************************/
+
+#if configUSE_SHADOW_BUFFER == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_SHADOW_FILL(uint8_t, uint8_t, char)
+ *
+ * \brief Function to fill part of the shadow buffer with one character
+ *
+ * \details Cells are numbered across both lines, top line first, so a
+ *			fill can run from the end of the top line onto the bottom line.
+ *			
+ * \params[in] 	First cell, number of cells, character
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static void prvLCD_SHADOW_FILL(uint8_t first, uint8_t count, char character)
+{
+	uint8_t *Cell = &LCD_ShadowBuffer[0][0] + first;
+	
+	while (count--)
+	{
+		*Cell++ = character;
+	}
+	LCD_ShadowDirty = 1;
+}
+
+#if configUSE_MARQUEE == 1 || configUSE_PAGE_FLIP == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_SHADOW_SHIFTED(uint8_t from)
+ *
+ * \brief Function to move the shadow buffer along with a display shift
+ *
+ * \details A display shift changes the DDRAM cell showing in each column
+ *			without writing anything. Each column that still held what the
+ *			glass showed there before the shift, at shift from, is given
+ *			what the glass shows there now, so a flush does not undo the
+ *			shift. Columns changed since the last flush keep the change. 
+ *			With from LCD_ADDRESS_UNKNOWN every column follows the glass.
+ *			
+ * \params[in] 	from, the display shift before
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static void prvLCD_SHADOW_SHIFTED(uint8_t from)
+{
+	uint8_t Line;
+	uint8_t Column;
+	
+	for (Line = 0; Line < LCD_LINES; Line++)
+	{
+		for (Column = 0; Column < LCD_LINE_LENGTH; Column++)
+		{
+			if ((from == LCD_ADDRESS_UNKNOWN) || (LCD_ShadowBuffer[Line][Column] ==
+				LCD_GlassBuffer[Line][(Column + from) % LCD_DDRAM_LINE_LENGTH]))
+			{
+				LCD_ShadowBuffer[Line][Column] = 
+					LCD_GlassBuffer[Line][LCD_SHIFTED_CELL(Column)];
+			}
+		}
+	}
+}
+
+#endif
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_SHADOW_SEND(uint16_t budget, uint8_t *line)
+ *
+ * \brief Function to send the changed shadow buffer cells within a budget
+ *
+ * \details Compares LCD_ShadowBuffer with LCD_GlassBuffer one line at a
+ *			time, starting on *line and going round all of them. Each run
+ *			of changed cells costs one set DDRAM address instruction plus
+ *			one data write per cell. When two runs are separated by a gap
+ *			of unchanged cells no longer than LCD_SHADOW_JOIN_GAP, which
+ *			costs no more to rewrite than to re-address, the gap is
+ *			rewritten and the runs are joined. That only happens with fixed
+ *			delays; with the busy flag a data write (43us) costs more than
+ *			a set DDRAM address (39us) and the join is not built. The
+ *			address is skipped entirely when the controller's address
+ *			counter already points at the run.
+ *
+ *			Before each write its cost is added up, and the send stops
+ *			when the total would pass the budget, leaving the line it
+ *			stopped on in *line and the buffer dirty. The dirty flag is
+ *			cleared before the compare rather than after, so text another
+ *			task puts in part way through is sent next time. Afterwards the
+ *			display cursor is put back at the shadow cursor position.
+ *
+ *			The shadow buffer holds the columns showing on the glass, so
+ *			while the display is shifted each column is compared with and
+ *			written to the DDRAM cell showing in it.
+ *			
+ * \params[in] 	budget, bus time in microseconds, 0xFFFF for no limit
+ * \params[in] 	line, first line to compare, set to where the send stopped
+ *			
+ * \returns LCD_OK, LCD_ERROR_BUDGET, or LCD_ERROR_TIMEOUT if the controller
+ *			stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function, split out of vLCD_FLUSH
+ * 10/18/2026 - Only build the gap join where a rewrite can be cheaper
+ * 10/18/2026 - Compare and write the cells showing while the display is shifted
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_SHADOW_SEND(uint16_t budget, uint8_t *line)
+{
+	uint8_t Line = *line;
+	uint8_t Lines;
+	uint8_t Column;
+	#if LCD_SHADOW_JOIN_GAP > 0
+		uint8_t Gap;
+	#endif
+	uint8_t Address;
+	uint16_t Spent = 0;
+	uint8_t Result = LCD_OK;
+	uint8_t SavedX = CURSOR_X_POSITION;
+	uint8_t SavedY = CURSOR_Y_POSITION;
+	
+	/*! Cleared first, so text put in by another task meanwhile is not lost */
+	LCD_ShadowDirty = 0;
+	
+	for (Lines = 0; Lines < LCD_LINES; Lines++, Line = (Line + 1) % LCD_LINES)
+	{
+		const uint8_t *Shadow = LCD_ShadowBuffer[Line];
+		const uint8_t *Glass = LCD_GlassBuffer[Line];
+		
+		Column = 0;
+		while (Column < LCD_LINE_LENGTH)
+		{
+			/*! Skip cells that are already on the display */
+			if (Shadow[Column] == Glass[LCD_SHIFTED_CELL(Column)])
+			{
+				Column++;
+				continue;
+			}
+			
+			/*! Write the run, joining the next one across a short gap */
+			while (Column < LCD_LINE_LENGTH)
+			{
+				if (Shadow[Column] == Glass[LCD_SHIFTED_CELL(Column)])
+				{
+					#if LCD_SHADOW_JOIN_GAP > 0
+						Gap = 0;
+						while (Column + Gap < LCD_LINE_LENGTH &&
+							   Shadow[Column + Gap] == Glass[LCD_SHIFTED_CELL(Column + Gap)])
+						{
+							Gap++;
+						}
+						
+						/*! End of the line or cheaper to re-address */
+						if (Column + Gap == LCD_LINE_LENGTH || Gap > LCD_SHADOW_JOIN_GAP)
+						{
+							Column += Gap;
+							break;
+						}
+					#else
+						/*! Re-addressing is always cheaper than a rewrite */
+						break;
+					#endif
+				}
+				
+				/*! Address the start of the run unless already there, and
+					the cell after 39 of a shifted line */
+				Address = (Line ? LCD_LINE1_DDRAMADDR : LCD_LINE0_DDRAMADDR) +
+					LCD_SHIFTED_CELL(Column);
+				if (LCD_AddressCounter != Address)
+				{
+					Spent += LCD_ADDRESS_COST_US;
+					if (Spent > budget)
+						goto cut;
+					if (xWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_DDRAM | Address) != LCD_OK)
+						goto timeout;
+				}
+				
+				Spent += LCD_DATA_COST_US;
+				if (Spent > budget)
+					goto cut;
+				if (xWRITE_COMMAND_TO_LCD(DATA_WR, Shadow[Column]) != LCD_OK)
+					goto timeout;
+				Column++;
+			}
+		}
+	}
+	
+	goto restore;
+	
+cut:
+	/*! Over budget, the rest stays dirty for the next send */
+	LCD_ShadowDirty = 1;
+	Result = LCD_ERROR_BUDGET;
+	
+restore:
+	/*! Leave the display cursor where the application left it */
+	if (SavedX < LCD_LINE_LENGTH)
+	{
+		Address = (SavedY ? LCD_LINE1_DDRAMADDR : LCD_LINE0_DDRAMADDR) +
+			LCD_SHIFTED_CELL(SavedX);
+		if (LCD_AddressCounter != Address)
+			(void)xWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_DDRAM | Address);
+	}
+	goto done;
+	
+timeout:
+	LCD_ShadowDirty = 1;
+	Result = LCD_ERROR_TIMEOUT;
+	
+done:
+	/*! Data writes above moved the cursor, restore the shadow cursor */
+	CURSOR_X_POSITION = SavedX;
+	CURSOR_Y_POSITION = SavedY;
+	*line = (Result == LCD_OK) ? 0 : Line;
+	
+	return Result;
+}
+
+#endif
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_FLUSH(void)
+ *
+ * \brief Function to send the changed shadow buffer cells to the display
+ *
+ * \details Compares LCD_ShadowBuffer with LCD_GlassBuffer one line at a
+ *			time. Each run of changed cells costs one set DDRAM address
+ *			instruction plus one data write per cell. When two runs are
+ *			separated by a gap of unchanged cells no longer than
+ *			LCD_SHADOW_JOIN_GAP, only with fixed delays, the gap is
+ *			rewritten and the runs are joined. The address is skipped entirely when the controller's
+ *			address counter already points at the run. Afterwards the
+ *			display cursor is put back at the shadow cursor position.
+ *
+ *			Does nothing when the shadow buffer is disabled, since every
+ *			write has already gone to the display.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Counted by the instrumentation
+ * 10/18/2026 - Say when gaps are joined
+ *
+ ******************************************************************************
+ */
+void vLCD_FLUSH(void)
+{
+	LCD_STATS_ENTER(LCD_API_FLUSH);
+	
+	#if configUSE_SHADOW_BUFFER == 1
+	
+		uint8_t Line = 0;
+		
+		if (!LCD_ShadowDirty) return;
+		
+		/*! No budget, everything that changed goes out now */
+		(void)prvLCD_SHADOW_SEND(0xFFFF, &Line);
+	
+	#endif
+}
+
+#if configUSE_FRAME_SCHEDULER == 1
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_FRAME_WRITE(uint8_t x, uint8_t y, const char *text)
+ *
+ * \brief Function to put text in the next frame, returns at once
+ *
+ * \details Copies the text into the shadow buffer at x,y, cut at the end
+ *			of the line, and nothing else: no bus access, no cursor move.
+ *			Any task may call it at any rate. The copy and the counters are
+ *			a critical section, so text from two tasks writing at once is
+ *			not interleaved and no count is lost. A frame can still show
+ *			part of an update: xLCD_FRAME_SEND stops where the budget runs
+ *			out, and text written while a frame is being sent changes the
+ *			cells it has not reached yet. The rest follows in the next
+ *			frame. Text over cells no frame has sent yet counts as
+ *			coalesced, since what it replaces is never shown; text equal to
+ *			what is already there counts as dropped.
+ *			
+ * \params[in] 	x, column
+ * \params[in] 	y, line
+ * \params[in] 	text, zero terminated
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Compare with the cells showing while the display is shifted
+ * 10/18/2026 - Hold the copy with taskENTER_CRITICAL
+ * 10/18/2026 - State what the critical section covers
+ *
+ ******************************************************************************
+ */
+void vLCD_FRAME_WRITE(uint8_t x, uint8_t y, const char *text)
+{
+	LCD_STATS_ENTER(LCD_API_FRAME_WRITE);
+	
+	uint8_t *Shadow;
+	uint8_t Changed = 0;
+	uint8_t Pending = 0;
+	
+	if (y >= LCD_LINES) return;
+	
+	Shadow = &LCD_ShadowBuffer[y][x];
+	
+	taskENTER_CRITICAL();
+	
+	while (x < LCD_LINE_LENGTH && *text)
+	{
+		if (*Shadow != LCD_GlassBuffer[y][LCD_SHIFTED_CELL(x)])
+			Pending = 1;
+		if (*Shadow != (uint8_t)*text)
+		{
+			*Shadow = *text;
+			Changed = 1;
+		}
+		Shadow++;
+		text++;
+		x++;
+	}
+	
+	LCD_FrameStats.Updates++;
+	if (!Changed)
+		LCD_FrameStats.Dropped++;
+	else
+	{
+		LCD_ShadowDirty = 1;
+		if (Pending)
+			LCD_FrameStats.Coalesced++;
+	}
+	
+	taskEXIT_CRITICAL();
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_FRAME_SEND(void)
+ *
+ * \brief Function to send one frame of changes within the bus time budget
+ *
+ * \details Sends the cells that differ from the display the way vLCD_FLUSH
+ *			does, but stops before the estimated bus time would pass
+ *			configLCD_FRAME_BUDGET_US. The cells left over stay in the
+ *			shadow buffer, and the next frame starts on the line this one
+ *			stopped on so a busy top line cannot hold the bottom line back.
+ *			The gatekeeper calls it configLCD_FRAME_RATE_HZ times a second;
+ *			without the gatekeeper call it from a periodic task.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns LCD_OK, LCD_ERROR_BUDGET if changes are left for the next frame,
+ *			or LCD_ERROR_TIMEOUT if the controller stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_FRAME_SEND(void)
+{
+	LCD_STATS_ENTER(LCD_API_FRAME_SEND);
+	
+	uint8_t Result;
+	
+	LCD_FrameStats.Frames++;
+	
+	if (!LCD_ShadowDirty) return LCD_OK;
+	
+	Result = prvLCD_SHADOW_SEND(configLCD_FRAME_BUDGET_US, &LCD_FrameLine);
+	if (Result == LCD_ERROR_BUDGET)
+		LCD_FrameStats.Deferred++;
+	
+	return Result;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_FRAME_GET_STATS(LCD_FrameStats_t *stats)
+ *
+ * \brief Function to copy the frame counters
+ *
+ * \details Copied in a critical section, since vLCD_FRAME_WRITE may be
+ *			called from another task part way through.
+ *			
+ * \params[in] 	stats, where to put the counters
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Hold the copy with taskENTER_CRITICAL
+ *
+ ******************************************************************************
+ */
+void vLCD_FRAME_GET_STATS(LCD_FrameStats_t *stats)
+{
+	taskENTER_CRITICAL();
+	*stats = LCD_FrameStats;
+	taskEXIT_CRITICAL();
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_FRAME_RESET_STATS(void)
+ *
+ * \brief Function to zero the frame counters
+ *
+ * \params[in] 	nothing
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Hold the update with taskENTER_CRITICAL
+ *
+ ******************************************************************************
+ */
+void vLCD_FRAME_RESET_STATS(void)
+{
+	taskENTER_CRITICAL();
+	LCD_FrameStats.Updates = 0;
+	LCD_FrameStats.Coalesced = 0;
+	LCD_FrameStats.Dropped = 0;
+	LCD_FrameStats.Frames = 0;
+	LCD_FrameStats.Deferred = 0;
+	taskEXIT_CRITICAL();
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/******************************/
+/*Library DDRAM Read Functions*/
+/******************************/
+
+#if configUSE_BUSY_FLAG == 1 && configUSE_MULTI_DISPLAY == 0
+
+/*!****************************************************************************
+*
+* \fn prvLCD_READ_CELL(uint8_t address, uint8_t *data)
+*
+* \brief Function to read one DDRAM cell
+*
+* \details Sets the address unless the last read or write left the
+*		   address counter on it, sends whatever the peephole stage or
+*		   transmit queue still holds, waits for the busy flag and does
+*		   one read with R/W and RS high. The read steps the address
+*		   counter like a write, but never shifts the display.
+*
+* \params[in] address, DDRAM address of the cell
+* \params[in] data, where to put the character
+*
+* \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+*
+******************************************************************************
+*/
+static uint8_t prvLCD_READ_CELL(uint8_t address, uint8_t *data)
+{
+	uint8_t Column = address & 0x3F;
+	
+	if (LCD_AddressCounter != address)
+	{
+		if (xWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_DDRAM | address) != LCD_OK)
+			return LCD_ERROR_TIMEOUT;
+	}
+	
+	/*! The address must reach the controller before the read */
+	#if configUSE_PEEPHOLE == 1
+		if (xLCD_PEEPHOLE_FLUSH() != LCD_OK) return LCD_ERROR_TIMEOUT;
+	#endif
+	#if configUSE_TX_INTERRUPT == 1
+		vLCD_TX_FLUSH();
+	#endif
+	
+	if (prvLCD_READY_STATUS() == LCD_ADDRESS_UNKNOWN) return LCD_ERROR_TIMEOUT;
+	
+	*data = prvLCD_BUS_READ(DATA_RD);
+	
+	/*! Follow the step, the wrap between lines is left to a new address */
+	if ((LCD_EntryMode & (1 << LCD_ENTRY_INC)) && Column < LCD_DDRAM_LINE_LENGTH - 1)
+		LCD_AddressCounter = address + 1;
+	else if (!(LCD_EntryMode & (1 << LCD_ENTRY_INC)) && Column > 0)
+		LCD_AddressCounter = address - 1;
+	else
+		LCD_AddressCounter = LCD_ADDRESS_UNKNOWN;
+	
+	return LCD_OK;
+}
+
+/*!****************************************************************************
+*
+* \fn prvLCD_READ_END(uint8_t address)
+*
+* \brief Function to finish a run of reads
+*
+* \details Lets a rewrite still in the transmit queue go, waits for the
+*		   last read or write to finish, which the queue would not know
+*		   about, then sets the address counter back.
+*
+* \params[in] address, address counter before the reads, nothing is set
+*			  when it is LCD_ADDRESS_UNKNOWN
+*
+* \returns nothing
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+*
+******************************************************************************
+*/
+static void prvLCD_READ_END(uint8_t address)
+{
+	#if configUSE_TX_INTERRUPT == 1
+		vLCD_TX_FLUSH();
+	#endif
+	
+	(void)prvLCD_READY_STATUS();
+	
+	if (address != LCD_ADDRESS_UNKNOWN && LCD_AddressCounter != address)
+		(void)xWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_DDRAM | address);
+}
+
+/*!****************************************************************************
+*
+* \fn xLCD_READ_DDRAM(uint8_t x, uint8_t y, uint8_t length, char *buffer)
+*
+* \brief Function to read characters back from one line of DDRAM
+*
+* \details Reads length cells of line y from column x into buffer, left
+*		   to right whatever the entry mode, without a terminating '\0'.
+*		   Columns past the visible ones can be read up to the end of the
+*		   DDRAM line, cells past that are not read. The address counter
+*		   is put back afterwards, so writes carry on from the cursor; one
+*		   that was not known, after a set CGRAM address, is left in DDRAM.
+*
+* \params[in] x, first column
+* \params[in] y, line
+* \params[in] length, cells to read
+* \params[in] buffer, where to put them
+*
+* \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+*
+******************************************************************************
+*/
+uint8_t xLCD_READ_DDRAM(uint8_t x, uint8_t y, uint8_t length, char *buffer)
+{
+	LCD_STATS_ENTER(LCD_API_READ_DDRAM);
+	
+	uint8_t Saved = LCD_AddressCounter;
+	uint8_t Address = (y ? LCD_LINE1_DDRAMADDR : LCD_LINE0_DDRAMADDR) + x;
+	uint8_t Result = LCD_OK;
+	
+	if (x >= LCD_DDRAM_LINE_LENGTH) return LCD_OK;
+	if (length > LCD_DDRAM_LINE_LENGTH - x) length = LCD_DDRAM_LINE_LENGTH - x;
+	
+	while (length--)
+	{
+		Result = prvLCD_READ_CELL(Address++, (uint8_t *)buffer++);
+		if (Result != LCD_OK) return Result;
+	}
+	
+	prvLCD_READ_END(Saved);
+	
+	return LCD_OK;
+}
+
+#endif
+
+#if configUSE_SCRUB == 1
+
+/*!****************************************************************************
+*
+* \fn xLCD_SCRUB_STEP(void)
+*
+* \brief Function to check the next few cells and rewrite the wrong ones
+*
+* \details Reads configLCD_SCRUB_CELLS cells back, carrying on from where
+*		   the last call stopped, and compares each with LCD_GlassBuffer,
+*		   what the library last wrote to it. Only a cell that differs is
+*		   written again, so a display that is right gets no writes. The
+*		   address counter is put back afterwards, and while it is not
+*		   known, after a set CGRAM address, nothing is read at all so the
+*		   next CGRAM write still lands in CGRAM. Call it from an idle
+*		   slot, the calls per second times the cells per call set the
+*		   share of bus time it takes. The gatekeeper calls it when no
+*		   request came for configLCD_SCRUB_TICKS.
+*
+* \params[in] none
+*
+* \returns LCD_OK, or LCD_ERROR_TIMEOUT if the controller stayed busy
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+* 10/18/2026 - Skip the step while the address counter is not known
+*
+******************************************************************************
+*/
+uint8_t xLCD_SCRUB_STEP(void)
+{
+	LCD_STATS_ENTER(LCD_API_SCRUB);
+	
+	uint8_t Saved = LCD_AddressCounter;
+	uint8_t SavedX = CURSOR_X_POSITION;
+	uint8_t Cells = configLCD_SCRUB_CELLS;
+	uint8_t Line;
+	uint8_t Column;
+	uint8_t Value;
+	uint8_t Mode;
+	uint8_t Result = LCD_OK;
+	
+	/*! Part way through a CGRAM upload the address could not be put back */
+	if (Saved == LCD_ADDRESS_UNKNOWN) return LCD_OK;
+	
+	while (Cells--)
+	{
+		Line = LCD_ScrubNext / LCD_GLASS_LENGTH;
+		Column = LCD_ScrubNext % LCD_GLASS_LENGTH;
+		
+		Result = prvLCD_READ_CELL((Line ? LCD_LINE1_DDRAMADDR :
+			LCD_LINE0_DDRAMADDR) + Column, &Value);
+		if (Result != LCD_OK) goto done;
+		
+		LCD_ScrubStats.Checked++;
+		if (++LCD_ScrubNext == LCD_LINES * LCD_GLASS_LENGTH)
+		{
+			LCD_ScrubNext = 0;
+			LCD_ScrubStats.Passes++;
+		}
+		
+		if (Value == LCD_GlassBuffer[Line][Column]) continue;
+		
+		LCD_ScrubStats.Repaired++;
+		
+		/*! A shifting entry mode would move the display on the rewrite */
+		Mode = LCD_EntryMode;
+		if (Mode & (1 << LCD_ENTRY_SHIFT))
+			(void)xWRITE_COMMAND_TO_LCD(INSTR_WR, Mode & (uint8_t)~(1 << LCD_ENTRY_SHIFT));
+		
+		(void)xWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_DDRAM |
+			((Line ? LCD_LINE1_DDRAMADDR : LCD_LINE0_DDRAMADDR) + Column));
+		Result = xWRITE_COMMAND_TO_LCD(DATA_WR, LCD_GlassBuffer[Line][Column]);
+		
+		if (Mode & (1 << LCD_ENTRY_SHIFT))
+			(void)xWRITE_COMMAND_TO_LCD(INSTR_WR, Mode);
+		
+		if (Result != LCD_OK) goto done;
+	}
+	
+	prvLCD_READ_END(Saved);
+	
+done:
+	/*! The rewrites stepped the cursor, put it back */
+	CURSOR_X_POSITION = SavedX;
+	
+	return Result;
+}
+
+/*!****************************************************************************
+*
+* \fn vLCD_SCRUB_GET_STATS(LCD_ScrubStats_t *stats)
+*
+* \brief Function to copy the scrub counters
+*			
+* \params[in] 	stats, where to copy the counters
+*			
+* \returns nothing
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+*
+******************************************************************************
+*/
+void vLCD_SCRUB_GET_STATS(LCD_ScrubStats_t *stats)
+{
+	*stats = LCD_ScrubStats;
+}
+
+/*!****************************************************************************
+*
+* \fn vLCD_SCRUB_RESET_STATS(void)
+*
+* \brief Function to zero the scrub counters
+*			
+* \params[in] 	nothing
+*			
+* \returns nothing
+*
+* Modification History:
+*
+* 10/18/2026 - Original Function
+*
+******************************************************************************
+*/
+void vLCD_SCRUB_RESET_STATS(void)
+{
+	LCD_ScrubStats.Checked = 0;
+	LCD_ScrubStats.Repaired = 0;
+	LCD_ScrubStats.Passes = 0;
+}
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**********************************/
+/*Library Transmit Queue Functions*/
+/**********************************/
+
+#if configUSE_TX_INTERRUPT == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_EXECUTION_TIME_US(char RS, char data)
+ *
+ * \brief Function to look up how long the controller needs for a write
+ *
+ * \details Clear and return home take 1.53ms, other instructions 39us and
+ *			data writes 43us, as listed in the KS0066U datasheet.
+ *			
+ * \params[in] 	RS, data
+ *			
+ * \returns Execution time in microseconds
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint16_t prvLCD_EXECUTION_TIME_US(char RS, char data)
+{
+	if (RS == DATA_WR) return LCD_DATA_TIME_US;
+	
+	/*! Clear display is 0x01, return home is 0x02 or 0x03 */
+	if ((uint8_t)data < (1 << LCD_ENTRY_MODE)) return LCD_CLEAR_TIME_US;
+	
+	return LCD_INSTRUCTION_TIME_US;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_TX_ENQUEUE(char RS, char data)
+ *
+ * \brief Function to add a write to the transmit queue
+ *
+ * \details Stores the byte with the timer ticks the controller needs after
+ *			it, and starts Timer 3 if the queue was idle. When the queue is
+ *			full the caller waits for space. If interrupts are disabled at
+ *			that point the queue is serviced from here instead, so writes
+ *			made before the scheduler starts cannot dead-lock.
+ *			
+ * \params[in] 	RS, data
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static void prvLCD_TX_ENQUEUE(char RS, char data)
+{
+	uint8_t Next = (LCD_TxHead + 1) & (configTX_QUEUE_LENGTH - 1);
+	uint8_t SavedSREG;
+	
+	/*! Wait for room in the queue */
+	while (Next == LCD_TxTail)
+	{
+		if (!(SREG & (1 << SREG_I)) && (TIFR3 & (1 << OCF3A)))
+		{
+			TIFR3 = 1 << OCF3A;
+			prvLCD_TX_SERVICE();
+		}
+	}
+	
+	LCD_TxQueue[LCD_TxHead].RS = RS;
+	LCD_TxQueue[LCD_TxHead].Data = data;
+	LCD_TxQueue[LCD_TxHead].Ticks = 
+		prvLCD_EXECUTION_TIME_US(RS, data) * LCD_TX_TICKS_PER_US;
+	
+	SavedSREG = SREG;
+	cli();
+	
+	LCD_TxHead = Next;
+	
+	/*! Start the timer, the first compare match sends the byte */
+	if (!LCD_TxActive)
+	{
+		LCD_TxActive = 1;
+		TCNT3 = 0;
+		OCR3A = 1;
+		TIFR3 = 1 << OCF3A;
+		TCCR3A = 0x00;
+		/*! CTC mode, F_CPU/8 */
+		TCCR3B = (1 << WGM32) | (1 << CS31);
+		TIMSK3 = TIMSK3 | (1 << OCIE3A);
+	}
+	
+	SREG = SavedSREG;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_TX_SERVICE(void)
+ *
+ * \brief Function to send the next queued byte
+ *
+ * \details Called from the Timer 3 compare interrupt once the previous
+ *			byte's execution time has passed. Sends the next byte and sets
+ *			the compare value to that byte's execution time, or stops the
+ *			timer when the queue is empty. With the busy flag enabled the
+ *			flag is checked once first, after the function set only, and a
+ *			late controller is retried after LCD_TX_RETRY_US instead of
+ *			being waited on.
+ *
+ *			The counter is restarted once the byte is latched. The compare
+ *			value of 1 used to start the queue matches every microsecond,
+ *			so the flag raised again while this runs is cleared too.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Restart the counter and clear the flag after each byte
+ * 10/18/2026 - Do not read the flag before the function set
+ *
+ ******************************************************************************
+ */
+static void prvLCD_TX_SERVICE(void)
+{
+	LCD_TxEntry_t *Entry;
+	
+	if (LCD_TxTail == LCD_TxHead)
+	{
+		/*! Nothing left, stop the timer */
+		TCCR3B = 0x00;
+		TIMSK3 = TIMSK3 & ~(1 << OCIE3A);
+		LCD_TxActive = 0;
+		return;
+	}
+	
+	#if configUSE_BUSY_FLAG == 1
+		if (LCD_BusyFlagReady && (prvLCD_READ_STATUS() & (1 << LCD_BUSY)))
+		{
+			OCR3A = LCD_TX_RETRY_US * LCD_TX_TICKS_PER_US;
+			TCNT3 = 0;
+			TIFR3 = 1 << OCF3A;
+			return;
+		}
+	#endif
+	
+	Entry = &LCD_TxQueue[LCD_TxTail];
+	prvLCD_BUS_WRITE(Entry->RS, Entry->Data);
+	
+	/*! The execution time runs from the falling edge of E */
+	OCR3A = Entry->Ticks;
+	TCNT3 = 0;
+	TIFR3 = 1 << OCF3A;
+	
+	LCD_TxTail = (LCD_TxTail + 1) & (configTX_QUEUE_LENGTH - 1);
+}
+
+/*!****************************************************************************
+ *
+ * \fn ISR(TIMER3_COMPA_vect)
+ *
+ * \brief Timer 3 compare interrupt that paces the transmit queue
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+ISR(TIMER3_COMPA_vect)
+{
+	prvLCD_TX_SERVICE();
+}
+
+#endif
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_TX_IDLE(void)
+ *
+ * \brief Function to check if every queued byte has reached the display
+ *
+ * \details Lets a caller that needs ordering with something outside the
+ *			LCD, such as a delay before powering down, see whether the
+ *			queue has drained without blocking.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns 1 when the queue is empty and the timer has stopped, else 0.
+ *			Always 1 when the transmit queue is disabled.
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+uint8_t xLCD_TX_IDLE(void)
 {
-	/*! Call function to set cursor for bottom row's home position */
-	vLCD_HOME_BOTTOM_LINE();
-	/*! Call function to write string of 24 spaces to clear the bottom row */
-	vLCD_WRITE_STRING("                        ");
-	/*! Call function to set cursor for bottom row's home position */
-	vLCD_HOME_BOTTOM_LINE();
+	#if configUSE_TX_INTERRUPT == 1
+		return !LCD_TxActive;
+	#else
+		return 1;
+	#endif
 }
 
 /*!****************************************************************************
-*
-* \fn vLCD_ON_OFF(void)
-*
-* \brief Function to toggle LCD on and off
-*
-* \details Checks the current status of the LCD. If the LCD is on, toggle it
-*		   so it's off. If the LCD is off, turn it on. Uses the vLCD_WRITE
-*		   command to send instructions to the LCD.
-*	
-* \params[in] nothing
-*	
-* \returns nothing	
-*
-* Modification History:
-*
-* 11/18/2013 - Original Function
-* 11/24/2013 - Added code to function
-*
-******************************************************************************
-*/
-void vLCD_ON_OFF(void)
+ *
+ * \fn vLCD_TX_FLUSH(void)
+ *
+ * \brief Function to wait until every queued byte has reached the display
+ *
+ * \details Waits for the transmit queue to drain and the last byte's
+ *			execution time to pass. Services the queue directly if
+ *			interrupts are disabled.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing			
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Counted by the instrumentation
+ *
+ ******************************************************************************
+ */
+void vLCD_TX_FLUSH(void)
 {
-	/*! Create command to toggle LCD Display */
-	uint8_t LCD_Command = 
-		(1 << LCD_ON_OFF_INSTRCUTION) |
-		(OnOffStatus << LCD_ON_INSTRUCTION) |
-		(configCURSOR_SHOW << LCD_CURSOR_SHOW_INSTRUCTION) |
-		(configCURSOR_BLINK << LCD_CURSOR_BLINK_INSTRUCTION);
-	
-	/*! Toggle the OnOffStatus tracker variable */
-	OnOffStatus = OnOffStatus ^ 0x01;
+	LCD_STATS_ENTER(LCD_API_TX_FLUSH);
 	
-	/*! Toggle LCD */
-	vWRITE_COMMAND_TO_LCD(0, LCD_Command);
-	/*! Delay greater than 39us to allow LCD to complete operation */
-	_delay_us(50);
+	#if configUSE_TX_INTERRUPT == 1
+		while (LCD_TxActive)
+		{
+			if (!(SREG & (1 << SREG_I)) && (TIFR3 & (1 << OCF3A)))
+			{
+				TIFR3 = 1 << OCF3A;
+				prvLCD_TX_SERVICE();
+			}
+		}
+	#endif
 }
+
 /*****************************************************************************/
 
 /*****************************************************************************/
-/***************************/
-/*Library Length Functions*/
-/*************************/
+/******************************/
+/*Library Gatekeeper Functions*/
+/******************************/
+
+#if configUSE_LCD_GATEKEEPER == 1
 
 /*!****************************************************************************
  *
- * \fn xGet_Top_Length(void)
- *
- * \brief Function to get the remaining characters on the LCD
+ * \fn xLCD_GATEKEEPER_START(void)
  *
- * \details Function is called to calculate the amount of characters
- *			remaining on the current line
+ * \brief Function to create the gatekeeper task and its queue
  *
- *			This allows for tracking the amount of line space available.
+ * \details After this returns only the gatekeeper task may call the rest
+ *			of the library; other tasks use the xLCD_REQUEST_ functions.
+ *			vLCD_INITIALIZATION should be called before the scheduler
+ *			starts, or sent as raw commands through the queue.
  *			
  * \params[in] 	nothing
  *			
- * \returns Number of characters remaining on the current line			
+ * \returns pdPASS, or pdFAIL if the queue or task could not be created
  *
  * Modification History:
  *
- * 11/17/2013 - Original Function
- * 11/23/2013 - Added Code
+ * 10/18/2026 - Original Function
  *
  ******************************************************************************
  */
-uint8_t xLCD_Get_Length(void)
+BaseType_t xLCD_GATEKEEPER_START(void)
 {
-	return  (24 - CURSOR_X_POSITION); //returns number of characters left in the line
+	LCD_GatekeeperQueue = xQueueCreate(configLCD_GATEKEEPER_QUEUE_LENGTH,
+		sizeof(LCD_Request_t));
+	
+	if (LCD_GatekeeperQueue == NULL) return pdFAIL;
+	
+	vLCD_GATEKEEPER_RESET_STATS();
+	
+	return xTaskCreate(prvLCD_GATEKEEPER_TASK, "LCD", 
+		configLCD_GATEKEEPER_STACK_SIZE, NULL, 
+		configLCD_GATEKEEPER_PRIORITY, NULL);
 }
 
-/*****************************************************************************/
-
-/*****************************************************************************/
-/************************/
-/*Library Home Functions*/
-/************************/
-
 /*!****************************************************************************
  *
- * \fn vLCD_GO_TO_Position(uint8_t, uint8_t)
+ * \fn prvLCD_GATEKEEPER_CELL(void)
  *
- * \brief Function to directly control LCD cursor Position
+ * \brief Function to number the visible cell under the cursor
  *
- * \details Function is called to move the LCD cursor to a specific location 
- *				on the LCD.
+ * \details Cells are numbered along the top line and on along the
+ *			bottom one, and a cursor past the end of a line counts as the
+ *			end of it.
+ *			
+ * \params[in] 	nothing
+ *			
+ * \returns Cell number, 0 to LCD_LINES * LCD_LINE_LENGTH
  *
- *			Allows for direct control of where data can be written, rather
- *				than only from the beginning of a line
+ * Modification History:
  *
- *			Saves current cursor position for text wrapping
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static uint8_t prvLCD_GATEKEEPER_CELL(void)
+{
+	uint8_t X = CURSOR_X_POSITION;
+	
+	if (X > LCD_LINE_LENGTH) X = LCD_LINE_LENGTH;
+	
+	return CURSOR_Y_POSITION * LCD_LINE_LENGTH + X;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_GATEKEEPER_TASK(void *pvParameters)
+ *
+ * \brief Task that owns the display and carries out queued requests
+ *
+ * \details Blocks on the request queue and runs each request with the
+ *			normal library functions. When the queue runs empty the shadow
+ *			buffer is flushed, so a burst of requests is sent as one set of
+ *			changed cells. With the frame scheduler the requests only fill
+ *			the shadow buffer and the changes are sent by xLCD_FRAME_SEND
+ *			every LCD_FRAME_TICKS instead, followed by a scrub step when
+ *			the scrubber is built. Characters are counted by how far the
+ *			cursor moved along the visible lines, so text that ran off the
+ *			end of a line or was cut short by a timeout is not.
  *			
- * \params[in] 	Character, Row 	
+ * \params[in] 	pvParameters, not used
  *			
- * \returns nothing			
+ * \returns never
  *
  * Modification History:
  *
- * 11/15/2013 - Original Function
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Run a scrub step when no request comes
+ * 10/18/2026 - Send frames at the frame rate
+ * 10/18/2026 - Count the characters that land on the line
  *
  ******************************************************************************
  */
-void vLCD_GO_TO_POSITION(uint8_t x, uint8_t y)
+static void prvLCD_GATEKEEPER_TASK(void *pvParameters)
 {
-	//save the current position
-	register uint8_t DDRAMAddr;
+	LCD_Request_t Request;
+	UBaseType_t Waiting;
+	uint8_t Start;
+	#if configUSE_FRAME_SCHEDULER == 1
+		TickType_t NextFrame;
+		TickType_t Now;
+		TickType_t Wait;
+	#endif
 	
-	// For each line o the LCD
-	switch(y)
+	(void)pvParameters;
+	
+	#if configUSE_FRAME_SCHEDULER == 1
+		NextFrame = xTaskGetTickCount() + LCD_FRAME_TICKS;
+	#endif
+	
+	for (;;)
 	{
-		case 0: 
-			//for the top line, set the DDRAM address 
-			//move a certain number of characters to the right
-			DDRAMAddr = LCD_LINE0_DDRAMADDR + x;
-		break;
+		#if configUSE_FRAME_SCHEDULER == 1
+			/*! Send the frame when it is due, wrapped means it is late */
+			Now = xTaskGetTickCount();
+			Wait = NextFrame - Now;
+			if (Wait == 0 || Wait > LCD_FRAME_TICKS)
+			{
+				(void)xLCD_FRAME_SEND();
+				#if configUSE_SCRUB == 1
+					/*! The rest of the frame is an idle slot for the scrubber */
+					(void)xLCD_SCRUB_STEP();
+				#endif
+				
+				/*! A late frame moves the next one back rather than bunching */
+				NextFrame = Wait ? Now + LCD_FRAME_TICKS : NextFrame + LCD_FRAME_TICKS;
+				continue;
+			}
+			
+			if (xQueueReceive(LCD_GatekeeperQueue, &Request, Wait) != pdTRUE)
+				continue;
+		#elif configUSE_SCRUB == 1
+			/*! A quiet spell is an idle slot for the scrubber */
+			if (xQueueReceive(LCD_GatekeeperQueue, &Request,
+				configLCD_SCRUB_TICKS) != pdTRUE)
+			{
+				(void)xLCD_SCRUB_STEP();
+				continue;
+			}
+		#else
+			xQueueReceive(LCD_GatekeeperQueue, &Request, portMAX_DELAY);
+		#endif
 		
-		case 1: 
-			//for the bottom line, set the DDRAM address 
-			//move a certain number of characters to the right
-			DDRAMAddr = LCD_LINE1_DDRAMADDR + x;
-		break;
+		/*! Include the request just taken in the high water mark */
+		Waiting = uxQueueMessagesWaiting(LCD_GatekeeperQueue) + 1;
+		if (Waiting > LCD_GatekeeperStats.HighWater)
+			LCD_GatekeeperStats.HighWater = Waiting;
 		
-		default: 
-			//default to the top left of the LCD if nothing is specified
-			DDRAMAddr = LCD_LINE0_DDRAMADDR+x;
+		switch (Request.Type)
+		{
+			case LCD_REQUEST_WRITE:
+				vLCD_GO_TO_POSITION(Request.X, Request.Y);
+				/* fall through */
+			case LCD_REQUEST_STRING:
+				Start = prvLCD_GATEKEEPER_CELL();
+				vLCD_WRITE_STRING(Request.Text);
+				LCD_GatekeeperStats.Characters += prvLCD_GATEKEEPER_CELL() - Start;
+			break;
+			
+			case LCD_REQUEST_POSITION:
+				vLCD_GO_TO_POSITION(Request.X, Request.Y);
+			break;
+			
+			case LCD_REQUEST_CLEAR:
+				vLCD_CLEAR();
+			break;
+			
+			case LCD_REQUEST_CLEAR_TOP:
+				vLCD_CLEAR_TOP();
+			break;
+			
+			case LCD_REQUEST_CLEAR_BOTTOM:
+				vLCD_CLEAR_BOTTOM();
+			break;
+			
+			case LCD_REQUEST_COMMAND:
+				vWRITE_COMMAND_TO_LCD(Request.X, Request.Y);
+			break;
+			
+			default:
+			break;
+		}
+		
+		LCD_GatekeeperStats.Requests++;
+		
+		#if configUSE_FRAME_SCHEDULER == 0
+			/*! Send the accumulated changes once the burst is over */
+			if (uxQueueMessagesWaiting(LCD_GatekeeperQueue) == 0)
+				vLCD_FLUSH();
+		#endif
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvLCD_REQUEST(LCD_Request_t *, TickType_t)
+ *
+ * \brief Function to send a request to the gatekeeper queue
+ *
+ * \details Counts requests that could not be queued in time.
+ *			
+ * \params[in] 	Request, ticks to wait for space
+ *			
+ * \returns pdPASS, or errQUEUE_FULL
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+static BaseType_t prvLCD_REQUEST(LCD_Request_t *request, TickType_t xTicksToWait)
+{
+	if (xQueueSendToBack(LCD_GatekeeperQueue, request, xTicksToWait) != pdPASS)
+	{
+		taskENTER_CRITICAL();
+		LCD_GatekeeperStats.QueueFull++;
+		taskEXIT_CRITICAL();
+		return errQUEUE_FULL;
 	}
+	return pdPASS;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_REQUEST_STRING(const char *, TickType_t)
+ *
+ * \brief Function to ask the gatekeeper to write a string at the cursor
+ *
+ * \details The string is copied into the request so the caller's buffer
+ *			can be reused at once. A string longer than LCD_LINE_LENGTH is
+ *			refused rather than cut, split it into a request per line.
+ *			Pass 0 ticks to never block.
+ *			
+ * \params[in] 	String, ticks to wait for space in the queue
+ *			
+ * \returns pdPASS, errQUEUE_FULL, or errLCD_TEXT_TOO_LONG
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Refuse text longer than a line instead of cutting it
+ *
+ ******************************************************************************
+ */
+BaseType_t xLCD_REQUEST_STRING(const char *str_ptr, TickType_t xTicksToWait)
+{
+	LCD_Request_t Request;
+	uint8_t Length = 0;
 	
-	//save current cursor position X
-	CURSOR_X_POSITION = x;
-	//save current cursor position Y
-	CURSOR_Y_POSITION = y;
+	Request.Type = LCD_REQUEST_STRING;
+	while (str_ptr[Length] != '\0')
+	{
+		if (Length == LCD_LINE_LENGTH) return errLCD_TEXT_TOO_LONG;
+		Request.Text[Length] = str_ptr[Length];
+		Length++;
+	}
+	Request.Text[Length] = '\0';
 	
-	// send a command to set the data address
-	vWRITE_COMMAND_TO_LCD(INSTR_WR, 1 <<LCD_DDRAM | DDRAMAddr);
+	return prvLCD_REQUEST(&Request, xTicksToWait);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_REQUEST_WRITE(uint8_t, uint8_t, const char *, TickType_t)
+ *
+ * \brief Function to ask the gatekeeper to write a string at a position
+ *
+ * \details Same as xLCD_REQUEST_STRING but moves the cursor first, in the
+ *			same request, so no other task's text can land in between.
+ *			
+ * \params[in] 	Character, Row, String, ticks to wait for space in the queue
+ *			
+ * \returns pdPASS, errQUEUE_FULL, or errLCD_TEXT_TOO_LONG
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Refuse text longer than a line instead of cutting it
+ *
+ ******************************************************************************
+ */
+BaseType_t xLCD_REQUEST_WRITE(uint8_t x, uint8_t y, const char *str_ptr, 
+	TickType_t xTicksToWait)
+{
+	LCD_Request_t Request;
+	uint8_t Length = 0;
+	
+	Request.Type = LCD_REQUEST_WRITE;
+	Request.X = x;
+	Request.Y = y;
+	while (str_ptr[Length] != '\0')
+	{
+		if (Length == LCD_LINE_LENGTH) return errLCD_TEXT_TOO_LONG;
+		Request.Text[Length] = str_ptr[Length];
+		Length++;
+	}
+	Request.Text[Length] = '\0';
 	
-	// Delay greater than 39us to allow LCD to complete operation
-	_delay_us(50);
+	return prvLCD_REQUEST(&Request, xTicksToWait);
 }
 
 /*!****************************************************************************
  *
- * \fn vLCD_HOME_TOP_LINE(void)
+ * \fn xLCD_REQUEST_POSITION(uint8_t, uint8_t, TickType_t)
  *
- * \brief Function to return to home position on the top line of the LCD
+ * \brief Function to ask the gatekeeper to move the cursor
+ *			
+ * \params[in] 	Character, Row, ticks to wait for space in the queue
+ *			
+ * \returns pdPASS, or errQUEUE_FULL
  *
- * \details Function is called to return the cursor to the first position
- *				on the top line of the LCD.
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+BaseType_t xLCD_REQUEST_POSITION(uint8_t x, uint8_t y, TickType_t xTicksToWait)
+{
+	LCD_Request_t Request;
+	
+	Request.Type = LCD_REQUEST_POSITION;
+	Request.X = x;
+	Request.Y = y;
+	
+	return prvLCD_REQUEST(&Request, xTicksToWait);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_REQUEST_CLEAR(uint8_t, TickType_t)
+ *
+ * \brief Function to ask the gatekeeper to clear the display
  *			
- *			This allows for the the top line to be ready to write 
- *				independently from the bottom line.
+ * \params[in] 	LCD_REQUEST_CLEAR, LCD_REQUEST_CLEAR_TOP or 
+ *				LCD_REQUEST_CLEAR_BOTTOM, ticks to wait for space in the queue
  *			
- * \params[in] none		
+ * \returns pdPASS, or errQUEUE_FULL
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+BaseType_t xLCD_REQUEST_CLEAR(uint8_t type, TickType_t xTicksToWait)
+{
+	LCD_Request_t Request;
+	
+	Request.Type = type;
+	
+	return prvLCD_REQUEST(&Request, xTicksToWait);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xLCD_REQUEST_COMMAND(char, char, TickType_t)
+ *
+ * \brief Function to ask the gatekeeper to send a raw command
  *			
- * \returns nothing			
+ * \params[in] 	RS, data, ticks to wait for space in the queue
+ *			
+ * \returns pdPASS, or errQUEUE_FULL
  *
  * Modification History:
  *
- * 11/15/2013 - Original Function
+ * 10/18/2026 - Original Function
  *
  ******************************************************************************
  */
-void vLCD_HOME_TOP_LINE(void)
+BaseType_t xLCD_REQUEST_COMMAND(char RS, char data, TickType_t xTicksToWait)
 {
-	//move cursor to the top left position of the LCD
-	vWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_HOME_TOP_LINE);
+	LCD_Request_t Request;
 	
-	// Delay greater than 1.53ms to allow LCD to complete operation
-	_delay_us(1530);
+	Request.Type = LCD_REQUEST_COMMAND;
+	Request.X = RS;
+	Request.Y = data;
+	
+	return prvLCD_REQUEST(&Request, xTicksToWait);
 }
 
 /*!****************************************************************************
  *
- * \fn vLCD_HOME_BOTTOM_LINE(void)
+ * \fn vLCD_GATEKEEPER_GET_STATS(LCD_GatekeeperStats_t *)
  *
- * \brief Function to return to home position on the bottom line of the LCD
+ * \brief Function to copy the gatekeeper counters
  *
- * \details Function is called to return the cursor to the first position
- *				on the bottom line of the LCD.
+ * \details Sampling Characters twice a known time apart gives the
+ *			sustained characters per second, and QueueFull against
+ *			Requests shows whether the queue or priority is too small.
  *			
- *			This allows for the the bottom line to be ready to write 
- *				independently from the top line.
+ * \params[in] 	Where to copy the counters
  *			
- * \params[in] none		
+ * \returns nothing
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+void vLCD_GATEKEEPER_GET_STATS(LCD_GatekeeperStats_t *stats)
+{
+	taskENTER_CRITICAL();
+	*stats = LCD_GatekeeperStats;
+	taskEXIT_CRITICAL();
+}
+
+/*!****************************************************************************
+ *
+ * \fn vLCD_GATEKEEPER_RESET_STATS(void)
+ *
+ * \brief Function to zero the gatekeeper counters
  *			
- * \returns nothing			
+ * \params[in] 	nothing
+ *			
+ * \returns nothing
  *
  * Modification History:
  *
- * 11/15/2013 - Original Function
+ * 10/18/2026 - Original Function
  *
  ******************************************************************************
  */
-void vLCD_HOME_BOTTOM_LINE(void)
+void vLCD_GATEKEEPER_RESET_STATS(void)
 {
-	//move the cursor to the bottom left position on the LCD
-	vLCD_GO_TO_POSITION(0,1);
-	
-	// Delay greater than 39us to allow LCD to complete operation
-	_delay_us(50);
+	taskENTER_CRITICAL();
+	LCD_GatekeeperStats.Requests = 0;
+	LCD_GatekeeperStats.Characters = 0;
+	LCD_GatekeeperStats.QueueFull = 0;
+	LCD_GatekeeperStats.HighWater = 0;
+	taskEXIT_CRITICAL();
 }
 
+#endif
+
 /*****************************************************************************/
- 
- 
@@ -11,6 +11,36 @@
  *			
  *
  * Modification History:
+ * 10/18/2026 - Let configTX_QUEUE_LENGTH be set with -D and check it
+ * 10/18/2026 - Let configBUSY_TIMEOUT_POLLS be set with -D
+ * 10/18/2026 - State that only one task may call the library with yielding waits
+ * 10/18/2026 - Keep the instrumentation entry a declaration in every build
+ * 10/18/2026 - Reject gatekeeper text longer than a line
+ * 10/18/2026 - Round the transmit queue ticks per microsecond up
+ * 10/18/2026 - Added RTOS yielding waits for long controller operations
+ * 10/18/2026 - Added UTF-8 writer with ROM code tables
+ * 10/18/2026 - Added named field layouts
+ * 10/18/2026 - Added frame paced update scheduler
+ * 10/18/2026 - Added DDRAM read back and background scrub
+ * 10/18/2026 - Added warm start detection
+ * 10/18/2026 - Added broadcast writes, clear and initialization
+ * 10/18/2026 - Added multi display handles and interleaved scheduler
+ * 10/18/2026 - Added off screen page flip
+ * 10/18/2026 - Added display shift marquee
+ * 10/18/2026 - Added CGRAM bar graphs and sparklines
+ * 10/18/2026 - Added CGRAM glyph cache
+ * 10/18/2026 - Added bus trace recorder
+ * 10/18/2026 - Added optional per call instrumentation counters
+ * 10/18/2026 - Configuration can be overridden with -D for the host simulator
+ * 10/18/2026 - Added integer, fixed point and hex writers
+ * 10/18/2026 - Added scatter gather segment writes
+ * 10/18/2026 - Added optional peephole stage for instruction writes
+ * 10/18/2026 - Added set-DDRAM based line clear, fill and home functions
+ * 10/18/2026 - Made 4-bit bus mode operational
+ * 10/18/2026 - Added FreeRTOS gatekeeper task
+ * 10/18/2026 - Added interrupt driven transmit queue
+ * 10/18/2026 - Added shadow DDRAM buffer
+ * 10/18/2026 - Added busy flag polling configuration and return codes
  * 11/18/2013 - Pulled all definitions and prototypes in
  * 11/16/2013 - Original File
  *
@@ -102,6 +132,8 @@ uint8_t OnOffStatus = 0;
 #define LDDR DDRK
 /*! define MCU register for port connected to LCD control pins */
 #define LCDR DDRJ
+/*! define MCU input register for port connected to LCD data pins */
+#define LDPIN PINK
 
 /*****************************************************************************/
 
@@ -149,6 +181,10 @@ uint8_t OnOffStatus = 0;
 // cursor position to DDRAM mapping
 #define LCD_LINE0_DDRAMADDR		0x00
 #define LCD_LINE1_DDRAMADDR		0x40
+/*! DDRAM cells per line, including the ones past the visible area */
+#define LCD_DDRAM_LINE_LENGTH	40
+/*! Address counter value used when the DDRAM address is not known */
+#define LCD_ADDRESS_UNKNOWN		0xFF
 
 /*! Instructions for clearing LCD */
 #define LCD_CLEAR_INSTRUCTION 	LCD_D0
@@ -158,16 +194,38 @@ uint8_t OnOffStatus = 0;
 #define LCD_ON_INSTRUCTION 		LCD_D2
 
 /*! Defines the cursor settings for the LCD */
-#define configCURSOR_SHOW				1
-#define configCURSOR_BLINK				1
+#ifndef configCURSOR_SHOW
+	#define configCURSOR_SHOW				1
+#endif
+#ifndef configCURSOR_BLINK
+	#define configCURSOR_BLINK				1
+#endif
 #define LCD_CURSOR_SHOW_INSTRUCTION		LCD_D1
 #define LCD_CURSOR_BLINK_INSTRUCTION	LCD_D0
 	
 /*! Defines the writing settings for the LCD */
 #define configTEXT_WRAP		1
 
+/*! 
+ * Defines the data bus width
+ *	BITMODE8 uses LCD D0-D7 on MCU pins 0-7 of LDP.
+ *	BITMODE4 uses LCD D4-D7 on MCU pins 4-7 of LDP only, each byte is sent
+ *		as two nibbles and LDP pins 0-3 are left free for other use.
+ */
 //#define BITMODE4
-#define BITMODE8
+#ifndef BITMODE4
+	#define BITMODE8
+#endif
+
+#ifdef BITMODE4
+	/*! DL bit of the function set instruction */
+	#define LCD_BUS_8BIT		0
+	/*! LDP pins driven by the library */
+	#define LCD_DATA_MASK		0xF0
+#else
+	#define LCD_BUS_8BIT		1
+	#define LCD_DATA_MASK		0xFF
+#endif
 
 #define TWO_LINE_MODE		1
 #define FONT_TYPE			1
@@ -179,6 +237,1228 @@ uint8_t OnOffStatus = 0;
 
 #define DATA_WR 			1
 #define INSTR_WR 			0
+#define DATA_RD 			1
+#define STATUS_RD 			0
+
+/*! 
+ * Defines how the library waits for the controller to finish an instruction
+ *	when set to '1' the busy flag is read back over R/W before every write,
+ *		so each transfer only takes as long as the controller needs.
+ *	when set to '0' fixed datasheet delays are used. Use this for boards
+ *		that tie R/W low.
+ */
+#ifndef configUSE_BUSY_FLAG
+	#define configUSE_BUSY_FLAG		1
+#endif
+
+/*! 
+ * Number of busy flag polls before a write gives up. Each poll takes
+ *	roughly 2us, so the default covers the 1.53ms clear/home instructions.
+ */
+#ifndef configBUSY_TIMEOUT_POLLS
+	#define configBUSY_TIMEOUT_POLLS	1000
+#endif
+
+/*! The polls are counted in a uint16_t */
+#if configBUSY_TIMEOUT_POLLS < 1 || configBUSY_TIMEOUT_POLLS > 65535
+	#error configBUSY_TIMEOUT_POLLS must be 1 to 65535
+#endif
+
+/*! 
+ * Enables the interrupt driven transmit queue
+ *	when set to '1' writes are queued and Timer 3 paces them onto the bus
+ *		from its compare interrupt, so the write functions return as soon
+ *		as the bytes are queued. Call vLCD_TX_FLUSH to wait for them.
+ *	when set to '0' every write waits for the bus.
+ */
+#ifndef configUSE_TX_INTERRUPT
+	#define configUSE_TX_INTERRUPT	0
+#endif
+
+/*! Number of bytes the transmit queue holds, must be a power of two */
+#ifndef configTX_QUEUE_LENGTH
+	#define configTX_QUEUE_LENGTH	32
+#endif
+
+/*! The head and tail are uint8_t and wrap with a mask */
+#if (configTX_QUEUE_LENGTH & (configTX_QUEUE_LENGTH - 1)) != 0 || \
+	configTX_QUEUE_LENGTH > 256
+	#error configTX_QUEUE_LENGTH must be a power of two, at most 256
+#endif
+
+/*!
+ * Timer 3 runs at F_CPU/8 while the transmit queue is busy. The ticks in a
+ *	microsecond are rounded up, so a byte is never sent early: below 8MHz
+ *	one tick is more than a microsecond and the waits run long, at 1MHz
+ *	eight times the execution time.
+ */
+#define LCD_TX_TICKS_PER_US		((F_CPU / 8UL + 999999UL) / 1000000UL)
+/*! Time before the busy flag is read again when the controller ran late */
+#define LCD_TX_RETRY_US			4
+
+/*! Execution times of the controller instructions from the datasheet */
+#define LCD_CLEAR_TIME_US		1530
+#define LCD_INSTRUCTION_TIME_US	39
+#define LCD_DATA_TIME_US		43
+
+/*! 
+ * Enables the FreeRTOS gatekeeper task
+ *	when set to '1' xLCD_GATEKEEPER_START creates a task that owns the
+ *		display. Other tasks send it requests through a queue with the
+ *		xLCD_REQUEST_ functions instead of calling the library directly.
+ *	when set to '0' the gatekeeper is not built.
+ */
+#ifndef configUSE_LCD_GATEKEEPER
+	#define configUSE_LCD_GATEKEEPER			0
+#endif
+
+/*! Number of requests the gatekeeper queue holds */
+#ifndef configLCD_GATEKEEPER_QUEUE_LENGTH
+	#define configLCD_GATEKEEPER_QUEUE_LENGTH	8
+#endif
+/*! Priority of the gatekeeper task, keep it low so bus work never delays others */
+#ifndef configLCD_GATEKEEPER_PRIORITY
+	#define configLCD_GATEKEEPER_PRIORITY		(tskIDLE_PRIORITY + 1)
+#endif
+/*! Stack size of the gatekeeper task in words */
+#ifndef configLCD_GATEKEEPER_STACK_SIZE
+	#define configLCD_GATEKEEPER_STACK_SIZE		(configMINIMAL_STACK_SIZE + 64)
+#endif
+
+/*! 
+ * Enables waits that block the calling task
+ *	when set to '1' the power on wait, the 4-bit reset wait and the wait
+ *		for clear display block the calling task with vTaskDelay when they
+ *		are configLCD_YIELD_THRESHOLD_US or longer, so other tasks and
+ *		tickless idle get the CPU. Shorter waits still spin, and so does
+ *		every wait before the scheduler starts, while it is suspended or
+ *		with interrupts off. A blocked wait ends on a tick, so it can take
+ *		up to two ticks longer than the controller needs. The library is
+ *		not reentrant and a blocked call is part way through, so only one
+ *		task may call it: the gatekeeper, or a single task without it.
+ *	when set to '0' every wait spins.
+ */
+#ifndef configUSE_YIELD_WAIT
+	#define configUSE_YIELD_WAIT			0
+#endif
+
+/*! Shortest wait in microseconds that blocks instead of spinning */
+#ifndef configLCD_YIELD_THRESHOLD_US
+	#define configLCD_YIELD_THRESHOLD_US	1000
+#endif
+
+/*! Delay after an instruction, only needed when the busy flag is not read */
+#if configUSE_BUSY_FLAG == 1 || configUSE_TX_INTERRUPT == 1
+	#define LCD_EXECUTION_DELAY_US(us)
+#else
+	#define LCD_EXECUTION_DELAY_US(us)	LCD_DELAY_US(us)
+#endif
+
+/*! Bus time of a set DDRAM address instruction and of a data write */
+#if configUSE_BUSY_FLAG == 1 || configUSE_TX_INTERRUPT == 1
+	#define LCD_ADDRESS_COST_US		LCD_INSTRUCTION_TIME_US
+	#define LCD_DATA_COST_US		LCD_DATA_TIME_US
+#else
+	#define LCD_ADDRESS_COST_US		100
+	#define LCD_DATA_COST_US		100
+#endif
+
+/*!
+ * Longest gap of unchanged cells the shadow flush rewrites to save a set
+ *	DDRAM address. With the busy flag a data write takes longer than the
+ *	address, so this is 0 and runs are never joined; with fixed delays
+ *	both take 100us and one cell gaps are joined.
+ */
+#define LCD_SHADOW_JOIN_GAP		(LCD_ADDRESS_COST_US / LCD_DATA_COST_US)
+
+/*! 
+ * Enables the shadow DDRAM buffer
+ *	when set to '1' the write, clear and position functions only change a
+ *		RAM copy of both lines, and vLCD_FLUSH sends the cells that differ
+ *		from what is on the display.
+ *	when set to '0' every write goes straight to the display.
+ */
+#ifndef configUSE_SHADOW_BUFFER
+	#define configUSE_SHADOW_BUFFER	0
+#endif
+
+/*! 
+ * Enables the peephole stage in xWRITE_COMMAND_TO_LCD
+ *	when set to '1' instructions that would not change the controller are
+ *		dropped: a set DDRAM address to the address it already holds, and
+ *		display control or entry mode equal to the last one sent. While the
+ *		cursor and blink are off a set DDRAM address is held back until the
+ *		next write, so a move followed by another move sends only the last.
+ *	when set to '0' every instruction goes to the bus.
+ */
+#ifndef configUSE_PEEPHOLE
+	#define configUSE_PEEPHOLE		0
+#endif
+
+/*! 
+ * Enables the CGRAM glyph cache
+ *	when set to '1' the application registers a table of 5x8 glyphs with
+ *		vLCD_GLYPH_TABLE and writes them by ID with xLCD_WRITE_GLYPH. A
+ *		glyph is loaded into one of the 8 CGRAM slots when it is first
+ *		used and is not sent again while it stays there. When every slot
+ *		is taken the least recently used one that no visible cell shows
+ *		is reloaded.
+ *	when set to '0' the cache is not built.
+ */
+#ifndef configUSE_GLYPH_CACHE
+	#define configUSE_GLYPH_CACHE	0
+#endif
+
+/*! 
+ * Enables the bar graph and sparkline writers, needs configUSE_GLYPH_CACHE
+ *	when set to '1' xLCD_BAR_SET draws a horizontal bar with a resolution
+ *		of one dot column and xLCD_SPARK_PUSH scrolls a line of 8 level
+ *		columns. Each call only rewrites the cells that change. The partial
+ *		cells are glyphs built into the library and are loaded through the
+ *		glyph cache, so they share the 8 CGRAM slots with the application.
+ *	when set to '0' the writers are not built.
+ */
+#ifndef configUSE_BAR_GRAPH
+	#define configUSE_BAR_GRAPH		0
+#endif
+
+#if configUSE_BAR_GRAPH == 1 && configUSE_GLYPH_CACHE == 0
+	#error configUSE_BAR_GRAPH needs configUSE_GLYPH_CACHE
+#endif
+
+/*! Character ROMs the controller can be ordered with */
+#define LCD_ROM_A00		0	// Japanese standard font, katakana and some Greek
+#define LCD_ROM_A02		1	// European font, ISO 8859-1 from 0xA1 up
+
+/*! Character ROM of the fitted controller, picks the UTF-8 table */
+#ifndef configLCD_ROM
+	#define configLCD_ROM			LCD_ROM_A00
+#endif
+
+/*! 
+ * Enables the UTF-8 writer
+ *	when set to '1' xLCD_WRITE_UTF8 decodes UTF-8 text and writes each
+ *		character as its code in the character ROM, from a table in flash
+ *		for configLCD_ROM. ASCII is written as it is, as by
+ *		vLCD_WRITE_STRING. Characters the ROM lacks are written as
+ *		configUTF8_REPLACEMENT.
+ *	when set to '0' the writer is not built.
+ */
+#ifndef configUSE_UTF8
+	#define configUSE_UTF8			0
+#endif
+
+/*! 
+ * Enables CGRAM glyphs for characters the ROM lacks, needs configUSE_UTF8
+ *	and configUSE_GLYPH_CACHE
+ *	when set to '1' the application maps code points to glyph IDs with
+ *		vLCD_UTF8_GLYPHS, and those characters are loaded through the
+ *		glyph cache when the ROM table has no code for them.
+ *	when set to '0' they are written as configUTF8_REPLACEMENT.
+ */
+#ifndef configUSE_UTF8_GLYPHS
+	#define configUSE_UTF8_GLYPHS	0
+#endif
+
+/*! Written for malformed UTF-8 and characters with no code or glyph */
+#ifndef configUTF8_REPLACEMENT
+	#define configUTF8_REPLACEMENT	'?'
+#endif
+
+#if configLCD_ROM != LCD_ROM_A00 && configLCD_ROM != LCD_ROM_A02
+	#error configLCD_ROM must be LCD_ROM_A00 or LCD_ROM_A02
+#endif
+
+#if configUSE_UTF8_GLYPHS == 1 && (configUSE_UTF8 == 0 || configUSE_GLYPH_CACHE == 0)
+	#error configUSE_UTF8_GLYPHS needs configUSE_UTF8 and configUSE_GLYPH_CACHE
+#endif
+
+/*! 
+ * Enables the marquee
+ *	when set to '1' xLCD_MARQUEE_START loads text of up to 40 characters
+ *		into a whole DDRAM line once and xLCD_MARQUEE_STEP scrolls it with
+ *		one display shift instruction. The shift moves both lines. Longer
+ *		text is scrolled by rewriting the visible cells each step.
+ *	when set to '0' the marquee is not built.
+ */
+#ifndef configUSE_MARQUEE
+	#define configUSE_MARQUEE		0
+#endif
+
+/*! 
+ * Enables page flipping
+ *	when set to '1' xLCD_PAGE_PREPARE writes the next page into the DDRAM
+ *		cells that are off screen and xLCD_PAGE_FLIP brings it into view
+ *		with display shifts while the display is blanked, so a whole
+ *		screen change never shows half drawn.
+ *	when set to '0' page flipping is not built.
+ */
+#ifndef configUSE_PAGE_FLIP
+	#define configUSE_PAGE_FLIP		0
+#endif
+
+/*! 
+ * Enables more than one display on the bus, needs configUSE_BUSY_FLAG
+ *	when set to '1' the displays share the data pins, RS and R/W and each
+ *		has its own E pin on LCP. The cursor, line lengths and tracked
+ *		controller state live in an LCD_Display_t per display and every
+ *		function works on the one picked with vLCD_SELECT. Writes made
+ *		between vLCD_MULTI_BEGIN and xLCD_MULTI_FLUSH are queued per
+ *		display, and the flush sends each display its next byte as soon
+ *		as its busy flag clears, so the bus is used while the others are
+ *		still executing. The xLCD_BROADCAST_ and vLCD_BROADCAST_ functions
+ *		strobe the E pins of several displays together, so content they
+ *		all show is sent once.
+ *	when set to '0' one display is driven on E pin LCD_E.
+ */
+#ifndef configUSE_MULTI_DISPLAY
+	#define configUSE_MULTI_DISPLAY	0
+#endif
+
+/*! Bytes queued per display, must be a power of two. Holds a whole screen */
+#ifndef configLCD_MULTI_QUEUE_LENGTH
+	#define configLCD_MULTI_QUEUE_LENGTH	64
+#endif
+
+#if (configLCD_MULTI_QUEUE_LENGTH & (configLCD_MULTI_QUEUE_LENGTH - 1)) != 0 || \
+	configLCD_MULTI_QUEUE_LENGTH > 256
+	#error configLCD_MULTI_QUEUE_LENGTH must be a power of two, at most 256
+#endif
+
+#if configUSE_MULTI_DISPLAY == 1 && configUSE_BUSY_FLAG == 0
+	#error configUSE_MULTI_DISPLAY needs configUSE_BUSY_FLAG
+#endif
+
+#if configUSE_MULTI_DISPLAY == 1 && (configUSE_TX_INTERRUPT == 1 || \
+	configUSE_LCD_GATEKEEPER == 1 || configUSE_SHADOW_BUFFER == 1 || \
+	configUSE_PEEPHOLE == 1 || configUSE_GLYPH_CACHE == 1 || \
+	configUSE_MARQUEE == 1 || configUSE_PAGE_FLIP == 1 || configUSE_LCD_TRACE == 1)
+	#error configUSE_MULTI_DISPLAY cannot be combined with options that keep single display state
+#endif
+
+/*! 
+ * Enables warm start detection, needs configUSE_BUSY_FLAG
+ *	when set to '1' vLCD_INITIALIZATION first checks whether the controller
+ *		kept its set up through the MCU reset, by reading back the address
+ *		counter after addressing a DDRAM cell that is never shown and the
+ *		signature byte the last initialization or clear left in it. When
+ *		both match, the power on wait, the 4-bit resync and the clear are
+ *		skipped, the display keeps what it showed and the shadow buffer
+ *		is read back from it. Otherwise the full sequence runs, without
+ *		the power on wait unless configLCD_POWER_ON_RESET() says the
+ *		controller may just have been powered.
+ *	when set to '0' every initialization is a full one.
+ */
+#ifndef configUSE_WARM_START
+	#define configUSE_WARM_START	0
+#endif
+
+/*! DDRAM cell of the signature, the last one of the bottom line */
+#ifndef configLCD_WARM_ADDRESS
+	#define configLCD_WARM_ADDRESS		(LCD_LINE1_DDRAMADDR + LCD_DDRAM_LINE_LENGTH - 1)
+#endif
+/*! Signature byte, never sent to a visible cell */
+#ifndef configLCD_WARM_SIGNATURE
+	#define configLCD_WARM_SIGNATURE	0xA5
+#endif
+
+/*! 
+ * True when the controller may have been powered up with the MCU, so it
+ *	must not be read before the 30ms power on wait. By default the power on
+ *	and brown out flags of MCUSR are tested, and once seen MCUSR is copied
+ *	to LCD_ResetCause before they are cleared, so later resets can skip the
+ *	wait. The application reads the reset cause from LCD_ResetCause after
+ *	vLCD_INITIALIZATION, or from MCUSR before it. Define both macros to use
+ *	a copy of MCUSR the application saved and cleared itself.
+ */
+#ifndef configLCD_POWER_ON_RESET
+	#define configLCD_POWER_ON_RESET()	(MCUSR & ((1 << PORF) | (1 << BORF)))
+	#define configLCD_POWER_ON_SEEN()	(LCD_ResetCause = MCUSR, \
+		MCUSR = MCUSR & (uint8_t)~((1 << PORF) | (1 << BORF)))
+#endif
+#ifndef configLCD_POWER_ON_SEEN
+	#define configLCD_POWER_ON_SEEN()
+#endif
+
+#if configUSE_WARM_START == 1 && configUSE_BUSY_FLAG == 0
+	#error configUSE_WARM_START needs configUSE_BUSY_FLAG
+#endif
+
+/*! 
+ * The marquee and page flip write and shift in the hidden cells, so the
+ *	signature cell and the shift are not what a warm check expects. The
+ *	warm check and the busy flag driven initialization read back one
+ *	controller, so on a shared bus they cannot verify every display, and
+ *	a broadcast initialization has to run the full sequence on all of them.
+ */
+#if configUSE_WARM_START == 1 && (configUSE_MARQUEE == 1 || \
+	configUSE_PAGE_FLIP == 1 || configUSE_MULTI_DISPLAY == 1)
+	#error configUSE_WARM_START cannot be combined with the marquee, page flip or several displays
+#endif
+
+/*! 
+ * Enables the DDRAM scrubber, needs configUSE_BUSY_FLAG
+ *	when set to '1' the library keeps a copy of what every DDRAM cell it
+ *		wrote should hold, and each xLCD_SCRUB_STEP reads the next
+ *		configLCD_SCRUB_CELLS of them back and rewrites the ones that
+ *		differ, so a display upset by interference is put right within
+ *		one pass without redrawing it. Call it from an idle slot.
+ *	when set to '0' the scrubber is not built. xLCD_READ_DDRAM is there
+ *		either way when the busy flag is used.
+ */
+#ifndef configUSE_SCRUB
+	#define configUSE_SCRUB			0
+#endif
+
+/*! 
+ * Cells read back by one xLCD_SCRUB_STEP, which bounds the bus time it
+ *	takes: about 50us a cell, 80us to address the first and put the address
+ *	counter back, and 45us for each cell rewritten. Four cells every 10ms
+ *	take about 3% of the bus and go over 2 x 24 cells in 120ms.
+ */
+#ifndef configLCD_SCRUB_CELLS
+	#define configLCD_SCRUB_CELLS	4
+#endif
+
+/*! Ticks without a request before the gatekeeper runs a scrub step */
+#ifndef configLCD_SCRUB_TICKS
+	#define configLCD_SCRUB_TICKS	10
+#endif
+
+#if configUSE_SCRUB == 1 && configUSE_BUSY_FLAG == 0
+	#error configUSE_SCRUB needs configUSE_BUSY_FLAG
+#endif
+
+/*! Broadcasts read no status and each display would need its own copy */
+#if configUSE_SCRUB == 1 && configUSE_MULTI_DISPLAY == 1
+	#error configUSE_SCRUB cannot be combined with several displays
+#endif
+
+/*! 
+ * Enables the frame paced update scheduler, needs configUSE_SHADOW_BUFFER
+ *	when set to '1' vLCD_FRAME_WRITE only puts text in the shadow buffer, so
+ *		any task can update a field as often as it likes and the newest text
+ *		of each cell wins. xLCD_FRAME_SEND sends what changed, at most
+ *		configLCD_FRAME_BUDGET_US of bus time of it, and the gatekeeper
+ *		calls it configLCD_FRAME_RATE_HZ times a second.
+ *	when set to '0' the scheduler is not built.
+ */
+#ifndef configUSE_FRAME_SCHEDULER
+	#define configUSE_FRAME_SCHEDULER	0
+#endif
+
+/*! Frames sent each second by the gatekeeper, 10 to 30 reads well */
+#ifndef configLCD_FRAME_RATE_HZ
+	#define configLCD_FRAME_RATE_HZ		20
+#endif
+
+/*! 
+ * Bus time one frame may take, counted with LCD_ADDRESS_COST_US and
+ *	LCD_DATA_COST_US. 2500us sends all 2 x 24 cells with the busy flag, so a
+ *	frame is only cut short without it; at 20 frames a second a full budget
+ *	every frame is 5% of the bus.
+ */
+#ifndef configLCD_FRAME_BUDGET_US
+	#define configLCD_FRAME_BUDGET_US	2500
+#endif
+
+#if configUSE_FRAME_SCHEDULER == 1 && configUSE_SHADOW_BUFFER == 0
+	#error configUSE_FRAME_SCHEDULER needs configUSE_SHADOW_BUFFER
+#endif
+
+/*! A frame always pays one address set, so a smaller budget never sends */
+#if configUSE_FRAME_SCHEDULER == 1 && \
+	configLCD_FRAME_BUDGET_US < LCD_ADDRESS_COST_US + LCD_DATA_COST_US
+	#error configLCD_FRAME_BUDGET_US is too small to send a single cell
+#endif
+
+/*! 
+ * Enables the field layouts
+ *	when set to '1' a screen can be described as a table of fields in flash,
+ *		each a label and a value of fixed width and alignment.
+ *		vLCD_LAYOUT_SHOW draws the labels once, and xLCD_FIELD_SET writes
+ *		only the value cells that differ from what the display holds.
+ *	when set to '0' the layouts are not built.
+ */
+#ifndef configUSE_LAYOUT
+	#define configUSE_LAYOUT			0
+#endif
+
+/*! The value compare needs one copy of what is on the display */
+#if configUSE_LAYOUT == 1 && configUSE_MULTI_DISPLAY == 1
+	#error configUSE_LAYOUT cannot be combined with several displays
+#endif
+
+/*! 
+ * Enables the per call instrumentation
+ *	when set to '1' each public function counts its calls and the CPU
+ *		cycles spent in it, timed with Timer 5, and the bytes, instructions,
+ *		delays and busy flag polls are counted. Read them with 
+ *		vLCD_GET_STATS. Timer 5 is left running at F_CPU/64, and the trace
+ *		recorder reads the same count, so the two can be built together;
+ *		the application must not use Timer 5 when either is built. Needs
+ *		the GCC cleanup attribute, which avr-gcc has.
+ *	when set to '0' the counting macros count nothing.
+ */
+#ifndef configUSE_LCD_STATS
+	#define configUSE_LCD_STATS		0
+#endif
+
+#if configUSE_LCD_STATS == 1 && !defined(__GNUC__)
+	#error configUSE_LCD_STATS needs the GCC cleanup attribute
+#endif
+
+/*! 
+ * Enables the bus trace recorder
+ *	when set to '1' every write passed to xWRITE_COMMAND_TO_LCD after
+ *		vLCD_TRACE_START is recorded in a RAM ring buffer with the time
+ *		since the one before, and the oldest records are dropped when it
+ *		is full. vLCD_TRACE_DUMP hands the records to the application to
+ *		store, sim/trace_replay.c plays them back on the host. Timer 5 and
+ *		its compare A interrupt keep the time, on the same count the
+ *		instrumentation reads.
+ *	when set to '0' nothing is recorded.
+ */
+#ifndef configUSE_LCD_TRACE
+	#define configUSE_LCD_TRACE		0
+#endif
+
+/*! Bytes of trace kept, must be a power of two. Most writes take two */
+#ifndef configLCD_TRACE_LENGTH
+	#define configLCD_TRACE_LENGTH	512
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*****************************/
+/*Library Return Definitions*/
+/*****************************/
+
+/*! Operation completed */
+#define LCD_OK				0
+/*! The controller did not clear its busy flag in time */
+#define LCD_ERROR_TIMEOUT	1
+/*! The glyph ID is not in the table, or every CGRAM slot is on the display */
+#define LCD_ERROR_NO_GLYPH	2
+/*! The frame budget ran out, the rest is sent by the next frame */
+#define LCD_ERROR_BUDGET	3
+/*! The field number is not in the layout on the display */
+#define LCD_ERROR_NO_FIELD	4
+
+/*! Flags for the number writers, combine with | */
+#define LCD_NUM_LEFT		0x01	// left align, pad with spaces after
+#define LCD_NUM_ZERO		0x02	// pad with zeros after the sign
+#define LCD_NUM_PLUS		0x04	// write '+' in front of positive values
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**********************************/
+/*Library Display Handle Variables*/
+/**********************************/
+
+#if configUSE_MULTI_DISPLAY == 1
+
+/*! One queued write of the multi display scheduler */
+typedef struct
+{
+	uint8_t RS;
+	uint8_t Data;
+} LCD_MultiEntry_t;
+
+/*! One display on the bus, set up with vLCD_DISPLAY_INIT */
+typedef struct LCD_Display
+{
+	uint8_t Enable;				// LCP pin wired to E of this display
+	uint8_t CursorX;			// CURSOR_X_POSITION
+	uint8_t CursorY;			// CURSOR_Y_POSITION
+	uint8_t LengthTop;			// Top_Length
+	uint8_t LengthBottom;		// BottomLength
+	uint8_t OnOff;				// OnOffStatus
+	uint8_t AddressCounter;		// LCD_AddressCounter
+	uint8_t EntryMode;			// LCD_EntryMode
+	uint8_t DisplayShift;		// LCD_DisplayShift
+	uint8_t DisplayControl;		// LCD_DisplayControl
+	LCD_MultiEntry_t Queue[configLCD_MULTI_QUEUE_LENGTH];
+	uint8_t Head;				// next free entry
+	uint8_t Tail;				// next entry to send
+	uint16_t Polls;				// busy reads since the last byte was sent
+	uint8_t Timeout;			// queue dropped since the last flush
+	struct LCD_Display *Next;	// next display the scheduler visits
+} LCD_Display_t;
+
+/*! Display on LCD_E, worked on until a display is set up */
+LCD_Display_t LCD_PrimaryDisplay =
+{
+	LCD_E, 0, 0, 0, 0, 0, LCD_ADDRESS_UNKNOWN,
+	(1 << LCD_ENTRY_MODE) | (INCREMENT_MODE << LCD_ENTRY_INC), 0,
+	(1 << LCD_ON_CTRL) | (1 << LCD_ON_DISPLAY) |
+		(configCURSOR_SHOW << LCD_ON_CURSOR) | (configCURSOR_BLINK << LCD_ON_BLINK),
+	{ { 0, 0 } }, 0, 0, 0, 0, 0
+};
+/*! Display every function works on, picked with vLCD_SELECT */
+LCD_Display_t *LCD_Active = &LCD_PrimaryDisplay;
+/*! First display set up, the rest follow through Next */
+LCD_Display_t *LCD_DisplayList = 0;
+/*! Set between vLCD_MULTI_BEGIN and xLCD_MULTI_FLUSH */
+uint8_t LCD_MultiQueued = 0;
+/*! E pins of every display set up, LCD_TARGET_ALL */
+uint8_t LCD_DisplayMask = 0;
+/*! E pins of the displays a broadcast call writes, 0 outside one */
+uint8_t LCD_Broadcast = 0;
+/*! E pins strobed together while a broadcast byte is on the bus */
+uint8_t LCD_BroadcastStrobe = 0;
+
+/*! Broadcast target of one display, combine with | */
+#define LCD_TARGET(display)	(1 << (display)->Enable)
+/*! Broadcast target of every display set up */
+#define LCD_TARGET_ALL		LCD_DisplayMask
+
+/*! The single display variables at the top of this file are not used */
+#define CURSOR_X_POSITION	(LCD_Active->CursorX)
+#define CURSOR_Y_POSITION	(LCD_Active->CursorY)
+#define Top_Length			(LCD_Active->LengthTop)
+#define BottomLength		(LCD_Active->LengthBottom)
+#define OnOffStatus			(LCD_Active->OnOff)
+#define LCD_AddressCounter	(LCD_Active->AddressCounter)
+#define LCD_EntryMode		(LCD_Active->EntryMode)
+#define LCD_DisplayShift	(LCD_Active->DisplayShift)
+#define LCD_DisplayControl	(LCD_Active->DisplayControl)
+
+/*! LCP pins of E for the display or broadcast targets being written */
+#define LCD_E_MASK			(LCD_BroadcastStrobe ? LCD_BroadcastStrobe : \
+	(1 << LCD_Active->Enable))
+
+#else
+
+#define LCD_E_MASK			(1 << LCD_E)
+
+#endif
+
+/*! LCP pins a bus cycle drives, the other pins of the port are left alone */
+#define LCD_CONTROL_MASK	((1 << LCD_RS) | (1 << LCD_RW) | LCD_E_MASK)
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**********************************/
+/*Library Shadow Buffer Variables*/
+/**********************************/
+
+#if configUSE_MULTI_DISPLAY == 0
+
+/*! Variable to track the controller's DDRAM address counter */
+uint8_t LCD_AddressCounter = LCD_ADDRESS_UNKNOWN;
+/*! Variable to track the entry mode instruction last sent to the LCD */
+uint8_t LCD_EntryMode = (1 << LCD_ENTRY_MODE) | (INCREMENT_MODE << LCD_ENTRY_INC);
+/*! Variable to track the display shift, DDRAM cell in the first column */
+uint8_t LCD_DisplayShift = 0;
+/*! Variable to track the display control instruction last sent to the LCD */
+uint8_t LCD_DisplayControl = (1 << LCD_ON_CTRL) | (1 << LCD_ON_DISPLAY) |
+	(configCURSOR_SHOW << LCD_ON_CURSOR) | (configCURSOR_BLINK << LCD_ON_BLINK);
+
+#endif
+
+/*! DDRAM cell showing in column x of a line, after any display shift */
+#if configUSE_MARQUEE == 1 || configUSE_PAGE_FLIP == 1
+	#define LCD_SHIFTED_CELL(x)	(((x) + LCD_DisplayShift) % LCD_DDRAM_LINE_LENGTH)
+#else
+	#define LCD_SHIFTED_CELL(x)	(x)
+#endif
+
+#if configUSE_BUSY_FLAG == 1
+
+/*! Set once the function set has run, the busy flag is not read before it */
+uint8_t LCD_BusyFlagReady = 0;
+
+#endif
+
+#if configUSE_WARM_START == 1
+
+/*! Set when the last vLCD_INITIALIZATION found the controller still set up */
+uint8_t LCD_WarmStarted = 0;
+/*! MCUSR as it was before configLCD_POWER_ON_SEEN() cleared PORF and BORF */
+uint8_t LCD_ResetCause = 0;
+
+#endif
+
+#if configUSE_TX_INTERRUPT == 1
+
+/*! One queued write, RS, the byte and the controller time it needs */
+typedef struct
+{
+	uint8_t RS;
+	uint8_t Data;
+	uint16_t Ticks;
+} LCD_TxEntry_t;
+
+/*! Bytes waiting for the transmit interrupt */
+LCD_TxEntry_t LCD_TxQueue[configTX_QUEUE_LENGTH];
+/*! Next free entry, only changed by the writers */
+volatile uint8_t LCD_TxHead = 0;
+/*! Next entry to send, only changed by the interrupt */
+volatile uint8_t LCD_TxTail = 0;
+/*! Set while Timer 3 is running */
+volatile uint8_t LCD_TxActive = 0;
+
+#endif
+
+#if configUSE_YIELD_WAIT == 1
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if INCLUDE_vTaskDelay != 1 || (INCLUDE_xTaskGetSchedulerState != 1 && configUSE_TIMERS != 1)
+	#error configUSE_YIELD_WAIT needs vTaskDelay and xTaskGetSchedulerState
+#endif
+
+/*! Microseconds between RTOS ticks */
+#define LCD_YIELD_TICK_US	(1000000UL / configTICK_RATE_HZ)
+
+#endif
+
+#if configUSE_LCD_GATEKEEPER == 1
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/*! Requests the gatekeeper task accepts */
+#define LCD_REQUEST_STRING		0	// write Text at the cursor
+#define LCD_REQUEST_WRITE		1	// write Text at X,Y
+#define LCD_REQUEST_POSITION	2	// move the cursor to X,Y
+#define LCD_REQUEST_CLEAR		3	// clear the display
+#define LCD_REQUEST_CLEAR_TOP	4	// clear the top line
+#define LCD_REQUEST_CLEAR_BOTTOM 5	// clear the bottom line
+#define LCD_REQUEST_COMMAND		6	// vWRITE_COMMAND_TO_LCD(X, Y)
+
+/*! Returned by the xLCD_REQUEST_ functions for text longer than a line */
+#define errLCD_TEXT_TOO_LONG	((BaseType_t)-2)
+
+/*! One request to the gatekeeper, the text is copied into the queue */
+typedef struct
+{
+	uint8_t Type;
+	uint8_t X;
+	uint8_t Y;
+	char Text[LCD_LINE_LENGTH + 1];
+} LCD_Request_t;
+
+/*! Counters kept by the gatekeeper for sizing the queue and priority */
+typedef struct
+{
+	uint32_t Requests;		// requests carried out
+	uint32_t Characters;	// characters that landed on a visible line
+	uint32_t QueueFull;		// requests refused because the queue was full
+	uint8_t HighWater;		// most requests ever waiting at once
+} LCD_GatekeeperStats_t;
+
+/*! Queue of requests for the gatekeeper task */
+QueueHandle_t LCD_GatekeeperQueue = NULL;
+/*! Gatekeeper counters, read with vLCD_GATEKEEPER_GET_STATS */
+LCD_GatekeeperStats_t LCD_GatekeeperStats;
+
+#if configUSE_FRAME_SCHEDULER == 1
+	/*! Ticks between the frames the gatekeeper sends, at least one */
+	#define LCD_FRAME_TICKS ((configTICK_RATE_HZ / configLCD_FRAME_RATE_HZ) ? \
+		(configTICK_RATE_HZ / configLCD_FRAME_RATE_HZ) : 1)
+#endif
+
+#endif
+
+#if configUSE_FRAME_SCHEDULER == 1
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#endif
+
+#if configUSE_PEEPHOLE == 1
+
+/*! Counters kept by the peephole stage */
+typedef struct
+{
+	uint16_t Instructions;	// instructions passed to xWRITE_COMMAND_TO_LCD
+	uint16_t Elided;		// dropped because they changed nothing
+	uint16_t Merged;		// set DDRAM addresses replaced before reaching the bus
+} LCD_PeepholeStats_t;
+
+/*! Last display control instruction sent, LCD_ADDRESS_UNKNOWN before the first */
+uint8_t LCD_PeepholeDisplay = LCD_ADDRESS_UNKNOWN;
+/*! Last entry mode instruction sent, LCD_ADDRESS_UNKNOWN before the first */
+uint8_t LCD_PeepholeEntry = LCD_ADDRESS_UNKNOWN;
+/*! Set DDRAM address instruction held back, LCD_ADDRESS_UNKNOWN when none */
+uint8_t LCD_PeepholePending = LCD_ADDRESS_UNKNOWN;
+/*! Peephole counters, read with vLCD_PEEPHOLE_GET_STATS */
+LCD_PeepholeStats_t LCD_PeepholeStats;
+
+#endif
+
+#if configUSE_SHADOW_BUFFER == 1
+
+/*! Characters the application wants on each line of the LCD */
+uint8_t LCD_ShadowBuffer[LCD_LINES][LCD_LINE_LENGTH];
+/*! Set when the shadow buffer has changed since the last flush */
+uint8_t LCD_ShadowDirty = 0;
+
+#endif
+
+#if configUSE_SHADOW_BUFFER == 1 || configUSE_GLYPH_CACHE == 1 || configUSE_SCRUB == 1 || \
+	configUSE_LAYOUT == 1
+
+/*! Cells kept per line, all of DDRAM when a display shift can show any */
+#if configUSE_MARQUEE == 1 || configUSE_PAGE_FLIP == 1
+	#define LCD_GLASS_LENGTH	LCD_DDRAM_LINE_LENGTH
+#else
+	#define LCD_GLASS_LENGTH	LCD_LINE_LENGTH
+#endif
+
+/*! Characters currently in the DDRAM cells of each line of the LCD */
+uint8_t LCD_GlassBuffer[LCD_LINES][LCD_GLASS_LENGTH];
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**********************************/
+/*Library Scatter Gather Variables*/
+/**********************************/
+
+/*! One field for xLCD_WRITE_SEGMENTS, Length bytes of Text written at X,Y */
+typedef struct
+{
+	uint8_t X;
+	uint8_t Y;
+	const char *Text;
+	uint8_t Length;
+} LCD_Segment_t;
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**************************/
+/*Library Layout Variables*/
+/**************************/
+
+#if configUSE_LAYOUT == 1
+
+/*! Alignments of a value within its field */
+#define LCD_ALIGN_LEFT		0
+#define LCD_ALIGN_RIGHT		1
+#define LCD_ALIGN_CENTER	2
+
+/*! One field of a layout, kept in flash with the rest of its table */
+typedef struct
+{
+	uint8_t X;				// column of the label, the value follows it
+	uint8_t Y;				// line
+	uint8_t LabelLength;	// characters of the label
+	uint8_t Width;			// cells the value is padded or cut to
+	uint8_t Align;			// LCD_ALIGN_LEFT, LCD_ALIGN_RIGHT or LCD_ALIGN_CENTER
+	const char *Label;		// label in flash, NULL for none
+} LCD_Field_t;
+
+/*! Field with a label, which must be a PROGMEM array for sizeof to count it */
+#define LCD_FIELD(x, y, label, width, align) \
+	{ (x), (y), sizeof(label) - 1, (width), (align), (label) }
+/*! Field with only a value */
+#define LCD_FIELD_VALUE(x, y, width, align) \
+	{ (x), (y), 0, (width), (align), NULL }
+
+/*! Field table of the layout on the display, in flash */
+const LCD_Field_t *LCD_Layout = NULL;
+/*! Fields in LCD_Layout, 0 before the first vLCD_LAYOUT_SHOW */
+uint8_t LCD_LayoutFields = 0;
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***********************************/
+/*Library Instrumentation Variables*/
+/***********************************/
+
+/*! Functions that are counted, the index into LCD_Stats_t Calls and Cycles */
+#define LCD_API_INITIALIZATION	0	// vLCD_INITIALIZATION
+#define LCD_API_WRITE_COMMAND	1	// x/vWRITE_COMMAND_TO_LCD
+#define LCD_API_WAIT_BUSY		2	// xLCD_WAIT_WHILE_BUSY
+#define LCD_API_WRITE_STRING	3	// vLCD_WRITE_STRING
+#define LCD_API_WRITE_CHAR		4	// xLCD_WRITE_CHAR
+#define LCD_API_CLEAR			5	// vLCD_CLEAR
+#define LCD_API_CLEAR_LINE		6	// vLCD_CLEAR_LINE, _TOP and _BOTTOM
+#define LCD_API_FILL_RANGE		7	// vLCD_FILL_RANGE and vLCD_CLEAR_RANGE
+#define LCD_API_ON_OFF			8	// vLCD_ON_OFF
+#define LCD_API_GO_TO_POSITION	9	// vLCD_GO_TO_POSITION
+#define LCD_API_HOME			10	// vLCD_HOME_LINE, _TOP_LINE and _BOTTOM_LINE
+#define LCD_API_SEGMENTS		11	// xLCD_WRITE_SEGMENTS
+#define LCD_API_NUMBER			12	// xLCD_WRITE_UNSIGNED, _SIGNED, _FIXED, _HEX
+#define LCD_API_FLUSH			13	// vLCD_FLUSH
+#define LCD_API_TX_FLUSH		14	// vLCD_TX_FLUSH
+#define LCD_API_PEEPHOLE_FLUSH	15	// xLCD_PEEPHOLE_FLUSH
+#define LCD_API_GLYPH			16	// xLCD_GLYPH_CODE and xLCD_WRITE_GLYPH
+#define LCD_API_BAR				17	// xLCD_BAR_SET and xLCD_SPARK_PUSH
+#define LCD_API_MARQUEE			18	// xLCD_MARQUEE_START, _STEP and _STOP
+#define LCD_API_PAGE_PREPARE	19	// xLCD_PAGE_PREPARE
+#define LCD_API_PAGE_FLIP		20	// xLCD_PAGE_FLIP
+#define LCD_API_MULTI_FLUSH		21	// xLCD_MULTI_FLUSH
+#define LCD_API_READ_DDRAM		22	// xLCD_READ_DDRAM
+#define LCD_API_SCRUB			23	// xLCD_SCRUB_STEP
+#define LCD_API_FRAME_WRITE		24	// vLCD_FRAME_WRITE
+#define LCD_API_FRAME_SEND		25	// xLCD_FRAME_SEND
+#define LCD_API_LAYOUT_SHOW		26	// vLCD_LAYOUT_SHOW
+#define LCD_API_FIELD_SET		27	// xLCD_FIELD_SET
+#define LCD_API_WRITE_UTF8		28	// xLCD_WRITE_UTF8
+#define LCD_API_PAGE_END		29	// xLCD_PAGE_END
+#define LCD_API_COUNT			30
+
+/*! Timer 5 runs at F_CPU/64 for the instrumentation and the trace */
+#define LCD_TIMER5_PRESCALE		64
+
+#if configUSE_LCD_STATS == 1
+
+/*! Counters kept by the instrumentation */
+typedef struct
+{
+	uint16_t Calls[LCD_API_COUNT];	// calls of each function, nested ones too
+	uint32_t Cycles[LCD_API_COUNT];	// CPU cycles in each function and its callees
+	uint32_t TotalCycles;			// CPU cycles in the library, outermost calls only
+	uint32_t Bytes;					// data bytes sent or queued
+	uint32_t Commands;				// instructions sent or queued
+	uint32_t DelayUs;				// microseconds spent in fixed delays
+	uint32_t BusyPolls;				// busy flag reads while waiting for the LCD
+	uint32_t BlockedCycles;			// cycles the caller was blocked, left out of Cycles
+} LCD_Stats_t;
+
+/*! Start of one counted call, kept on the caller's stack */
+typedef struct
+{
+	uint16_t Start;
+	uint8_t Api;
+	uint32_t Blocked;
+} LCD_StatsFrame_t;
+
+/*! Instrumentation counters, read with vLCD_GET_STATS */
+LCD_Stats_t LCD_Stats;
+/*! Number of counted calls currently running */
+uint8_t LCD_StatsDepth = 0;
+
+/*! 
+ * Counts a call of api and times it until the function returns, from
+ *	any return statement. It declares a frame that the GCC cleanup
+ *	attribute hands to prvLCD_STATS_EXIT as it goes out of scope, so it
+ *	must be the first thing in the function body, never the body of an
+ *	if or a loop.
+ */
+#define LCD_STATS_ENTER(api)	\
+	LCD_StatsFrame_t LCD_StatsFrame __attribute__((cleanup(prvLCD_STATS_EXIT))) = \
+		prvLCD_STATS_ENTER(api)
+/*! Adds n to one of the LCD_Stats_t totals */
+#define LCD_STATS_ADD(field, n)	do { LCD_Stats.field += (n); } while (0)
+
+#else
+
+/*! Still a declaration, so every call site builds the same either way */
+#define LCD_STATS_ENTER(api)	struct LCD_StatsOff
+#define LCD_STATS_ADD(field, n)	do { } while (0)
+
+#endif
+
+/*! Fixed delays, counted in LCD_Stats_t DelayUs */
+#define LCD_DELAY_US(us)	do { LCD_STATS_ADD(DelayUs, (us)); _delay_us(us); } while (0)
+#define LCD_DELAY_MS(ms)	do { LCD_STATS_ADD(DelayUs, (ms) * 1000UL); _delay_ms(ms); } while (0)
+
+/*! Waits that block the calling task when they are long, and spin otherwise */
+#if configUSE_YIELD_WAIT == 1
+	#define LCD_WAIT_US(us)		do { if ((us) < configLCD_YIELD_THRESHOLD_US || \
+		!prvLCD_YIELD(us)) { LCD_DELAY_US(us); } } while (0)
+#else
+	#define LCD_WAIT_US(us)		LCD_DELAY_US(us)
+#endif
+
+/*!
+ * Wait for a long instruction. With the busy flag it blocks when it can
+ *	and otherwise leaves the wait to the next poll. Queued writes are
+ *	paced by their own scheduler and never block here.
+ */
+#if configUSE_YIELD_WAIT == 1 && configUSE_TX_INTERRUPT == 0 && configUSE_MULTI_DISPLAY == 0
+	#define LCD_EXECUTION_WAIT_US(us)	do { if ((us) < configLCD_YIELD_THRESHOLD_US || \
+		!prvLCD_YIELD(us)) { LCD_EXECUTION_DELAY_US(us); } } while (0)
+#else
+	#define LCD_EXECUTION_WAIT_US(us)	LCD_EXECUTION_DELAY_US(us)
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library UTF-8 Variables*/
+/*************************/
+
+#if configUSE_UTF8 == 1
+
+/*! Code points First to Last are ROM codes Rom on, each followed by Mark if not 0 */
+typedef struct
+{
+	uint16_t First;
+	uint16_t Last;
+	uint8_t Rom;
+	uint8_t Mark;
+} LCD_Utf8Range_t;
+
+#endif
+
+#if configUSE_UTF8_GLYPHS == 1
+
+/*! One character drawn from the glyph table, kept in flash */
+typedef struct
+{
+	uint16_t CodePoint;
+	uint8_t Glyph;
+} LCD_Utf8Glyph_t;
+
+/*! Characters drawn from glyphs, in flash, set by vLCD_UTF8_GLYPHS */
+const LCD_Utf8Glyph_t *LCD_Utf8Glyphs = NULL;
+/*! Number of characters in LCD_Utf8Glyphs */
+uint8_t LCD_Utf8GlyphCount = 0;
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library Glyph Variables*/
+/*************************/
+
+/*! Number of CGRAM slots for 5x8 glyphs */
+#define LCD_GLYPH_SLOTS			8
+/*! Bytes of one glyph, one per row, the low five bits are the dots */
+#define LCD_GLYPH_ROWS			8
+/*! Slot holds no glyph from the table */
+#define LCD_GLYPH_NONE			0xFF
+
+#if configUSE_GLYPH_CACHE == 1
+
+/*! Counters kept by the glyph cache */
+typedef struct
+{
+	uint16_t Hits;		// glyphs already in CGRAM
+	uint16_t Loads;		// glyphs sent to CGRAM, nine writes each
+	uint16_t Refused;	// glyphs not loaded because every slot was on the display
+} LCD_GlyphStats_t;
+
+/*! Glyph patterns in flash, LCD_GLYPH_ROWS bytes each, set by vLCD_GLYPH_TABLE */
+const uint8_t *LCD_GlyphTable = 0;
+/*! Number of glyphs in LCD_GlyphTable */
+uint8_t LCD_GlyphCount = 0;
+/*! Glyph ID in each CGRAM slot, LCD_GLYPH_NONE when empty */
+uint8_t LCD_GlyphSlot[LCD_GLYPH_SLOTS] = { LCD_GLYPH_NONE, LCD_GLYPH_NONE,
+	LCD_GLYPH_NONE, LCD_GLYPH_NONE, LCD_GLYPH_NONE, LCD_GLYPH_NONE,
+	LCD_GLYPH_NONE, LCD_GLYPH_NONE };
+/*! CGRAM slots, most recently used first */
+uint8_t LCD_GlyphLru[LCD_GLYPH_SLOTS] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+/*! Glyph cache counters, read with vLCD_GLYPH_GET_STATS */
+LCD_GlyphStats_t LCD_GlyphStats;
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*****************************/
+/*Library Bar Graph Variables*/
+/*****************************/
+
+/*! Dot columns in one cell of a horizontal bar */
+#define LCD_BAR_COLUMNS			5
+/*! Levels of one sparkline cell above empty */
+#define LCD_SPARK_LEVELS		8
+/*! Glyph IDs of the built in bar glyphs, after any application table */
+#define LCD_GLYPH_BUILTIN		0xF0
+/*! Glyph with the left n dot columns lit, n is 1 to 4 */
+#define LCD_GLYPH_BAR(n)		(LCD_GLYPH_BUILTIN + (n) - 1)
+/*! Glyph with the bottom n rows lit, n is 1 to 7 */
+#define LCD_GLYPH_SPARK(n)		(LCD_GLYPH_BUILTIN + LCD_BAR_COLUMNS - 1 + (n) - 1)
+/*! Number of built in glyphs */
+#define LCD_GLYPH_BUILTIN_COUNT	(LCD_BAR_COLUMNS - 1 + LCD_SPARK_LEVELS - 1)
+/*! ROM character with every dot lit */
+#define LCD_FULL_BLOCK			0xFF
+/*! Level of a cell or bar that has to be drawn again */
+#define LCD_BAR_UNKNOWN			0xFF
+
+#if configUSE_BAR_GRAPH == 1
+
+/*! Horizontal bar, set up with vLCD_BAR_INIT */
+typedef struct
+{
+	uint8_t X;		// first cell
+	uint8_t Y;		// line
+	uint8_t Width;	// cells
+	uint8_t Level;	// dot columns shown, LCD_BAR_UNKNOWN before the first draw
+} LCD_Bar_t;
+
+/*! Scrolling sparkline, set up with vLCD_SPARK_INIT */
+typedef struct
+{
+	uint8_t X;		// first cell
+	uint8_t Y;		// line
+	uint8_t Width;	// cells, the newest sample is in the last
+	uint8_t Samples[LCD_LINE_LENGTH];	// level of each cell, 0 to 8
+	uint8_t Shown[LCD_LINE_LENGTH];		// level each cell shows
+} LCD_Spark_t;
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***************************/
+/*Library Marquee Variables*/
+/***************************/
+
+/*! Spaces between the end and the start of text scrolled by rewriting */
+#define LCD_MARQUEE_GAP			3
+
+#if configUSE_MARQUEE == 1
+
+/*! The running marquee */
+typedef struct
+{
+	const char *Text;	// text scrolled by rewriting, 0 when the display shifts
+	uint16_t Length;	// characters in Text
+	uint16_t Offset;	// character of Text in the first column
+	uint8_t Y;			// line
+	uint8_t Running;	// set between xLCD_MARQUEE_START and xLCD_MARQUEE_STOP
+} LCD_Marquee_t;
+
+/*! Marquee state, only one can run since the shift moves both lines */
+LCD_Marquee_t LCD_Marquee;
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*****************************/
+/*Library Page Flip Variables*/
+/*****************************/
+
+/*! Display shifts of one flip, the off screen cells of a line */
+#define LCD_PAGE_SHIFT			(LCD_DDRAM_LINE_LENGTH - LCD_LINE_LENGTH)
+/*! Cells of the next page that are on screen until the flip */
+#define LCD_PAGE_OVERLAP		(LCD_LINE_LENGTH - LCD_PAGE_SHIFT)
+
+#if configUSE_PAGE_FLIP == 1
+
+/*! First LCD_PAGE_OVERLAP characters of each line of the prepared page */
+char LCD_PageOverlap[LCD_LINES][LCD_PAGE_OVERLAP];
+/*! Set between xLCD_PAGE_PREPARE and xLCD_PAGE_FLIP */
+uint8_t LCD_PageReady = 0;
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library Frame Variables*/
+/*************************/
+
+#if configUSE_FRAME_SCHEDULER == 1
+
+/*! Counters kept by the frame scheduler for sizing the frame rate */
+typedef struct
+{
+	uint32_t Updates;	// vLCD_FRAME_WRITE calls
+	uint32_t Coalesced;	// updates over text no frame had sent yet, which is never shown
+	uint32_t Dropped;	// updates equal to what was already there, nothing to send
+	uint16_t Frames;	// xLCD_FRAME_SEND calls
+	uint16_t Deferred;	// frames the budget cut short
+} LCD_FrameStats_t;
+
+/*! Line the next frame starts on, where a cut short frame stopped */
+uint8_t LCD_FrameLine = 0;
+/*! Frame counters, read with vLCD_FRAME_GET_STATS */
+LCD_FrameStats_t LCD_FrameStats;
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library Scrub Variables*/
+/*************************/
+
+#if configUSE_SCRUB == 1
+
+/*! Counters kept by the scrubber */
+typedef struct
+{
+	uint32_t Checked;	// cells read back
+	uint16_t Repaired;	// cells that differed and were rewritten
+	uint16_t Passes;	// times every cell has been checked
+} LCD_ScrubStats_t;
+
+/*! Next cell to check, line times LCD_GLASS_LENGTH plus column */
+uint8_t LCD_ScrubNext = 0;
+/*! Scrub counters, read with vLCD_SCRUB_GET_STATS */
+LCD_ScrubStats_t LCD_ScrubStats;
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library Trace Variables*/
+/*************************/
+
+/*!
+ * Trace format, all values little endian. A dump is a header
+ *	'L' 'T' version, tick length in ns (2 bytes), records dropped before
+ *	the dump (2 bytes), length of the records that follow (2 bytes)
+ * and then the records. A record is one byte with RS in bit 7 and the 
+ * Timer 5 ticks since the previous record in bits 0-6, then the byte
+ * written. When the ticks are LCD_TRACE_ESCAPE or more, bits 0-6 hold 
+ * LCD_TRACE_ESCAPE and the ticks less LCD_TRACE_ESCAPE follow before the
+ * byte, seven bits at a time, low bits first, bit 7 set on all but the
+ * last. Dumps can be stored one after another.
+ */
+#define LCD_TRACE_VERSION		1
+#define LCD_TRACE_HEADER_LENGTH	9
+#define LCD_TRACE_RS			0x80
+#define LCD_TRACE_DELTA			0x7F
+#define LCD_TRACE_ESCAPE		0x7F
+/*! Longest record, header, five bytes of ticks and the byte written */
+#define LCD_TRACE_RECORD_MAX	7
+/*! Length of one Timer 5 tick in ns */
+#define LCD_TRACE_TICK_NS		(LCD_TIMER5_PRESCALE * 1000000UL / (F_CPU / 1000UL))
+
+/*! Function the application gives vLCD_TRACE_DUMP to store the trace */
+typedef void (*LCD_TraceWriter_t)(const uint8_t *data, uint16_t length);
+
+#if configUSE_LCD_TRACE == 1
+
+/*! Records waiting for vLCD_TRACE_DUMP */
+uint8_t LCD_TraceBuffer[configLCD_TRACE_LENGTH];
+/*! Next free byte of LCD_TraceBuffer */
+uint16_t LCD_TraceHead = 0;
+/*! First byte of the oldest record */
+uint16_t LCD_TraceTail = 0;
+/*! Records dropped to make room since the last dump */
+uint16_t LCD_TraceDropped = 0;
+/*! Time of the last record in Timer 5 ticks */
+uint32_t LCD_TraceLast = 0;
+/*! Timer 5 wraps, the upper half of the trace time */
+volatile uint16_t LCD_TraceWraps = 0;
+/*! Set between vLCD_TRACE_START and vLCD_TRACE_STOP */
+uint8_t LCD_TraceRunning = 0;
+
+#endif
 
 /*****************************************************************************/
 
@@ -189,10 +1469,18 @@ uint8_t OnOffStatus = 0;
 
 /*! Function to Initialize an LCD Display */
 void vLCD_INITIALIZATION(void);
+/*! Function to Initialize an LCD Display and report busy flag timeouts */
+uint8_t xLCD_INITIALIZATION(void);
 /*! Function to Write commands to an LCD */
 void vWRITE_COMMAND_TO_LCD(char RS, char data);
+/*! Function to Write commands to an LCD and report busy flag timeouts */
+uint8_t xWRITE_COMMAND_TO_LCD(char RS, char data);
+/*! Function to wait until the LCD clears its busy flag */
+uint8_t xLCD_WAIT_WHILE_BUSY(void);
 /*! Functions to write strings to an LCD */
 void vLCD_WRITE_STRING(char *str_ptr);
+/*! Function to write one character at the cursor */
+uint8_t xLCD_WRITE_CHAR(char character);
 /*! Toggles LCD Display on and off */
 void vLCD_ON_OFF(void);
 
@@ -209,6 +1497,8 @@ void vLCD_GO_TO_POSITION(uint8_t, uint8_t);
 void vLCD_HOME_TOP_LINE(void);
 /*! Function to go to home position on the top line of the LCD*/
 void vLCD_HOME_BOTTOM_LINE(void);
+/*! Function to go to home position on any line of the LCD */
+void vLCD_HOME_LINE(uint8_t);
 
 /*****************************************************************************/
 
@@ -233,6 +1523,320 @@ void vLCD_CLEAR(void);
 void vLCD_CLEAR_TOP(void);
 /*! Function to clear the bottom row of the display */
 void vLCD_CLEAR_BOTTOM(void);
+/*! Function to clear one row of the display */
+void vLCD_CLEAR_LINE(uint8_t);
+/*! Function to clear part of a row of the display */
+void vLCD_CLEAR_RANGE(uint8_t, uint8_t, uint8_t);
+/*! Function to fill part of a row of the display with one character */
+void vLCD_FILL_RANGE(uint8_t, uint8_t, uint8_t, char);
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/********************************************/
+/*Library Scatter Gather Function Prototypes*/
+/********************************************/
+
+/*! Function to write several fields in DDRAM address order */
+uint8_t xLCD_WRITE_SEGMENTS(LCD_Segment_t *segments, uint8_t count);
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/************************************/
+/*Library Layout Function Prototypes*/
+/************************************/
+
+#if configUSE_LAYOUT == 1
+
+/*! Function to clear the display and draw the labels of a layout */
+void vLCD_LAYOUT_SHOW(const LCD_Field_t *fields, uint8_t count);
+/*! Function to write the value of a field where it changed */
+uint8_t xLCD_FIELD_SET(uint8_t field, const char *text);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/************************************/
+/*Library Number Function Prototypes*/
+/************************************/
+
+/*! Function to write an unsigned integer */
+uint8_t xLCD_WRITE_UNSIGNED(uint32_t value, uint8_t width, uint8_t flags);
+/*! Function to write a signed integer */
+uint8_t xLCD_WRITE_SIGNED(int32_t value, uint8_t width, uint8_t flags);
+/*! Function to write a fixed point number */
+uint8_t xLCD_WRITE_FIXED(int32_t value, uint8_t decimals, uint8_t width, uint8_t flags);
+/*! Function to write a number in hexadecimal */
+uint8_t xLCD_WRITE_HEX(uint32_t value, uint8_t width, uint8_t flags);
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***********************************/
+/*Library UTF-8 Function Prototypes*/
+/***********************************/
+
+#if configUSE_UTF8 == 1
+
+/*! Function to write UTF-8 text as character ROM codes */
+uint8_t xLCD_WRITE_UTF8(const char *text);
+
+#endif
+
+#if configUSE_UTF8_GLYPHS == 1
+
+/*! Function to register the characters drawn from glyphs */
+void vLCD_UTF8_GLYPHS(const LCD_Utf8Glyph_t *map, uint8_t count);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**************************************/
+/*Library Peephole Function Prototypes*/
+/**************************************/
+
+#if configUSE_PEEPHOLE == 1
+
+/*! Function to send a held back set DDRAM address */
+uint8_t xLCD_PEEPHOLE_FLUSH(void);
+/*! Function to copy the peephole counters */
+void vLCD_PEEPHOLE_GET_STATS(LCD_PeepholeStats_t *stats);
+/*! Function to zero the peephole counters */
+void vLCD_PEEPHOLE_RESET_STATS(void);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***********************************/
+/*Library Glyph Function Prototypes*/
+/***********************************/
+
+#if configUSE_GLYPH_CACHE == 1
+
+/*! Function to register the glyph table */
+void vLCD_GLYPH_TABLE(const uint8_t *patterns, uint8_t count);
+/*! Function to load a glyph into CGRAM and get its character code */
+uint8_t xLCD_GLYPH_CODE(uint8_t id, char *code);
+/*! Function to write a glyph at the cursor */
+uint8_t xLCD_WRITE_GLYPH(uint8_t id);
+/*! Function to copy the glyph cache counters */
+void vLCD_GLYPH_GET_STATS(LCD_GlyphStats_t *stats);
+/*! Function to zero the glyph cache counters */
+void vLCD_GLYPH_RESET_STATS(void);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***************************************/
+/*Library Bar Graph Function Prototypes*/
+/***************************************/
+
+#if configUSE_BAR_GRAPH == 1
+
+/*! Function to place a horizontal bar */
+void vLCD_BAR_INIT(LCD_Bar_t *bar, uint8_t x, uint8_t y, uint8_t width);
+/*! Function to show value out of full on a horizontal bar */
+uint8_t xLCD_BAR_SET(LCD_Bar_t *bar, uint16_t value, uint16_t full);
+/*! Function to place an empty sparkline */
+void vLCD_SPARK_INIT(LCD_Spark_t *spark, uint8_t x, uint8_t y, uint8_t width);
+/*! Function to scroll a sparkline left and add value out of full */
+uint8_t xLCD_SPARK_PUSH(LCD_Spark_t *spark, uint16_t value, uint16_t full);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************************/
+/*Library Marquee Function Prototypes*/
+/*************************************/
+
+#if configUSE_MARQUEE == 1
+
+/*! Function to start scrolling text on a line */
+uint8_t xLCD_MARQUEE_START(uint8_t y, const char *text);
+/*! Function to scroll the marquee one character left */
+uint8_t xLCD_MARQUEE_STEP(void);
+/*! Function to stop the marquee and undo the display shift */
+uint8_t xLCD_MARQUEE_STOP(void);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***************************************/
+/*Library Page Flip Function Prototypes*/
+/***************************************/
+
+#if configUSE_PAGE_FLIP == 1
+
+/*! Function to write the next page off screen */
+uint8_t xLCD_PAGE_PREPARE(const char *top, const char *bottom);
+/*! Function to bring the prepared page into view */
+uint8_t xLCD_PAGE_FLIP(void);
+/*! Function to clear the display and undo the page shift */
+uint8_t xLCD_PAGE_END(void);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/********************************************/
+/*Library Display Handle Function Prototypes*/
+/********************************************/
+
+#if configUSE_MULTI_DISPLAY == 1
+
+/*! Function to set up a display handle for the display with E on pin enable */
+void vLCD_DISPLAY_INIT(LCD_Display_t *display, uint8_t enable);
+/*! Function to pick the display the other functions work on */
+void vLCD_SELECT(LCD_Display_t *display);
+/*! Function to queue writes per display until xLCD_MULTI_FLUSH */
+void vLCD_MULTI_BEGIN(void);
+/*! Function to send every queued write, interleaved across the displays */
+uint8_t xLCD_MULTI_FLUSH(void);
+/*! Function to write one instruction or data byte to several displays at once */
+uint8_t xLCD_BROADCAST_COMMAND(uint8_t targets, char RS, char data);
+/*! Function to clear several displays at once */
+void vLCD_BROADCAST_CLEAR(uint8_t targets);
+/*! Function to initialize several displays at once */
+void vLCD_BROADCAST_INITIALIZATION(uint8_t targets);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*********************************************/
+/*Library Instrumentation Function Prototypes*/
+/*********************************************/
+
+#if configUSE_LCD_STATS == 1
+
+/*! Function to copy the instrumentation counters */
+void vLCD_GET_STATS(LCD_Stats_t *stats);
+/*! Function to zero the instrumentation counters */
+void vLCD_RESET_STATS(void);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/***********************************/
+/*Library Trace Function Prototypes*/
+/***********************************/
+
+#if configUSE_LCD_TRACE == 1
+
+/*! Function to empty the trace and start recording */
+void vLCD_TRACE_START(void);
+/*! Function to stop recording, the records are kept */
+void vLCD_TRACE_STOP(void);
+/*! Function to pass the recorded trace to the application and empty it */
+void vLCD_TRACE_DUMP(LCD_TraceWriter_t writer);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*******************************************/
+/*Library Shadow Buffer Function Prototypes*/
+/*******************************************/
+
+/*! Function to send the changed shadow buffer cells to the display */
+void vLCD_FLUSH(void);
+
+#if configUSE_FRAME_SCHEDULER == 1
+
+/*! Function to put text in the next frame, returns at once */
+void vLCD_FRAME_WRITE(uint8_t x, uint8_t y, const char *text);
+/*! Function to send one frame of changes within the bus time budget */
+uint8_t xLCD_FRAME_SEND(void);
+/*! Function to copy the frame counters */
+void vLCD_FRAME_GET_STATS(LCD_FrameStats_t *stats);
+/*! Function to zero the frame counters */
+void vLCD_FRAME_RESET_STATS(void);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/****************************************/
+/*Library DDRAM Read Function Prototypes*/
+/****************************************/
+
+#if configUSE_BUSY_FLAG == 1 && configUSE_MULTI_DISPLAY == 0
+
+/*! Function to read characters back from one line of DDRAM */
+uint8_t xLCD_READ_DDRAM(uint8_t x, uint8_t y, uint8_t length, char *buffer);
+
+#endif
+
+#if configUSE_SCRUB == 1
+
+/*! Function to check the next few cells and rewrite the wrong ones */
+uint8_t xLCD_SCRUB_STEP(void);
+/*! Function to copy the scrub counters */
+void vLCD_SCRUB_GET_STATS(LCD_ScrubStats_t *stats);
+/*! Function to zero the scrub counters */
+void vLCD_SCRUB_RESET_STATS(void);
+
+#endif
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*****************************************/
+/*Library Transmit Queue Function Prototypes*/
+/*****************************************/
+
+/*! Function to check if every queued byte has reached the display */
+uint8_t xLCD_TX_IDLE(void);
+/*! Function to wait until every queued byte has reached the display */
+void vLCD_TX_FLUSH(void);
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*****************************************/
+/*Library Gatekeeper Function Prototypes*/
+/*****************************************/
+
+#if configUSE_LCD_GATEKEEPER == 1
+
+/*! Function to create the gatekeeper task and its queue */
+BaseType_t xLCD_GATEKEEPER_START(void);
+/*! Function to ask the gatekeeper to write a string at the cursor */
+BaseType_t xLCD_REQUEST_STRING(const char *str_ptr, TickType_t xTicksToWait);
+/*! Function to ask the gatekeeper to write a string at a position */
+BaseType_t xLCD_REQUEST_WRITE(uint8_t x, uint8_t y, const char *str_ptr, 
+	TickType_t xTicksToWait);
+/*! Function to ask the gatekeeper to move the cursor */
+BaseType_t xLCD_REQUEST_POSITION(uint8_t x, uint8_t y, TickType_t xTicksToWait);
+/*! Function to ask the gatekeeper to clear the display, top or bottom line */
+BaseType_t xLCD_REQUEST_CLEAR(uint8_t type, TickType_t xTicksToWait);
+/*! Function to ask the gatekeeper to send a raw command */
+BaseType_t xLCD_REQUEST_COMMAND(char RS, char data, TickType_t xTicksToWait);
+/*! Function to copy the gatekeeper counters */
+void vLCD_GATEKEEPER_GET_STATS(LCD_GatekeeperStats_t *stats);
+/*! Function to zero the gatekeeper counters */
+void vLCD_GATEKEEPER_RESET_STATS(void);
+
+#endif
 
 /*****************************************************************************/
  
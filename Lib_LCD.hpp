@@ -0,0 +1,700 @@
+/*!****************************************************************************
+ *
+ * \file Lib_LCD.hpp
+ *
+ * \brief Header only C++ front end for the LCD library
+ *
+ * \author
+ *
+ * \details LCD::Driver is a class template specialized at compile time on
+ *			the ports, control pins, bus width, geometry and options of one
+ *			display. Instructions are encoded by constexpr functions, so a
+ *			call such as GoTo<3, 1>() compiles to one constant byte, and
+ *			the bus cycle is inlined. RS, R/W and E are changed with a read,
+ *			modify and write of the control port as in Lib_LCD.c, or with
+ *			stores of constants when the port policy is dedicated to the
+ *			display. Nothing needs linking: the members are static and the
+ *			state is one pair of cursor variables per specialization. The
+ *			code size on the AVR has not been measured against Lib_LCD.c.
+ *
+ *			Use it instead of Lib_LCD.c, not beside it. Define
+ *			LCD_CPP_C_API as a Driver type before including this file in
+ *			one C++ source file to get the core functions of the C API
+ *			(vLCD_INITIALIZATION, xWRITE_COMMAND_TO_LCD, vLCD_WRITE_STRING,
+ *			vLCD_CLEAR, vLCD_GO_TO_POSITION and the home functions) as thin
+ *			extern "C" wrappers, so C code keeps calling the same names.
+ *
+ * Modification History:
+ * 10/18/2026 - Leave the other control port pins alone unless it is dedicated
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef Lib_LCD_HPP
+#define Lib_LCD_HPP
+
+#include <stdint.h>
+#include <avr/io.h>
+#include <util/delay.h>
+
+namespace LCD
+{
+
+/*****************************************************************************/
+/**************************/
+/*Library Policy Templates*/
+/**************************/
+
+/*!
+ * Defines a port policy named name for an output, direction and input
+ *	register, for example LCD_PORT_POLICY(PortA, PORTA, DDRA, PINA). The
+ *	accessors inline to the register itself. Used as the control port,
+ *	only RS, R/W and E are changed with a read, modify and write, so the
+ *	other pins keep their outputs and pull-ups.
+ */
+#define LCD_PORT_POLICY(name, port, ddr, pin)						\
+	struct name														\
+	{																\
+		static constexpr bool Dedicated = false;					\
+		static inline volatile uint8_t &Out(void) { return port; }	\
+		static inline volatile uint8_t &Dir(void) { return ddr; }	\
+		static inline volatile uint8_t &In(void) { return pin; }	\
+	}
+
+/*!
+ * Defines a port policy like LCD_PORT_POLICY for a port given over to
+ *	the display. Used as the control port, it is written with stores of
+ *	constants, which also drive every pin other than RS, R/W and E low,
+ *	so only use it when nothing else is on that port.
+ */
+#define LCD_DEDICATED_PORT_POLICY(name, port, ddr, pin)				\
+	struct name														\
+	{																\
+		static constexpr bool Dedicated = true;						\
+		static inline volatile uint8_t &Out(void) { return port; }	\
+		static inline volatile uint8_t &Dir(void) { return ddr; }	\
+		static inline volatile uint8_t &In(void) { return pin; }	\
+	}
+
+/*! Ports of the lab board, data on PORTK and control on PORTJ */
+LCD_PORT_POLICY(PortK, PORTK, DDRK, PINK);
+LCD_PORT_POLICY(PortJ, PORTJ, DDRJ, PINJ);
+
+/*! Control pin policy, pin numbers of RS, R/W and E on the control port */
+template <uint8_t RsPin, uint8_t RwPin, uint8_t EPin>
+struct Control
+{
+	static constexpr uint8_t Rs = 1 << RsPin;
+	static constexpr uint8_t Rw = 1 << RwPin;
+	static constexpr uint8_t E = 1 << EPin;
+};
+
+/*! Bus policy, D0-D7 on pins 0-7 of the data port */
+struct Bus8
+{
+	static constexpr bool FourBit = false;
+	static constexpr uint8_t Mask = 0xFF;
+	static constexpr uint8_t Shift = 0;
+};
+
+/*! Bus policy, D4-D7 on pins FirstPin to FirstPin + 3 of the data port */
+template <uint8_t FirstPin = 4>
+struct Bus4
+{
+	static_assert(FirstPin <= 4, "D4-D7 must fit on the data port");
+
+	static constexpr bool FourBit = true;
+	static constexpr uint8_t Mask = 0x0F << FirstPin;
+	static constexpr uint8_t Shift = FirstPin;
+};
+
+/*! Geometry policy, visible lines and characters per line */
+template <uint8_t LinesN, uint8_t ColumnsN>
+struct Geometry
+{
+	static_assert(LinesN == 1 || LinesN == 2, "the KS0066U drives one or two lines");
+	static_assert(ColumnsN >= 1 && ColumnsN <= 40, "a DDRAM line holds 40 characters");
+
+	static constexpr uint8_t Lines = LinesN;
+	static constexpr uint8_t Columns = ColumnsN;
+
+	/*! DDRAM address of column x on line y */
+	static constexpr uint8_t Address(uint8_t x, uint8_t y)
+	{
+		return (y ? 0x40 : 0x00) + x;
+	}
+};
+
+/*!
+ * Options policy
+ *	CursorShow and CursorBlink as configCURSOR_SHOW and configCURSOR_BLINK.
+ *	BusyFlag as configUSE_BUSY_FLAG, TimeoutPolls as configBUSY_TIMEOUT_POLLS.
+ *	TallFont selects the 5x10 font, one line displays only.
+ */
+template <bool CursorShow = true, bool CursorBlink = true, bool BusyFlag = true,
+	uint16_t TimeoutPolls = 1000, bool TallFont = false>
+struct Options
+{
+	static constexpr bool Cursor = CursorShow;
+	static constexpr bool Blink = CursorBlink;
+	static constexpr bool Busy = BusyFlag;
+	static constexpr uint16_t Polls = TimeoutPolls;
+	static constexpr bool Tall = TallFont;
+};
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/******************************/
+/*Library Instruction Encoding*/
+/******************************/
+
+/*! KS0066U instructions, each a constant when its arguments are */
+namespace Instruction
+{
+	constexpr uint8_t Clear(void) { return 0x01; }
+	constexpr uint8_t Home(void) { return 0x02; }
+	constexpr uint8_t EntryMode(bool increment, bool shift)
+	{
+		return 0x04 | (increment ? 0x02 : 0) | (shift ? 0x01 : 0);
+	}
+	constexpr uint8_t DisplayControl(bool on, bool cursor, bool blink)
+	{
+		return 0x08 | (on ? 0x04 : 0) | (cursor ? 0x02 : 0) | (blink ? 0x01 : 0);
+	}
+	constexpr uint8_t Shift(bool display, bool right)
+	{
+		return 0x10 | (display ? 0x08 : 0) | (right ? 0x04 : 0);
+	}
+	constexpr uint8_t FunctionSet(bool eightBit, bool twoLines, bool tallFont)
+	{
+		return 0x20 | (eightBit ? 0x10 : 0) | (twoLines ? 0x08 : 0) | (tallFont ? 0x04 : 0);
+	}
+	constexpr uint8_t SetCgram(uint8_t address) { return 0x40 | (address & 0x3F); }
+	constexpr uint8_t SetDdram(uint8_t address) { return 0x80 | (address & 0x7F); }
+}
+
+/*! Returned by the write functions, the same values as LCD_OK and LCD_ERROR_TIMEOUT */
+enum Result : uint8_t
+{
+	Ok = 0,
+	Timeout = 1
+};
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*************************/
+/*Library Driver Template*/
+/*************************/
+
+/*! One display, every member is static */
+template <class DataPort = PortK, class ControlPort = PortJ,
+	class Pins = Control<0, 1, 2>, class Bus = Bus8,
+	class Geo = Geometry<2, 24>, class Opt = Options<> >
+class Driver
+{
+public:
+	/*! Function set, display control and entry mode this specialization sends */
+	static constexpr uint8_t FunctionSet =
+		Instruction::FunctionSet(!Bus::FourBit, Geo::Lines == 2, Opt::Tall);
+	static constexpr uint8_t DisplayOn =
+		Instruction::DisplayControl(true, Opt::Cursor, Opt::Blink);
+	static constexpr uint8_t Entry = Instruction::EntryMode(true, false);
+
+	/*! Function to initialize the display */
+	static void Init(void);
+	/*! Function to write one instruction */
+	static Result Command(uint8_t instruction);
+	/*! Function to write one character at the cursor */
+	static Result Write(char character);
+	/*! Function to write a string at the cursor, wrapping to the next line */
+	static void WriteString(const char *text);
+	/*! Function to clear the display and home the cursor */
+	static void Clear(void);
+	/*! Function to move the cursor */
+	static void GoTo(uint8_t x, uint8_t y);
+	/*! Function to move the cursor to a position known at compile time */
+	template <uint8_t X, uint8_t Y>
+	static void GoTo(void)
+	{
+		static_assert(X < Geo::Columns && Y < Geo::Lines, "position is off the display");
+
+		if (Command(Instruction::SetDdram(Geo::Address(X, Y))) == Ok)
+		{
+			CursorX = X;
+			CursorY = Y;
+		}
+	}
+	/*! Function to wait until the display is ready for the next write */
+	static Result WaitWhileBusy(void);
+
+	/*! Cursor position, followed on every write */
+	static uint8_t CursorX;
+	static uint8_t CursorY;
+
+private:
+	static void SetControl(uint8_t control);
+	static void Strobe(bool rs, uint8_t value);
+	static void StrobeNibble(uint8_t control, uint8_t nibble);
+	static uint8_t ReadStatus(void);
+	static Result Send(bool rs, uint8_t value);
+};
+
+template <class DataPort, class ControlPort, class Pins, class Bus, class Geo, class Opt>
+uint8_t Driver<DataPort, ControlPort, Pins, Bus, Geo, Opt>::CursorX = 0;
+template <class DataPort, class ControlPort, class Pins, class Bus, class Geo, class Opt>
+uint8_t Driver<DataPort, ControlPort, Pins, Bus, Geo, Opt>::CursorY = 0;
+
+/*! Shorter member definitions */
+#define LCD_DRIVER_TEMPLATE	\
+	template <class DataPort, class ControlPort, class Pins, class Bus, class Geo, class Opt>
+#define LCD_DRIVER			Driver<DataPort, ControlPort, Pins, Bus, Geo, Opt>
+
+/*!****************************************************************************
+ *
+ * \fn Driver::SetControl(uint8_t control)
+ *
+ * \brief Function to put RS, R/W and E on the control port
+ *
+ * \details control holds the pins to drive high. The other pins of the
+ *			port are read and written back as they were, unless the port
+ *			policy is dedicated, when control is stored as it is.
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+inline __attribute__((always_inline)) void LCD_DRIVER::SetControl(uint8_t control)
+{
+	if (ControlPort::Dedicated)
+	{
+		ControlPort::Out() = control;
+	}
+	else
+	{
+		ControlPort::Out() = (ControlPort::Out() &
+			(uint8_t)~(Pins::Rs | Pins::Rw | Pins::E)) | control;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::StrobeNibble(uint8_t control, uint8_t nibble)
+ *
+ * \brief Function to strobe the low four bits of nibble into D4-D7
+ *
+ * \details control is RS as it goes on the control port.
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Change only RS, R/W and E on a shared control port
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+inline __attribute__((always_inline)) void LCD_DRIVER::StrobeNibble(uint8_t control, uint8_t nibble)
+{
+	SetControl(control);
+	DataPort::Out() = (DataPort::Out() & (uint8_t)~Bus::Mask) |
+		((uint8_t)(nibble << Bus::Shift) & Bus::Mask);
+	SetControl(control | Pins::E);
+	/*! E pulse must be wider than 230ns */
+	_delay_us(0.25);
+	/*! Data is latched on the falling edge of E */
+	SetControl(control);
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::Strobe(bool rs, uint8_t value)
+ *
+ * \brief Function to strobe one byte into the display
+ *
+ * \details Inlined into every caller, where rs is a constant, so the bus
+ *			cycle is a few changes of the control pins and the data byte,
+ *			stores of constants with a dedicated control port.
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Change only RS, R/W and E on a shared control port
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+inline __attribute__((always_inline)) void LCD_DRIVER::Strobe(bool rs, uint8_t value)
+{
+	const uint8_t Rs = rs ? Pins::Rs : 0;
+
+	if (Bus::FourBit)
+	{
+		/*! The E pulses and port writes around them cover the 500ns cycle */
+		StrobeNibble(Rs, value >> 4);
+		StrobeNibble(Rs, value);
+	}
+	else
+	{
+		SetControl(Rs);
+		DataPort::Out() = value;
+		SetControl(Rs | Pins::E);
+		/*! E pulse must be wider than 230ns */
+		_delay_us(0.25);
+		/*! Data is latched on the falling edge of E */
+		SetControl(Rs);
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::ReadStatus(void)
+ *
+ * \brief Function to read the busy flag and address counter
+ *
+ * \returns Busy flag in bit 7, address counter in the lower bits
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Change only RS, R/W and E on a shared control port
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+inline uint8_t LCD_DRIVER::ReadStatus(void)
+{
+	uint8_t Status;
+
+	/*! Release the data bus, no pull-ups */
+	DataPort::Dir() = DataPort::Dir() & (uint8_t)~Bus::Mask;
+	DataPort::Out() = DataPort::Out() & (uint8_t)~Bus::Mask;
+
+	SetControl(Pins::Rw);
+	SetControl(Pins::Rw | Pins::E);
+	/*! Data is valid 360ns after E rises */
+	_delay_us(0.375);
+	Status = DataPort::In();
+	SetControl(Pins::Rw);
+
+	if (Bus::FourBit)
+	{
+		Status = (uint8_t)(Status << (4 - Bus::Shift)) & 0xF0;
+		/*! E cycle time must be more than 500ns */
+		_delay_us(0.25);
+		SetControl(Pins::Rw | Pins::E);
+		_delay_us(0.375);
+		Status = Status | ((DataPort::In() & Bus::Mask) >> Bus::Shift);
+		SetControl(Pins::Rw);
+	}
+
+	/*! Take the data bus back for writing */
+	SetControl(0);
+	DataPort::Dir() = DataPort::Dir() | Bus::Mask;
+
+	return Status;
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::WaitWhileBusy(void)
+ *
+ * \brief Function to wait until the display is ready for the next write
+ *
+ * \details Polls the busy flag, or returns straight away when the options
+ *			use fixed delays instead.
+ *
+ * \returns Ok, or Timeout if the busy flag never cleared
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+Result LCD_DRIVER::WaitWhileBusy(void)
+{
+	if (Opt::Busy)
+	{
+		uint16_t Polls = Opt::Polls;
+
+		while (ReadStatus() & 0x80)
+		{
+			if (--Polls == 0) return Timeout;
+			/*! E cycle time must be more than 500ns */
+			_delay_us(1);
+		}
+	}
+
+	return Ok;
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::Send(bool rs, uint8_t value)
+ *
+ * \brief Function to wait for the display and strobe one byte in
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+inline Result LCD_DRIVER::Send(bool rs, uint8_t value)
+{
+	if (Opt::Busy)
+	{
+		if (WaitWhileBusy() != Ok) return Timeout;
+		Strobe(rs, value);
+	}
+	else
+	{
+		/*! Delay for more than 39us, the longest execution time after data */
+		Strobe(rs, value);
+		_delay_us(43);
+	}
+
+	return Ok;
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::Command(uint8_t instruction)
+ *
+ * \brief Function to write one instruction
+ *
+ * \details Use the Instruction functions to build it. Clear and return
+ *			home are waited out here when the busy flag is not read.
+ *
+ * \returns Ok, or Timeout if the display stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+Result LCD_DRIVER::Command(uint8_t instruction)
+{
+	Result Sent = Send(false, instruction);
+
+	if (!Opt::Busy && (instruction < Instruction::EntryMode(false, false)))
+	{
+		/*! Clear and return home take 1.53ms */
+		_delay_us(1530);
+	}
+
+	return Sent;
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::Write(char character)
+ *
+ * \brief Function to write one character at the cursor
+ *
+ * \returns Ok, or Timeout if the display stayed busy
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+Result LCD_DRIVER::Write(char character)
+{
+	if (Send(true, (uint8_t)character) != Ok) return Timeout;
+
+	CursorX++;
+	return Ok;
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::WriteString(const char *text)
+ *
+ * \brief Function to write a string at the cursor, wrapping to the next line
+ *
+ * \details Characters past the end of the last line are dropped, as with
+ *			vLCD_WRITE_STRING.
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+void LCD_DRIVER::WriteString(const char *text)
+{
+	while (*text != '\0')
+	{
+		if (CursorX >= Geo::Columns)
+		{
+			if (CursorY + 1 >= Geo::Lines) return;
+			GoTo(0, CursorY + 1);
+		}
+
+		if (Write(*text++) != Ok) return;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::Clear(void)
+ *
+ * \brief Function to clear the display and home the cursor
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+void LCD_DRIVER::Clear(void)
+{
+	(void)Command(Instruction::Clear());
+	CursorX = 0;
+	CursorY = 0;
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::GoTo(uint8_t x, uint8_t y)
+ *
+ * \brief Function to move the cursor with a set DDRAM address
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+void LCD_DRIVER::GoTo(uint8_t x, uint8_t y)
+{
+	if (Command(Instruction::SetDdram(Geo::Address(x, y))) == Ok)
+	{
+		CursorX = x;
+		CursorY = y;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn Driver::Init(void)
+ *
+ * \brief Function to initialize the display
+ *
+ * \details The sequence of vLCD_INITIALIZATION, from the flowcharts on
+ *			pages 26 and 27 of the KS0066U datasheet, with every instruction
+ *			a constant of this specialization.
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Original Function
+ * 10/18/2026 - Change only RS, R/W and E on a shared control port
+ *
+ ******************************************************************************
+ */
+LCD_DRIVER_TEMPLATE
+void LCD_DRIVER::Init(void)
+{
+	DataPort::Dir() = DataPort::Dir() | Bus::Mask;
+	ControlPort::Dir() = ControlPort::Dir() | Pins::Rs | Pins::Rw | Pins::E;
+	SetControl(0);
+
+	/*! Delay more than 30ms after powering up */
+	_delay_ms(35);
+
+	if (Bus::FourBit)
+	{
+		/*! Three 8-bit function sets put it in 8-bit mode from any state */
+		StrobeNibble(0, 0x03);
+		_delay_us(4100);
+		StrobeNibble(0, 0x03);
+		_delay_us(100);
+		StrobeNibble(0, 0x03);
+		_delay_us(50);
+		StrobeNibble(0, FunctionSet >> 4);
+		_delay_us(50);
+	}
+
+	/*! The busy flag cannot be checked before the first function set */
+	Strobe(false, FunctionSet);
+	_delay_us(50);
+
+	(void)Command(DisplayOn);
+	(void)Command(Instruction::Clear());
+	(void)Command(Entry);
+
+	CursorX = 0;
+	CursorY = 0;
+}
+
+#undef LCD_DRIVER_TEMPLATE
+#undef LCD_DRIVER
+
+/*! The lab board, as Lib_LCD.h configures it by default */
+typedef Driver<> LabDriver;
+
+/*****************************************************************************/
+
+}
+
+#endif
+
+/*! Outside the include guard, so the wrappers can follow the driver type */
+#if defined(LCD_CPP_C_API) && !defined(Lib_LCD_HPP_C_API)
+#define Lib_LCD_HPP_C_API
+
+/*****************************************************************************/
+/************************/
+/*Library C API Wrappers*/
+/************************/
+
+/*! The C names, each an inlined call of the LCD_CPP_C_API driver */
+extern "C"
+{
+
+void vLCD_INITIALIZATION(void) { LCD_CPP_C_API::Init(); }
+
+uint8_t xWRITE_COMMAND_TO_LCD(char RS, char data)
+{
+	if (RS) return LCD_CPP_C_API::Write(data);
+	return LCD_CPP_C_API::Command((uint8_t)data);
+}
+
+void vWRITE_COMMAND_TO_LCD(char RS, char data) { (void)xWRITE_COMMAND_TO_LCD(RS, data); }
+
+uint8_t xLCD_WAIT_WHILE_BUSY(void) { return LCD_CPP_C_API::WaitWhileBusy(); }
+
+uint8_t xLCD_WRITE_CHAR(char character) { return LCD_CPP_C_API::Write(character); }
+
+void vLCD_WRITE_STRING(char *str_ptr) { LCD_CPP_C_API::WriteString(str_ptr); }
+
+void vLCD_CLEAR(void) { LCD_CPP_C_API::Clear(); }
+
+void vLCD_GO_TO_POSITION(uint8_t x, uint8_t y) { LCD_CPP_C_API::GoTo(x, y); }
+
+void vLCD_HOME_LINE(uint8_t y) { LCD_CPP_C_API::GoTo(0, y); }
+
+void vLCD_HOME_TOP_LINE(void) { LCD_CPP_C_API::GoTo<0, 0>(); }
+
+void vLCD_HOME_BOTTOM_LINE(void) { LCD_CPP_C_API::GoTo<0, 1>(); }
+
+}
+
+/*****************************************************************************/
+
+#endif
@@ -79,12 +79,16 @@
 	to 1.
 	
 	\subsection bitmode 4-bit/8-bit Mode
-	\warning 4-bit mode is non-operational! Enabling it may yield unexpected results!
-	
 	The BITMODE definition is used to define if the display is to be used
 	in 8-bit mode or 4-bit mode. A define of "BITMODE8" will set the display
 	to use 8-bit mode, where a define of "BITMODE4" will set the display to
-	use 4-bit mode.
+	use 4-bit mode. In 4-bit mode only LCD pins D4-D7 are wired, to port pins
+	4-7 of LDP, and port pins 0-3 are left alone by the library. Each byte is
+	sent as two back-to-back nibbles, and each busy flag poll takes two read
+	cycles. On the simulator with the busy flag a byte costs the caller 4.1us
+	in 8-bit mode and 8.5us in 4-bit mode, and 24 characters take 1199.0us
+	and 1361.5us until the controller is idle again, 14% longer in 4-bit
+	mode. With fixed delays they take 2543.8us and 2593.8us.
 	
 	\subsection Cursor Cursor Blink and Show
 	The configuration of the display can be changed so that the cursor is shown,
@@ -103,8 +107,418 @@
 	"FONT_TYPE" is set to 0, the 5x8 dot format is used. When "FONT_TYPE" is set
 	to 1, the 5x11 dot format is used.
 	
+	\subsection busyflag Busy Flag
+	The "configUSE_BUSY_FLAG" setting selects how the library waits for the
+	controller. When set to 1 the R/W line is driven high and the busy flag is
+	read back before every write, so each character takes only as long as the
+	controller needs (about 43us) instead of the fixed 100us or more. When set
+	to 0 the fixed datasheet delays are used, which is required for boards with
+	R/W tied low. "configBUSY_TIMEOUT_POLLS" bounds how long a write waits for
+	the busy flag to clear before giving up.
+	
+	\subsection shadow Shadow Buffer
+	Setting "configUSE_SHADOW_BUFFER" to 1 keeps a RAM copy of both lines.
+	vLCD_WRITE_STRING, xLCD_WRITE_CHAR, vLCD_CLEAR and the position functions
+	then only change the RAM copy, and nothing reaches the display until
+	vLCD_FLUSH is called. The flush compares the copy with what is already on
+	the display and only sends the cells that changed, so redrawing a mostly
+	static screen costs a few bytes instead of both full lines.
+	
+	\subsection txqueue Interrupt Driven Transmit Queue
+	Setting "configUSE_TX_INTERRUPT" to 1 queues every write instead of
+	waiting on the bus. Timer 3 runs in CTC mode while bytes are queued and
+	its compare interrupt sends one byte per match, setting the next match to
+	the datasheet execution time of that byte (43us for data, 39us for most
+	instructions, 1.53ms for clear and return home). vLCD_WRITE_STRING,
+	vLCD_CLEAR and vLCD_GO_TO_POSITION return as soon as their bytes are in the
+	queue. "configTX_QUEUE_LENGTH" sets the queue size; a writer that finds
+	the queue full waits for space. Timer 3 must not be used elsewhere.
+	
+	\subsection gatekeeper FreeRTOS Gatekeeper Task
+	Setting "configUSE_LCD_GATEKEEPER" to 1 builds a gatekeeper task that owns
+	the display. xLCD_GATEKEEPER_START creates the task and a queue of
+	"configLCD_GATEKEEPER_QUEUE_LENGTH" requests. Tasks then call
+	xLCD_REQUEST_STRING, xLCD_REQUEST_WRITE, xLCD_REQUEST_POSITION,
+	xLCD_REQUEST_CLEAR and xLCD_REQUEST_COMMAND, which copy the request into
+	the queue and return; with a wait of 0 ticks they never block. Only the
+	gatekeeper calls the rest of the library, so the cursor variables and
+	the ports are never shared between tasks. The task runs at
+	"configLCD_GATEKEEPER_PRIORITY" and flushes the shadow buffer whenever the
+	queue runs empty. Text longer than "LCD_LINE_LENGTH" is refused with
+	errLCD_TEXT_TOO_LONG rather than cut. vLCD_GATEKEEPER_GET_STATS returns
+	the requests handled, the characters that landed on a visible line, the
+	requests refused because the queue was full, and the deepest the queue
+	has been. On the simulator in 8-bit mode a 24 character line costs its
+	caller 1152.9us written directly and no bus time through the queue, and
+	is on the display 1196.4us later; a full queue of such lines is written
+	at 20061 characters a second. The latency of a request, idle or under
+	contention, has not been measured: the simulator charges nothing for the
+	queue copy or the task switches, and its gatekeeper takes a request as
+	soon as a caller waits on a full queue, so both read 0us there. With
+	the frame scheduler a request waits for the next frame.
+	
+	\subsection peephole Peephole Stage
+	Setting "configUSE_PEEPHOLE" to 1 checks every instruction passed to
+	xWRITE_COMMAND_TO_LCD against what the controller already holds. A set
+	DDRAM address to the current address, or a display control or entry mode
+	equal to the last one sent, is dropped. While the cursor and blink are
+	off a set DDRAM address is held back until the next write, so several
+	moves in a row cost one instruction, and a move followed by clear, return
+	home or set CGRAM address costs none. This helps code that calls
+	vWRITE_COMMAND_TO_LCD directly with repeated instructions.
+	vLCD_PEEPHOLE_GET_STATS returns how many instructions were seen, dropped
+	and merged.
+	
+	\subsection glyphs CGRAM Glyph Cache
+	Setting "configUSE_GLYPH_CACHE" to 1 lets the application use more custom
+	characters than the 8 the controller holds. The glyphs are kept in a
+	table in flash, 8 bytes each, registered with vLCD_GLYPH_TABLE and named
+	by their place in it. xLCD_WRITE_GLYPH loads a glyph into a CGRAM slot
+	the first time it is used, 9 bus writes, and writes only the character
+	while it stays loaded. When every slot is taken the least recently used
+	slot that no cell on the display shows is reloaded; if all 8 are shown
+	the write is refused with LCD_ERROR_NO_GLYPH. The library keeps a copy
+	of the visible cells to know which slots are shown, so this costs 48
+	bytes of RAM unless the shadow buffer already keeps it.
+	vLCD_GLYPH_GET_STATS returns the hits, loads and refused glyphs.
+	
+	\subsection bargraph Bar Graphs and Sparklines
+	Setting "configUSE_BAR_GRAPH" to 1, with the glyph cache, adds horizontal
+	bars and scrolling sparklines. A bar fills one dot column at a time, 5
+	per cell, using the ROM full block, spaces and 4 partial glyphs. A
+	sparkline cell is a column of 0 to 8 lit rows using 7 partial glyphs.
+	The glyphs are built into the library as glyph IDs from
+	LCD_GLYPH_BUILTIN on and go through the cache, so a bar, a sparkline
+	and the application share the 8 CGRAM slots. Each widget remembers what
+	its cells show and an update writes only the cells that change, after
+	one set DDRAM address per run. A moving bar costs 2 or 3 writes. A
+	sparkline whose every cell changes costs 25 writes, about 1.1ms. When
+	no slot is free a cell shows the next lower level the cache has and is
+	corrected by a later update. On the simulator a 24 cell bar and a 24
+	cell sparkline updated together 50 times a second keep the bus busy
+	about 6% of the time.
+	
+	\subsection marquee Marquee
+	Setting "configUSE_MARQUEE" to 1 adds a scrolling ticker. Each DDRAM
+	line holds 40 cells of which 24 are visible. xLCD_MARQUEE_START writes
+	text of up to 40 characters into the whole line once, 41 writes, and
+	every xLCD_MARQUEE_STEP after that is a single shift display left
+	instruction, 39us, in place of rewriting 24 cells. The controller
+	shifts both lines together, so the other line should be blank or be
+	filled with 40 cells meant to scroll along, and only one marquee runs
+	at a time. Text longer than 40 characters cannot be held in DDRAM and
+	is scrolled by rewriting the visible cells each step. xLCD_MARQUEE_STOP
+	shifts the display back. The library tracks the shift in
+	LCD_DisplayShift, and with the glyph cache or shadow buffer keeps all
+	40 cells of each line in LCD_GlassBuffer, 32 more bytes, so glyphs in
+	the hidden cells keep their slots. While the display is shifted the
+	other functions take the columns showing on the glass, so text put at
+	column 0 appears in the first column, and the shadow buffer moves with
+	each shift.
+	
+	\subsection pageflip Page Flipping
+	Setting "configUSE_PAGE_FLIP" to 1 uses the 16 DDRAM cells per line that
+	are off screen as a second page. xLCD_PAGE_PREPARE writes the next page
+	16 cells to the right of the one showing; its last 16 columns land off
+	screen and are written without anything visible changing. 40 cells
+	cannot hold two whole 24 cell pages, so the first 8 columns of each
+	line are kept in RAM. xLCD_PAGE_FLIP switches the display off, writes
+	those 16 cells, sends 16 shift display left instructions and switches
+	the display on again, so the screen goes straight from the old page to
+	the new one. On the simulator with the busy flag the screen is blank
+	for 1.7ms per flip, while rewriting both lines in place shows a mix of
+	old and new lines for 1.8ms through the shadow buffer flush or 3.9ms
+	with vLCD_WRITE_STRING. With instrumentation enabled the flip is timed
+	on the target as LCD_API_PAGE_FLIP. The flip puts back the last display
+	control instruction sent, so the cursor, blink and a display switched
+	off are kept. The other write functions take the columns showing while
+	pages are shifted, but the next flip replaces what they wrote, and the
+	marquee should not run until xLCD_PAGE_END clears the display and the
+	shift.
+	
+	\subsection multidisplay Several Displays
+	Setting "configUSE_MULTI_DISPLAY" to 1 drives up to six displays from
+	one MCU. They share the data pins, RS and R/W, and each has its own E
+	pin on LCP, PJ2 to PJ7. A display only takes a write while its E is
+	strobed, so the others ignore the shared bus. The cursor, line lengths
+	and controller state that are globals with one display live in an
+	LCD_Display_t per display, set up with vLCD_DISPLAY_INIT, and every
+	function works on the display picked with vLCD_SELECT. Until a display
+	is set up they work on LCD_PrimaryDisplay, the display on LCD_E, so a
+	program written for one display runs unchanged. Each display is
+	initialized on its own. Only RS, R/W and the E pins being strobed are
+	changed on LCP, the other pins keep what the application set. Written one after another, N displays take N
+	times as long as one, as every write waits for its display to finish
+	executing. Writes made after vLCD_MULTI_BEGIN are queued per display
+	instead, "configLCD_MULTI_QUEUE_LENGTH" bytes each, and xLCD_MULTI_FLUSH
+	reads the busy flag of each display in turn and sends the next byte to
+	any that is ready, so one display executes while the bus carries bytes
+	to the others. On the simulator four screens of 50 writes took 9.4ms
+	one display after another and 2.4ms interleaved, about four times the
+	rate of one display, as the bus is idle for most of each write's 43us.
+	Content every display shows is sent once with the broadcast functions:
+	xLCD_BROADCAST_COMMAND, vLCD_BROADCAST_CLEAR and
+	vLCD_BROADCAST_INITIALIZATION take a mask of LCD_TARGET(display) values,
+	or LCD_TARGET_ALL, and strobe the E pins of all of them in the same bus
+	cycle. Busy flags are still read one display at a time. Writes queued
+	for a target are sent before a broadcast and writes queued after it
+	follow it. On the simulator four displays are initialized together in
+	36.7ms, the time of one. The busy flag is needed, and options that keep state of a
+	single display (transmit queue, gatekeeper, shadow buffer, peephole,
+	glyph cache, marquee, page flip and trace) cannot be combined with it.
+	
+	\subsection warmstart Warm Start
+	Setting "configUSE_WARM_START" to 1 lets vLCD_INITIALIZATION skip the
+	work a watchdog or external reset does not need. The display keeps its
+	power through such a reset, and with it its DDRAM, interface mode and
+	settings. Every initialization and vLCD_CLEAR leaves the byte
+	"configLCD_WARM_SIGNATURE" in the last DDRAM cell of the bottom line,
+	"configLCD_WARM_ADDRESS", which is never shown. After a reset that was
+	not a power on reset, the function addresses that cell. It reads the
+	address counter back, which only matches when the controller took the
+	instruction in the bus mode of this build, then reads the byte. When
+	both match, it skips the 30ms power on wait, the 4-bit resync and the
+	clear. It sends the function set, display control and entry mode again,
+	sets LCD_WarmStarted and leaves the display showing what it did. With
+	the shadow buffer, glyph cache or scrubber the visible cells are read
+	back into the buffers. When either check fails the full sequence runs without the
+	power on wait. After the first function set the busy flag is used
+	instead of the fixed 50us waits. configLCD_POWER_ON_RESET() decides
+	whether the reset was a power on reset. By default it tests PORF and
+	BORF in MCUSR, and after a power on MCUSR is copied to LCD_ResetCause
+	before the two flags are cleared, so the next reset skips the wait and
+	the application can still read why the MCU started. An application
+	that clears MCUSR itself should define it, and
+	configLCD_POWER_ON_SEEN(), on its saved copy. The busy flag is needed. The marquee, page flip and
+	several displays cannot be combined with it.
+	On the simulator in 8-bit mode the first character reaches the display
+	36.8ms after a power on, against 36.7ms without the option, as the
+	signature write adds 0.1ms. After a reset that loses the signature it
+	takes 1.95ms, and after a warm reset 0.32ms. With the shadow buffer a
+	warm reset takes 2.7ms, most of it reading back the 48 visible cells.
+	In 4-bit mode the three times are 41.1ms, 6.3ms and 0.36ms.
+	
+	\subsection scrub DDRAM Read Back and Scrubbing
+	With the busy flag, xLCD_READ_DDRAM reads characters back from the
+	display with R/W and RS high. Setting "configUSE_SCRUB" to 1 also keeps
+	a copy of what the library last wrote to every DDRAM cell it shows and
+	builds xLCD_SCRUB_STEP. Each call reads the next
+	"configLCD_SCRUB_CELLS" cells back, carrying on where the last one
+	stopped, and writes again only the cells that differ, so a display
+	upset by interference or a glitch on E is put right within one pass
+	without being redrawn, and a display that is right gets no writes at
+	all. The address counter and cursor are left where they were. Call it
+	from an idle slot; the calls per second times the cells per call bound
+	the share of bus time it takes. The gatekeeper calls it whenever no
+	request has come for "configLCD_SCRUB_TICKS". vLCD_SCRUB_GET_STATS
+	returns the cells checked and repaired and the passes made. The busy
+	flag is needed, and several displays cannot be combined with it.
+	On the simulator in 8-bit mode a step of four cells takes 286us, or
+	2.9% of the bus at one step every 10ms, and 379us when it repairs
+	cells. A pass over the 48 visible cells takes 12 steps. In 4-bit mode
+	a step takes 324us. With the marquee or page flip the hidden cells are
+	checked too and a pass takes 20 steps.
+	
+	\subsection frames Frame Paced Updates
+	Setting "configUSE_FRAME_SCHEDULER" to 1, with the shadow buffer, builds
+	vLCD_FRAME_WRITE and xLCD_FRAME_SEND. vLCD_FRAME_WRITE puts text in the
+	shadow buffer and returns at once, so a task can update a field as often
+	as its data changes and only the newest text of each cell is ever sent.
+	xLCD_FRAME_SEND sends the cells that changed, estimating the bus time of
+	each write as vLCD_FLUSH does, and stops before it would pass
+	"configLCD_FRAME_BUDGET_US"; the rest goes out with the next frame,
+	which starts on the line this one stopped on. The gatekeeper sends a
+	frame "configLCD_FRAME_RATE_HZ" times a second instead of flushing after
+	each burst of requests, and runs a scrub step after each frame when the
+	scrubber is built. vLCD_FRAME_GET_STATS returns the updates, the ones
+	coalesced because they landed on text no frame had sent yet, the ones
+	dropped because they changed nothing, and the frames sent and cut short
+	by the budget. Many coalesced updates mean the frame rate could go up
+	without showing anything new being lost; many deferred frames mean the
+	budget is too small for what changes each frame.
+	On the simulator two fields updated 500 times a second for a second
+	take 54.5ms of driver time when flushed after every update and 5.9ms
+	sent in frames at 20Hz, with 480 of the 1000 updates coalesced and 490
+	dropped. A whole new screen fits in one 2500us frame with the busy
+	flag and takes two without it.
+	
+	\subsection layout Field Layouts
+	Setting "configUSE_LAYOUT" to 1 lets a screen be described once, as a
+	table of LCD_Field_t in flash, instead of positions and labels spread
+	through the code. Each field has the column and line of its label, the
+	label itself as a PROGMEM string (or none, with LCD_FIELD_VALUE), and
+	the width and alignment of the value that follows the label. An enum in
+	table order gives the fields their names. vLCD_LAYOUT_SHOW clears the
+	display and writes the labels, the only time they are written.
+	xLCD_FIELD_SET renders a value into its field, padded with spaces, and
+	compares it with the cells the library knows the display holds, or with
+	the shadow buffer when that is enabled; when nothing differs nothing is
+	sent, else only the cells from the first to the last change. The
+	compare keeps a copy of the visible cells, so several displays cannot
+	be combined with it.
+	On the simulator in 8-bit mode a temperature set 100 times with its
+	mode field set alongside sends 60 characters in 5.1ms, against 2500
+	characters in 129ms when the labels and values are rewritten by hand.
+	With the shadow buffer the hand written screen also sends only what
+	changed, and takes 7.3ms against 5.1ms through the fields.
+	
+	\subsection utf8 UTF-8 Text
+	vLCD_WRITE_STRING sends bytes as they are, which only suits ASCII.
+	Setting "configUSE_UTF8" to 1 builds xLCD_WRITE_UTF8, which decodes
+	UTF-8 and writes each character as its code in the character ROM named
+	by "configLCD_ROM". The codes come from a sorted table of code point
+	ranges in flash, one per ROM: LCD_ROM_A00, the Japanese standard font,
+	has the degree sign, a few Latin letters such as the lower case umlauts
+	and sharp s, Greek letters and math signs, and katakana. Full width
+	katakana and hiragana are shown as the half width katakana of the same
+	sound, and voiced ones take a second cell for the voiced sound mark.
+	LCD_ROM_A02, the European font, has ISO 8859-1 from 0xA1 up. Other
+	characters and malformed UTF-8 are written as "configUTF8_REPLACEMENT".
+	With "configUSE_UTF8_GLYPHS" and the glyph cache the application can
+	register a map from code points to glyph IDs with vLCD_UTF8_GLYPHS,
+	for characters the ROM lacks such as the capital umlauts on A00. ASCII
+	takes the same loop as vLCD_WRITE_STRING plus one test of bit 7, and on
+	the simulator 23 ASCII characters take 1104.8us either way.
+	
+	\subsection yield Yielding Waits
+	The power on wait of vLCD_INITIALIZATION is 35ms and clear display
+	takes 1.53ms, spent spinning in a delay or polling the busy flag while
+	tasks of the same priority wait and tickless idle cannot start. Setting
+	"configUSE_YIELD_WAIT" to 1 makes waits of "configLCD_YIELD_THRESHOLD_US"
+	or longer block the calling task with vTaskDelay instead: the power on
+	wait, the first wait of the 4-bit reset and the wait after clear
+	display, in vLCD_CLEAR, vLCD_INITIALIZATION and xLCD_PAGE_END. Shorter
+	waits still spin, and so does every wait before the scheduler starts,
+	while it is suspended or with interrupts off. The task wakes on a tick,
+	so a clear takes two to three ticks instead of 1.53ms. With the transmit
+	queue or several displays the clear is paced by the queue and does not
+	block. With instrumentation enabled the blocked time is counted in
+	BlockedCycles and left out of the call cycles.
+	A blocked task is part way through a library call, and the library
+	keeps its state in globals, so with yielding waits only one task may
+	call it: the gatekeeper task with "configUSE_LCD_GATEKEEPER" set to 1,
+	which other tasks reach through its request functions, or else a
+	single task that owns the display. vLCD_FRAME_WRITE is safe from any
+	task since it only fills the shadow buffer in a critical section.
+	Measured on the simulator only, not on hardware, with a 1ms tick:
+	initializing the display and clearing and writing ten screens takes the
+	CPU 63.0ms when every wait spins and 11.1ms when the long ones block,
+	14.3% of the 78.1ms the run takes. With fixed delays instead of the busy
+	flag it is 76.8ms against 24.9ms.
+	
+	\subsection cpp C++ Front End
+	Lib_LCD.hpp is a header only C++11 version of the core functions for
+	C++ projects. LCD::Driver is a class template specialized on the data
+	and control port, the RS, R/W and E pins, an 8-bit or 4-bit bus, the
+	lines and characters per line, and the cursor, busy flag and font
+	options, so everything the C library reads from its config macros is a
+	constant of the type. The instructions are built by constexpr functions
+	in LCD::Instruction and GoTo<X, Y>() checks the position and encodes the
+	address at compile time. The bus cycle is inlined, and there is no RAM
+	state but the cursor of each specialization. RS, R/W and E are changed
+	with a read, modify and write of the control port, as Lib_LCD.c does
+	with LCP, so the other pins of the port keep their outputs and
+	pull-ups. A port given over to the display can be declared with
+	LCD_DEDICATED_PORT_POLICY instead, and is then written with stores of
+	constants that drive its other pins low. LCD::LabDriver is the lab board wiring. Use the header
+	instead of Lib_LCD.c, not beside it. Defining LCD_CPP_C_API as a driver
+	type before including it once more in one C++ file adds
+	vLCD_INITIALIZATION, v/xWRITE_COMMAND_TO_LCD, xLCD_WAIT_WHILE_BUSY,
+	xLCD_WRITE_CHAR, vLCD_WRITE_STRING, vLCD_CLEAR, vLCD_GO_TO_POSITION and
+	the home functions as extern "C" wrappers, so C code keeps its calls.
+	Measured on the simulator only, a 24 character string takes 1.09ms
+	against 1.15ms for Lib_LCD.c in 8-bit mode and 1.22ms against 1.36ms
+	in 4-bit mode with the busy flag. With fixed delays it takes 1.06ms
+	against 2.45ms, as only one delay follows each strobe. A dedicated
+	control port gives 1.11ms, 1.18ms and 1.05ms. The code size on the AVR
+	has not been measured. The other options of the C library are not
+	available.
+	
+	\subsection stats Instrumentation
+	Setting "configUSE_LCD_STATS" to 1 counts the calls of each public
+	function and the CPU cycles spent in it, read from Timer 5 running at
+	F_CPU/64, so times are in steps of 64 cycles. Nested calls are counted
+	in every function they pass through, and once in the total. The data
+	bytes and instructions sent or queued, the microseconds spent in fixed
+	delays and the busy flag polls are counted as well. vLCD_GET_STATS
+	copies the counters and vLCD_RESET_STATS zeroes them. Timer 5 is not
+	free for other use while this is enabled; the bus trace reads the same
+	count, so the two can be enabled together. LCD_STATS_ENTER declares a
+	frame that the GCC cleanup attribute closes on every return, so it must
+	come first in a function body and the library needs GCC, as avr-gcc is.
+	Set to 0 the macros count nothing and no code or RAM is used.
+	
+	\subsection trace Bus Trace Recorder
+	Setting "configUSE_LCD_TRACE" to 1 records every write passed to
+	xWRITE_COMMAND_TO_LCD after vLCD_TRACE_START, before the peephole stage,
+	in a ring buffer of "configLCD_TRACE_LENGTH" bytes. Each record holds RS,
+	the byte and the Timer 5 ticks (4us at 16MHz) since the record before.
+	Gaps under 127 ticks fit beside RS in one byte, so most writes take two
+	bytes and a display updated with a few hundred writes a second needs
+	well under 1KB a second. Longer gaps add one byte per seven bits. When
+	the buffer is full the oldest records are dropped and counted.
+	vLCD_TRACE_DUMP passes a header and the records to a function given by
+	the application, for example one that writes them to a UART or an SD
+	card, and empties the buffer. sim/trace_replay.c replays a stored trace
+	against any build of the library on the host simulator and reports the
+	time spent in the library, the bus traffic and any broken timing rules.
+	Timer 5 and its compare A interrupt are used by the recorder.
+	
+	\subsection simulator Host Simulator
+	The sim directory builds the library unchanged on Linux against a model
+	of the KS0066U. Stub avr/io.h, util/delay.h, avr/interrupt.h and
+	avr/pgmspace.h headers route every register access and delay to the
+	model, which runs on a virtual clock. It latches writes on the falling
+	edge of E, keeps DDRAM, CGRAM, the address counter and the busy time of
+	each instruction, drives the data pins for busy flag and data reads, and
+	runs Timer 3 and Timer 5 with their compare interrupts. It reports every
+	write made while the controller is busy, E pulses and cycles that are too
+	short, set up times that are broken, reads made before the data is valid,
+	and bus contention. sim_main.c runs a fixed sequence of library calls,
+	prints the virtual time, controller busy time and bus traffic of each one,
+	and checks what the display shows. Build it from the repository root with
+	<pre>gcc -std=gnu99 -Wall -Wno-comment -Isim -I. sim/sim_main.c sim/lcd_sim.c -o lcd_sim</pre>
+	and add -D options such as -DBITMODE4 or -DconfigUSE_BUSY_FLAG=0 to try
+	other configurations. The program exits with 1 if any rule was broken.
+	With -DconfigUSE_LCD_STATS=1 it also prints the library's own counters,
+	and with -DconfigUSE_LCD_TRACE=1 it stores its bus trace in lcd.trace.
+	With -DconfigUSE_GLYPH_CACHE=1 -DconfigUSE_BAR_GRAPH=1 it updates a bar
+	and a sparkline 50 times a second and prints their cost, and with
+	-DconfigUSE_MARQUEE=1 it scrolls a short and a long text. With
+	-DconfigUSE_PAGE_FLIP=1 it flips pages and prints how long the screen
+	change takes against rewriting in place. With -DconfigUSE_MULTI_DISPLAY=1
+	it initializes, clears and writes four displays together, then one after
+	another and interleaved; the model has a controller on each of PJ2 to PJ7.
+	With -DconfigUSE_WARM_START=1 it resets the MCU after a power cycle, with
+	the display left powered, and with the signature overwritten, and prints
+	the time to the first character after each. With -DconfigUSE_SCRUB=1 it
+	reads a line back, changes three cells behind the library's back, runs
+	scrub steps until they are put right and prints the time of a step.
+	With -DconfigUSE_FRAME_SCHEDULER=1 it updates two fields 500 times a
+	second, flushed after each update and then in frames, and prints the
+	driver time and frame counters of both. With -DconfigUSE_LAYOUT=1 it
+	shows a screen of fields, checks that a value set again sends nothing,
+	and compares setting fields with rewriting the screen by hand. With
+	-DconfigUSE_UTF8=1 it writes UTF-8 symbols, katakana and malformed
+	sequences and checks the ROM codes, for -DconfigLCD_ROM=LCD_ROM_A02 as
+	well, and times ASCII against vLCD_WRITE_STRING. With
+	-DconfigUSE_YIELD_WAIT=1 it initializes the display and writes ten
+	screens after clears, before the scheduler starts and with it running,
+	prints the CPU time of both and checks a clear with interrupts off does
+	not block. FreeRTOS.h and task.h in sim/ stand in for the kernel.
+	sim_cpp.cpp runs the same opening calls through the C++ front end and
+	its wrappers, built with
+	<pre>gcc -std=gnu99 -c sim/lcd_sim.c -o lcd_sim.o
+	g++ -std=c++11 -Wall -Isim -I. sim/sim_cpp.cpp lcd_sim.o -o lcd_sim_cpp</pre>
+	and takes -DBITMODE4 and -DconfigUSE_BUSY_FLAG=0 the same way.
+	Replay a trace with
+	<pre>gcc -std=gnu99 -Wall -Wno-comment -Isim -I. sim/trace_replay.c sim/lcd_sim.c -o lcd_replay
+	./lcd_replay lcd.trace</pre>
+	built with the options to compare.
+	
 	\subsection Mode Increment and Shift Mode
 	\warning Shift mode is non-operational! Enabling it may yield unexpected results! 
+	The marquee does not use it, it sends display shift instructions.
 	
 	The configuration of the shift mode can be changed to either increment or
 	entire shift. Setting the define "INCREMENT_MODE" to 1 will set the display
@@ -117,7 +531,14 @@
 	function configures the ports used by the display, sets the display's entry
 	mode and text size, turns on the display while setting the cursor settings,
 	then clears the display. The display should be on, the text cleared, and the
-	cursor at the home position.
+	cursor at the home position. With "configUSE_WARM_START" a display that
+	kept its power through the reset is not cleared, see \ref warmstart.
+	The busy flag is not read before the function set, which uses the
+	datasheet delays in every configuration.
+	
+	\subsection xinitialization xLCD_INITIALIZATION()
+	The same as vLCD_INITIALIZATION, returning LCD_ERROR_TIMEOUT when an
+	instruction was not written because the busy flag never cleared.
 	
 	\subsection write_command vWRITE_COMMAND_TO_LCD(RS,data)
 	Writes instructions or characters to the LCD. The input
@@ -129,25 +550,212 @@
 	be called if the user wishes to use a command not available through function
 	calls contained in this library.
 	
+	\subsection write_command_status xWRITE_COMMAND_TO_LCD(RS,data)
+	Same as vWRITE_COMMAND_TO_LCD, but returns LCD_OK when the byte was written
+	or LCD_ERROR_TIMEOUT when the busy flag did not clear in time. Nothing is
+	written after a timeout.
+	
 	\subsection write_string vLCD_WRITE_STRING(string)
 	Writes an input string to the LCD at the cursor's current
 	position. This will overwrite and current characters on the display. If text
 	wrapping is enabled, the text will automatically move from line 1 to line 2
 	if overflow happens.
 	
+	\subsection write_char xLCD_WRITE_CHAR(character)
+	Writes one character at the cursor and moves the cursor right. Returns
+	LCD_OK or LCD_ERROR_TIMEOUT.
+	
+	\subsection segments xLCD_WRITE_SEGMENTS(segments,count)
+	Writes an array of LCD_Segment_t fields, each Length bytes of Text at X,Y,
+	in one call. The array is sorted in place by DDRAM address and a set DDRAM
+	address instruction is only sent when a segment does not start where the
+	previous one ended. There is no text wrapping; each segment is clipped to
+	the end of its line. Returns LCD_OK or LCD_ERROR_TIMEOUT. On the simulator
+	in 8-bit mode six 4 character fields in three adjacent pairs take 1243.6us
+	as segments against 1422.1us with vLCD_GO_TO_POSITION and
+	vLCD_WRITE_STRING for each, with the busy flag, and 2645.5us against
+	3052.5us with fixed delays.
+	
+	\subsection numbers xLCD_WRITE_UNSIGNED(), xLCD_WRITE_SIGNED(), xLCD_WRITE_FIXED(), xLCD_WRITE_HEX()
+	Write a variable at the cursor without sprintf. Each takes the value, a
+	minimum width and flags: LCD_NUM_LEFT left aligns with trailing spaces,
+	LCD_NUM_ZERO pads with zeros after the sign, LCD_NUM_PLUS writes a '+' in
+	front of positive values. xLCD_WRITE_FIXED also takes the number of
+	decimals the value is scaled by, so xLCD_WRITE_FIXED(2315, 1, 5, 0) writes
+	"231.5". xLCD_WRITE_HEX writes upper case digits with no prefix. Digits
+	are written one at a time as they are found; no buffer is used.
+	
+	\subsection glyphtable vLCD_GLYPH_TABLE(patterns,count)
+	Registers a table of count glyphs in flash. Glyph IDs are places in the
+	table.
+	
+	\subsection glyphcode xLCD_GLYPH_CODE(id,code)
+	Loads a glyph if needed and returns the character code, 8 to 15, that
+	shows it. The code can be put in a string for vLCD_WRITE_STRING.
+	
+	\subsection writeglyph xLCD_WRITE_GLYPH(id)
+	Writes a glyph at the cursor, loading it first if needed.
+	
+	\subsection barinit vLCD_BAR_INIT(bar,x,y,width)
+	Places a horizontal bar of width cells. Nothing is drawn until the
+	first xLCD_BAR_SET.
+	
+	\subsection barset xLCD_BAR_SET(bar,value,full)
+	Shows value out of full, writing only the cells that change.
+	
+	\subsection sparkinit vLCD_SPARK_INIT(spark,x,y,width)
+	Places an empty sparkline of width cells.
+	
+	\subsection sparkpush xLCD_SPARK_PUSH(spark,value,full)
+	Scrolls the sparkline one cell left and shows value out of full in the
+	last cell, writing only the cells that change.
+	
+	\subsection marqueestart xLCD_MARQUEE_START(y,text)
+	Starts scrolling text on line y. Text longer than 40 characters must
+	stay valid until the marquee is stopped.
+	
+	\subsection marqueestep xLCD_MARQUEE_STEP()
+	Scrolls the marquee one character left.
+	
+	\subsection marqueestop xLCD_MARQUEE_STOP()
+	Stops the marquee and shifts the display back, at most 20 shifts.
+	
+	\subsection pageprepare xLCD_PAGE_PREPARE(top,bottom)
+	Writes the next page into the cells off screen. Lines shorter than 24
+	characters are padded with spaces.
+	
+	\subsection pageflip_fn xLCD_PAGE_FLIP()
+	Brings the prepared page into view with the display switched off.
+	
+	\subsection pageend xLCD_PAGE_END()
+	Clears the display and the shift.
+	
+	\subsection displayinit vLCD_DISPLAY_INIT(display,enable)
+	Sets up a handle for the display with E on LCP pin enable and adds it to
+	the scheduler. Call it for every display before any is written.
+	
+	\subsection select vLCD_SELECT(display)
+	Picks the display the other functions work on.
+	
+	\subsection multibegin vLCD_MULTI_BEGIN()
+	Queues the writes that follow per display until xLCD_MULTI_FLUSH.
+	
+	\subsection multiflush xLCD_MULTI_FLUSH()
+	Sends every queued write, each display as soon as it is ready. Returns
+	LCD_ERROR_TIMEOUT if a display stopped responding; the others are still
+	written.
+	
+	\subsection broadcastcommand xLCD_BROADCAST_COMMAND(targets,RS,data)
+	Writes one instruction or data byte to every display in targets in one
+	bus cycle.
+	
+	\subsection broadcastclear vLCD_BROADCAST_CLEAR(targets)
+	Clears every display in targets at once.
+	
+	\subsection broadcastinit vLCD_BROADCAST_INITIALIZATION(targets)
+	Initializes every display in targets at once, with one power up wait.
+	
+	\subsection flush vLCD_FLUSH()
+	Sends the shadow buffer cells that differ from the display. Runs of
+	changed cells are addressed once. With fixed delays a one cell unchanged
+	gap between runs is rewritten instead of sending a new set DDRAM
+	address instruction; with the busy flag a data write takes longer than
+	the instruction, so gaps are always re-addressed. Does nothing when the
+	shadow buffer is disabled.
+	
+	\subsection framewrite vLCD_FRAME_WRITE(x,y,text)
+	Puts text at x,y in the next frame, cut at the end of the line. Touches
+	neither the bus nor the cursor, and may be called from any task.
+	
+	\subsection framesend xLCD_FRAME_SEND()
+	Sends one frame of changes within "configLCD_FRAME_BUDGET_US" of bus
+	time. Returns LCD_ERROR_BUDGET when changes are left for the next frame.
+	
+	\subsection framestats vLCD_FRAME_GET_STATS(stats), vLCD_FRAME_RESET_STATS()
+	Copy or zero the frame counters.
+	
+	\subsection layoutshow vLCD_LAYOUT_SHOW(fields,count)
+	Clears the display and writes the labels of a table of fields in flash,
+	which becomes the layout xLCD_FIELD_SET works on.
+	
+	\subsection fieldset xLCD_FIELD_SET(field,text)
+	Writes the value of a field, only the cells that change. Returns
+	LCD_ERROR_NO_FIELD when field is not in the layout.
+	
+	\subsection writeutf8 xLCD_WRITE_UTF8(text)
+	Writes UTF-8 text at the cursor as character ROM codes.
+	
+	\subsection utf8glyphs vLCD_UTF8_GLYPHS(map,count)
+	Registers a table in flash of code points drawn from glyph IDs.
+	
+	\subsection readddram xLCD_READ_DDRAM(x,y,length,buffer)
+	Reads length characters of line y from column x into buffer, without a
+	terminating null, and puts the address counter back. Columns up to the
+	end of the DDRAM line can be read. Only built with the busy flag.
+	
+	\subsection scrubstep xLCD_SCRUB_STEP()
+	Checks the next "configLCD_SCRUB_CELLS" cells against what the library
+	wrote to them and writes again the ones that differ.
+	
+	\subsection scrubstats vLCD_SCRUB_GET_STATS(stats), vLCD_SCRUB_RESET_STATS()
+	Copy or zero the scrub counters.
+	
+	\subsection txidle xLCD_TX_IDLE()
+	Returns 1 once every queued byte has been sent and executed, else 0.
+	
+	\subsection txflush vLCD_TX_FLUSH()
+	Waits until every queued byte has been sent and executed. Use it when
+	later code depends on the display having been updated.
+	
+	\subsection peepholeflush xLCD_PEEPHOLE_FLUSH()
+	Sends a set DDRAM address held back by the peephole stage. The next write
+	sends it anyway, so this is only needed before handing the bus to other
+	code.
+	
+	\subsection getstats vLCD_GET_STATS(stats)
+	Copies the instrumentation counters into stats. Only built when
+	"configUSE_LCD_STATS" is 1.
+	
+	\subsection resetstats vLCD_RESET_STATS()
+	Zeroes the instrumentation counters.
+	
+	\subsection tracestart vLCD_TRACE_START()
+	Empties the bus trace and starts recording. Call it before
+	vLCD_INITIALIZATION to record the start up instructions.
+	
+	\subsection tracestop vLCD_TRACE_STOP()
+	Stops recording, the records are kept.
+	
+	\subsection tracedump vLCD_TRACE_DUMP(writer)
+	Calls writer with the trace header and records and empties the trace.
+	Dumps stored one after another replay as one trace.
+	
 	\subsection clear vLCD_CLEAR()
 	Clears both lines of the display and returns the cursor to the
-	home position.
+	home position. With "configUSE_WARM_START" the signature is written
+	again afterwards.
 	
 	\subsection clear_top vLCD_CLEAR_TOP()
-	Sets the cursor for the home position of the top row, writes
-	a string of 24 spaces, then returns the cursor to the home position of the
-	top row.
+	Clears line 0 with vLCD_CLEAR_LINE(0).
 	
 	\subsection clear_bottom vLCD_CLEAR_BOTTOM()
-	Sets the cursor for the home position of the bottom row, writes
-	a string of 24 spaces, then returns the cursor to the home position of the
-	bottom row.
+	Clears line 1 with vLCD_CLEAR_LINE(1).
+	
+	\subsection clear_line vLCD_CLEAR_LINE(y)
+	Writes 24 spaces over line y, then returns the cursor to the home position
+	of that line. Only set-DDRAM address instructions (39us) are used, never
+	the clear or return home instructions (1.53ms each). On the simulator in
+	8-bit mode a line clear takes 1243.6us with the busy flag and 2645.5us
+	with fixed delays, until the controller is idle again; the top line clear
+	it replaced took 4227.1us and 5705.5us.
+	
+	\subsection clear_range vLCD_CLEAR_RANGE(x,y,length)
+	Writes spaces over length cells starting at x on line y.
+	
+	\subsection fill_range vLCD_FILL_RANGE(x,y,length,character)
+	Writes character over length cells starting at x on line y, after a single
+	set-DDRAM address instruction. The range is clipped to the end of the line
+	and the cursor is left on the cell after it.
 	
 	\subsection onoff vLCD_ON_OFF()
 	Toggles the on/off status of the LCD. If called, the LCD will
@@ -170,6 +778,11 @@
 	
 	\subsection bottomhome vLCD_HOME_BOTTOM_LINE()
 	Moves the cursor to the home position of the bottom line.
+	
+	\subsection linehome vLCD_HOME_LINE(y)
+	Moves the cursor to the home position of line y with a set-DDRAM address
+	instruction. The home functions above use it instead of the 1.53ms return
+	home instruction.
 */
 
 /*! \page Flowcharts LCD Library Function Flowcharts
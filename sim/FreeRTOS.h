@@ -0,0 +1,48 @@
+/*!****************************************************************************
+ *
+ * \file FreeRTOS.h
+ *
+ * \brief Host stand-in for the FreeRTOS.h of the ATmega2560 port
+ *
+ * \details Only what the yielding waits and the gatekeeper of the library
+ *			use. The tick is 1ms as in the lab project, and can be changed
+ *			with -D.
+ *
+ * Modification History:
+ * 10/18/2026 - Added the task, queue and return values of the gatekeeper
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef SIM_FREERTOS_H
+#define SIM_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint16_t TickType_t;
+typedef int8_t BaseType_t;
+typedef uint8_t UBaseType_t;
+typedef void (*TaskFunction_t)(void *);
+
+#ifndef configTICK_RATE_HZ
+	#define configTICK_RATE_HZ	1000
+#endif
+
+#define configUSE_TIMERS				0
+#define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetSchedulerState	1
+
+#define portTICK_PERIOD_MS	((TickType_t)(1000 / configTICK_RATE_HZ))
+#define portMAX_DELAY		((TickType_t)0xFFFF)
+
+#define tskIDLE_PRIORITY		0
+#define configMINIMAL_STACK_SIZE	85
+
+#define pdFALSE			((BaseType_t)0)
+#define pdTRUE			((BaseType_t)1)
+#define pdPASS			pdTRUE
+#define pdFAIL			pdFALSE
+#define errQUEUE_FULL	((BaseType_t)0)
+
+#endif
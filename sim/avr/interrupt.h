@@ -0,0 +1,28 @@
+/*!****************************************************************************
+ *
+ * \file interrupt.h
+ *
+ * \brief Host stand-in for <avr/interrupt.h>
+ *
+ * \details The model calls the compare match handlers itself when the
+ *			virtual clock passes a match with the interrupt enabled.
+ *
+ * Modification History:
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef SIM_AVR_INTERRUPT_H
+#define SIM_AVR_INTERRUPT_H
+
+#include "../lcd_sim.h"
+
+#define ISR(vector)			void vector(void)
+#define TIMER3_COMPA_vect	vSIM_TIMER3_COMPA_ISR
+#define TIMER5_COMPA_vect	vSIM_TIMER5_COMPA_ISR
+
+#define cli()	vSIM_CLI()
+#define sei()	vSIM_SEI()
+
+#endif
@@ -0,0 +1,69 @@
+/*!****************************************************************************
+ *
+ * \file io.h
+ *
+ * \brief Host stand-in for <avr/io.h>
+ *
+ * \details Every register is an lvalue behind xSIM_REGISTER, so the library
+ *			compiles unchanged and each access reaches the KS0066U model.
+ *
+ * Modification History:
+ * 10/18/2026 - Added MCUSR
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef SIM_AVR_IO_H
+#define SIM_AVR_IO_H
+
+#include <stdint.h>
+#include "../lcd_sim.h"
+
+#define PORTK	(*xSIM_REGISTER(SIM_PORTK))
+#define DDRK	(*xSIM_REGISTER(SIM_DDRK))
+#define PINK	(*xSIM_REGISTER(SIM_PINK))
+#define PORTJ	(*xSIM_REGISTER(SIM_PORTJ))
+#define DDRJ	(*xSIM_REGISTER(SIM_DDRJ))
+#define PINJ	(*xSIM_REGISTER(SIM_PINJ))
+#define SREG	(*xSIM_REGISTER(SIM_SREG))
+#define MCUSR	(*xSIM_REGISTER(SIM_MCUSR))
+
+#define TCCR3A	(*xSIM_REGISTER(SIM_TCCR3A))
+#define TCCR3B	(*xSIM_REGISTER(SIM_TCCR3B))
+#define TIMSK3	(*xSIM_REGISTER(SIM_TIMSK3))
+#define TIFR3	(*xSIM_REGISTER(SIM_TIFR3))
+#define TCNT3	(*xSIM_REGISTER16(SIM_TCNT3))
+#define OCR3A	(*xSIM_REGISTER16(SIM_OCR3A))
+
+#define TCCR5A	(*xSIM_REGISTER(SIM_TCCR5A))
+#define TCCR5B	(*xSIM_REGISTER(SIM_TCCR5B))
+#define TIMSK5	(*xSIM_REGISTER(SIM_TIMSK5))
+#define TIFR5	(*xSIM_REGISTER(SIM_TIFR5))
+#define TCNT5	(*xSIM_REGISTER16(SIM_TCNT5))
+#define OCR5A	(*xSIM_REGISTER16(SIM_OCR5A))
+
+#define SREG_I	7
+
+/* Reset flags in MCUSR */
+#define PORF	0
+#define EXTRF	1
+#define BORF	2
+#define WDRF	3
+#define JTRF	4
+
+/* Timer bits, the same for Timer 3 and Timer 5 */
+#define CS30	0
+#define CS31	1
+#define CS32	2
+#define WGM32	3
+#define OCIE3A	1
+#define OCF3A	1
+#define CS50	0
+#define CS51	1
+#define CS52	2
+#define WGM52	3
+#define OCIE5A	1
+#define OCF5A	1
+
+#endif
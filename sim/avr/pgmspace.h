@@ -0,0 +1,27 @@
+/*!****************************************************************************
+ *
+ * \file pgmspace.h
+ *
+ * \brief Host stand-in for <avr/pgmspace.h>
+ *
+ * \details The host has one address space, flash tables are plain data.
+ *
+ * Modification History:
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef SIM_AVR_PGMSPACE_H
+#define SIM_AVR_PGMSPACE_H
+
+#include <stdint.h>
+
+#define PROGMEM
+#define PSTR(s)				(s)
+#define pgm_read_byte(p)	(*(const uint8_t *)(p))
+#define pgm_read_word(p)	(*(const uint16_t *)(p))
+#define pgm_read_dword(p)	(*(const uint32_t *)(p))
+#define pgm_read_ptr(p)		(*(void * const *)(p))
+
+#endif
@@ -0,0 +1,1465 @@
+/*!****************************************************************************
+ *
+ * \file lcd_sim.c
+ *
+ * \brief Host model of the KS0066U and the ATmega2560 registers it uses
+ *
+ * \author
+ *
+ * \details Each register access first applies the previous one to the
+ *			model, then advances the virtual clock by SIM_ACCESS_NS. Writes
+ *			are found by comparing each register with its value at the last
+ *			access, so the library needs no hooks of its own; a write of the
+ *			value a register already holds changes no pin and is not seen,
+ *			which is also true of the hardware.
+ *
+ *			The display is wired as on the lab board: data on PORTK, RS on
+ *			PJ0, R/W on PJ1 and E on PJ2. Further displays share the data
+ *			pins, RS and R/W, with E on PJ3 to PJ7.
+ *
+ *			Timer 3 and Timer 5 are modelled in normal and CTC mode with
+ *			compare A only. Reading TIFRn clears the flags it returned, which
+ *			stands in for the write-one-to-clear the library always does
+ *			straight after.
+ *
+ * Modification History:
+ * 10/18/2026 - Added a read of the display control bits
+ * 10/18/2026 - Added a task, queues and critical sections
+ * 10/18/2026 - Flag busy flag reads before the function set
+ * 10/18/2026 - Added RTOS scheduler state and blocking task delays
+ * 10/18/2026 - Added DDRAM upsets
+ * 10/18/2026 - Added MCU resets and power cycles
+ * 10/18/2026 - Added displays on PJ3 to PJ7
+ * 10/18/2026 - Added CGRAM read back
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include "lcd_sim.h"
+
+/*****************************************************************************/
+/*********************/
+/*Simulator Variables*/
+/*********************/
+
+/*! Control pins on PORTJ, display n has E on SIM_PIN_E + n */
+#define SIM_PIN_RS		0
+#define SIM_PIN_RW		1
+#define SIM_PIN_E		2
+
+/*! Compare match handlers, defined by the library when it uses the timer */
+void vSIM_TIMER3_COMPA_ISR(void) __attribute__((weak));
+void vSIM_TIMER5_COMPA_ISR(void) __attribute__((weak));
+
+/*! One 16-bit timer with compare A */
+typedef struct
+{
+	uint8_t Tccrb;			// register numbers
+	uint8_t Timsk;
+	uint8_t Tifr;
+	uint8_t Tcnt;
+	uint8_t Ocr;
+	uint32_t Prescale;		// 0 while stopped
+	uint64_t Base;			// time the counter held BaseCount
+	uint32_t BaseCount;
+	uint64_t Match;			// time of the next compare match
+	void (*Isr)(void);
+} SIM_Timer_t;
+
+/*! Register values as the program sees them, and at the last access */
+static volatile uint8_t SIM_Registers[SIM_REGISTERS];
+static uint8_t SIM_Last[SIM_REGISTERS];
+static volatile uint16_t SIM_Registers16[SIM_REGISTERS16];
+static uint16_t SIM_Last16[SIM_REGISTERS16];
+/*! Set when TIFRn was read since the last access */
+static uint8_t SIM_FlagsRead[SIM_REGISTERS];
+
+static SIM_Timer_t SIM_Timers[2];
+static uint8_t SIM_InIsr = 0;
+static uint8_t SIM_Verbose = 1;
+static uint8_t SIM_Scheduler = SIM_SCHEDULER_NOT_STARTED;
+
+/*! SREG saved by each open critical section */
+#define SIM_CRITICAL_DEPTH	8
+static uint8_t SIM_Critical[SIM_CRITICAL_DEPTH];
+static uint8_t SIM_CriticalDepth = 0;
+
+/*! The one task, run on its own stack beside the simulator run */
+#define SIM_TASK_STACK	65536
+static ucontext_t SIM_RunContext;
+static ucontext_t SIM_TaskContext;
+static uint8_t SIM_TaskStack[SIM_TASK_STACK];
+static void (*SIM_Task)(void *) = NULL;
+static void *SIM_TaskParameters;
+static uint8_t SIM_InTask = 0;
+/*! Set when the task gave the CPU back to a waiting sender */
+static uint8_t SIM_TaskPreempted = 0;
+/*! Set while the simulator run waits for room in a queue */
+static uint8_t SIM_SendWaiting = 0;
+/*! End of the stretch the task was given */
+static uint64_t SIM_TaskUntil;
+static SIM_Stats_t SIM_Stats;
+
+/*! One controller */
+typedef struct
+{
+	uint8_t Wiring;
+	uint8_t Bus8Bit;		// DL
+	uint8_t TwoLine;		// N
+	uint8_t Display;		// D, C and B as sent
+	uint8_t Increment;		// I/D
+	uint8_t ShiftOnWrite;	// S
+	uint8_t Address;		// AC
+	uint8_t Cgram;			// AC points at CGRAM
+	uint8_t Shift;			// display shift, 0-39 cells left
+	uint8_t Ddram[128];
+	uint8_t Cgram_[64];
+	uint64_t BusyUntil;
+	uint8_t Nibble;			// 4-bit transfer, second nibble next
+	uint8_t High;			// first nibble of a 4-bit write
+	uint8_t Ignore;			// byte started while busy, drop it
+	uint8_t Out;			// byte driven during a read
+	uint8_t Rs, Rw, E, Bus;	// pins as the controller sees them
+	uint64_t ControlChanged;
+	uint64_t BusChanged;
+	uint64_t Rose;
+	uint64_t Fell;
+	uint8_t Contention;		// contention already reported this pulse
+	uint8_t FunctionSet;	// a function set ran since power on
+} SIM_Lcd_t;
+
+/*! The controllers, sharing the data bus, RS and R/W */
+static SIM_Lcd_t SIM_Lcds[SIM_DISPLAYS];
+/*! The controller the inspection functions look at */
+static SIM_Lcd_t *SIM_Shown = &SIM_Lcds[0];
+/*! Contention between controllers already reported */
+static uint8_t SIM_Clash = 0;
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*****************************/
+/*Simulator Private Functions*/
+/*****************************/
+
+static void prvSIM_ADVANCE(uint64_t ns);
+static void prvSIM_PINS_ONE(SIM_Lcd_t *lcd, uint8_t control, uint8_t E);
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_VIOLATION(uint8_t, const char *)
+ *
+ * \brief Function to count a broken timing rule
+ *
+ ******************************************************************************
+ */
+static void prvSIM_VIOLATION(uint8_t type, const char *detail)
+{
+	SIM_Stats.Violations[type]++;
+
+	if (SIM_Verbose)
+	{
+		printf("  ! %10.3fus %s: %s\n", SIM_Stats.Now / 1000.0,
+			xSIM_VIOLATION_NAME(type), detail);
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_STEP_ADDRESS(SIM_Lcd_t *, int8_t)
+ *
+ * \brief Function to move the address counter one cell
+ *
+ * \details DDRAM addresses run 0x00-0x27 and 0x40-0x67 in two line mode
+ *			and wrap from the end of one line to the start of the other.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_STEP_ADDRESS(SIM_Lcd_t *lcd, int8_t step)
+{
+	if (lcd->Cgram)
+	{
+		lcd->Address = (lcd->Address + step) & 0x3F;
+	}
+	else if (!lcd->TwoLine)
+	{
+		lcd->Address = (lcd->Address + 80 + step) % 80;
+	}
+	else if (step > 0)
+	{
+		if (lcd->Address == 0x27) lcd->Address = 0x40;
+		else if (lcd->Address == 0x67) lcd->Address = 0x00;
+		else lcd->Address++;
+	}
+	else
+	{
+		if (lcd->Address == 0x00) lcd->Address = 0x67;
+		else if (lcd->Address == 0x40) lcd->Address = 0x27;
+		else lcd->Address--;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_EXECUTE(SIM_Lcd_t *, uint8_t, uint8_t)
+ *
+ * \brief Function to carry out one byte written to the controller
+ *
+ ******************************************************************************
+ */
+static void prvSIM_EXECUTE(SIM_Lcd_t *lcd, uint8_t rs, uint8_t data)
+{
+	uint64_t Time = SIM_T_INSTR;
+	uint8_t i;
+
+	if (rs)
+	{
+		/*! Data write to DDRAM or CGRAM */
+		if (lcd->Cgram) lcd->Cgram_[lcd->Address & 0x3F] = data;
+		else lcd->Ddram[lcd->Address & 0x7F] = data;
+
+		prvSIM_STEP_ADDRESS(lcd, lcd->Increment ? 1 : -1);
+
+		if (lcd->ShiftOnWrite && !lcd->Cgram)
+		{
+			lcd->Shift = (lcd->Shift + (lcd->Increment ? 1 : 39)) % 40;
+		}
+
+		SIM_Stats.DataWrites++;
+		Time = SIM_T_DATA;
+	}
+	else
+	{
+		SIM_Stats.Instructions++;
+
+		if (data & 0x80)
+		{
+			lcd->Address = data & 0x7F;
+			lcd->Cgram = 0;
+			if (lcd->TwoLine && ((lcd->Address & 0x3F) > 0x27))
+			{
+				prvSIM_VIOLATION(SIM_VIOLATION_BAD_ADDRESS, "set DDRAM address off both lines");
+			}
+		}
+		else if (data & 0x40)
+		{
+			lcd->Address = data & 0x3F;
+			lcd->Cgram = 1;
+		}
+		else if (data & 0x20)
+		{
+			lcd->Bus8Bit = (data >> 4) & 1;
+			lcd->TwoLine = (data >> 3) & 1;
+			lcd->Nibble = 0;
+			lcd->FunctionSet = 1;
+		}
+		else if (data & 0x10)
+		{
+			uint8_t Right = (data >> 2) & 1;
+
+			if (data & 0x08)
+			{
+				/*! Shift the display, the address counter stays */
+				lcd->Shift = (lcd->Shift + (Right ? 39 : 1)) % 40;
+			}
+			else
+			{
+				prvSIM_STEP_ADDRESS(lcd, Right ? 1 : -1);
+			}
+		}
+		else if (data & 0x08)
+		{
+			lcd->Display = data & 0x07;
+		}
+		else if (data & 0x04)
+		{
+			lcd->Increment = (data >> 1) & 1;
+			lcd->ShiftOnWrite = data & 1;
+		}
+		else if (data & 0x02)
+		{
+			lcd->Address = 0;
+			lcd->Cgram = 0;
+			lcd->Shift = 0;
+			Time = SIM_T_CLEAR;
+		}
+		else if (data & 0x01)
+		{
+			for (i = 0; i < 128; i++) lcd->Ddram[i] = ' ';
+			lcd->Address = 0;
+			lcd->Cgram = 0;
+			lcd->Shift = 0;
+			lcd->Increment = 1;
+			Time = SIM_T_CLEAR;
+		}
+	}
+
+	lcd->BusyUntil = SIM_Stats.Now + Time;
+	SIM_Stats.BusyTime += Time;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_READ_BYTE(SIM_Lcd_t *)
+ *
+ * \brief Function to work out the byte the controller drives for a read
+ *
+ ******************************************************************************
+ */
+static uint8_t prvSIM_READ_BYTE(SIM_Lcd_t *lcd)
+{
+	if (!lcd->Rs)
+	{
+		if (!lcd->FunctionSet)
+		{
+			prvSIM_VIOLATION(SIM_VIOLATION_EARLY_STATUS, "busy flag read before function set");
+		}
+
+		/*! Busy flag and address counter */
+		return ((SIM_Stats.Now < lcd->BusyUntil) ? 0x80 : 0x00) |
+			(lcd->Address & 0x7F);
+	}
+
+	if (SIM_Stats.Now < lcd->BusyUntil)
+	{
+		prvSIM_VIOLATION(SIM_VIOLATION_BUSY_READ, "data read while busy");
+	}
+
+	return lcd->Cgram ? lcd->Cgram_[lcd->Address & 0x3F] :
+		lcd->Ddram[lcd->Address & 0x7F];
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_E_RISE(SIM_Lcd_t *)
+ *
+ * \brief Function to handle E going high
+ *
+ ******************************************************************************
+ */
+static void prvSIM_E_RISE(SIM_Lcd_t *lcd)
+{
+	char Detail[64];
+
+	if (SIM_Stats.Strobes && (SIM_Stats.Now - lcd->Rose < SIM_T_CYCLE_E))
+	{
+		snprintf(Detail, sizeof(Detail), "E cycle %lluns",
+			(unsigned long long)(SIM_Stats.Now - lcd->Rose));
+		prvSIM_VIOLATION(SIM_VIOLATION_CYCLE_TIME, Detail);
+	}
+	if (SIM_Stats.Now - lcd->ControlChanged < SIM_T_AS)
+	{
+		prvSIM_VIOLATION(SIM_VIOLATION_ADDRESS_SETUP, "RS or R/W changed with E");
+	}
+
+	lcd->Rose = SIM_Stats.Now;
+	lcd->Contention = 0;
+	SIM_Stats.Strobes++;
+
+	if (lcd->Rw)
+	{
+		if (lcd->Bus8Bit || !lcd->Nibble)
+		{
+			lcd->Out = prvSIM_READ_BYTE(lcd);
+		}
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_E_FALL(SIM_Lcd_t *)
+ *
+ * \brief Function to handle E going low, which latches writes
+ *
+ ******************************************************************************
+ */
+static void prvSIM_E_FALL(SIM_Lcd_t *lcd)
+{
+	char Detail[64];
+	uint8_t Complete = 1;
+	uint8_t Byte = lcd->Bus;
+
+	if (SIM_Stats.Now - lcd->Rose < SIM_T_PW_EH)
+	{
+		snprintf(Detail, sizeof(Detail), "E high %lluns",
+			(unsigned long long)(SIM_Stats.Now - lcd->Rose));
+		prvSIM_VIOLATION(SIM_VIOLATION_PULSE_WIDTH, Detail);
+	}
+	lcd->Fell = SIM_Stats.Now;
+
+	/*! Nibble transfers pair up in 4-bit mode */
+	if (!lcd->Bus8Bit)
+	{
+		if (!lcd->Nibble)
+		{
+			lcd->High = lcd->Bus & 0xF0;
+			lcd->Nibble = 1;
+			Complete = 0;
+		}
+		else
+		{
+			Byte = lcd->High | (lcd->Bus >> 4);
+			lcd->Nibble = 0;
+		}
+	}
+
+	if (lcd->Rw)
+	{
+		if (Complete)
+		{
+			SIM_Stats.Reads++;
+			if (lcd->Rs)
+			{
+				/*! A data read moves the address counter like a write */
+				prvSIM_STEP_ADDRESS(lcd, lcd->Increment ? 1 : -1);
+				lcd->BusyUntil = SIM_Stats.Now + SIM_T_DATA;
+				SIM_Stats.BusyTime += SIM_T_DATA;
+			}
+		}
+		return;
+	}
+
+	if (SIM_Stats.Now - lcd->BusChanged < SIM_T_DSW)
+	{
+		prvSIM_VIOLATION(SIM_VIOLATION_DATA_SETUP, "data changed just before E fell");
+	}
+
+	/*! The first or only strobe of a byte decides whether it is taken */
+	if (lcd->Bus8Bit || !Complete)
+	{
+		lcd->Ignore = 0;
+		if (SIM_Stats.Now < lcd->BusyUntil)
+		{
+			snprintf(Detail, sizeof(Detail), "%s write %lluns early",
+				lcd->Rs ? "data" : "instruction",
+				(unsigned long long)(lcd->BusyUntil - SIM_Stats.Now));
+			prvSIM_VIOLATION(SIM_VIOLATION_BUSY_WRITE, Detail);
+			lcd->Ignore = 1;
+		}
+	}
+
+	if (Complete && !lcd->Ignore)
+	{
+		prvSIM_EXECUTE(lcd, lcd->Rs, Byte);
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_PINS(void)
+ *
+ * \brief Function to follow the pins every controller sees
+ *
+ * \details Each controller takes RS, R/W and the data pins as they are
+ *			and only sees its own E.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_PINS(void)
+{
+	uint8_t Control = SIM_Registers[SIM_PORTJ] & SIM_Registers[SIM_DDRJ];
+	uint8_t Reading = 0;
+	uint8_t n;
+
+	for (n = 0; n < SIM_DISPLAYS; n++)
+	{
+		prvSIM_PINS_ONE(&SIM_Lcds[n], Control, (Control >> (SIM_PIN_E + n)) & 1);
+		if (SIM_Lcds[n].E && SIM_Lcds[n].Rw) Reading++;
+	}
+
+	/*! Two controllers driving the data pins at once */
+	if ((Reading > 1) && !SIM_Clash)
+	{
+		SIM_Clash = 1;
+		prvSIM_VIOLATION(SIM_VIOLATION_CONTENTION, "two displays read at once");
+	}
+	else if (Reading <= 1)
+	{
+		SIM_Clash = 0;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_PINS_ONE(SIM_Lcd_t *, uint8_t, uint8_t)
+ *
+ * \brief Function to follow the pins one controller sees
+ *
+ ******************************************************************************
+ */
+static void prvSIM_PINS_ONE(SIM_Lcd_t *lcd, uint8_t control, uint8_t E)
+{
+	uint8_t Mask = (lcd->Wiring == SIM_WIRING_4BIT) ? 0xF0 : 0xFF;
+	uint8_t Rs = (control >> SIM_PIN_RS) & 1;
+	uint8_t Rw = (control >> SIM_PIN_RW) & 1;
+	uint8_t Bus = SIM_Registers[SIM_PORTK] & SIM_Registers[SIM_DDRK] & Mask;
+
+	if ((Rs != lcd->Rs) || (Rw != lcd->Rw))
+	{
+		lcd->ControlChanged = SIM_Stats.Now;
+	}
+	if (Bus != lcd->Bus)
+	{
+		lcd->BusChanged = SIM_Stats.Now;
+	}
+
+	lcd->Rs = Rs;
+	lcd->Rw = Rw;
+	lcd->Bus = Bus;
+
+	if (E && !lcd->E)
+	{
+		lcd->E = 1;
+		prvSIM_E_RISE(lcd);
+	}
+	else if (!E && lcd->E)
+	{
+		lcd->E = 0;
+		prvSIM_E_FALL(lcd);
+	}
+
+	if (lcd->E && lcd->Rw && !lcd->Contention &&
+		(SIM_Registers[SIM_DDRK] & Mask))
+	{
+		lcd->Contention = 1;
+		prvSIM_VIOLATION(SIM_VIOLATION_CONTENTION, "data pins driven during a read");
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_TIMER_COUNT(SIM_Timer_t *)
+ *
+ * \brief Function to work out the counter value now
+ *
+ ******************************************************************************
+ */
+static uint32_t prvSIM_TIMER_COUNT(SIM_Timer_t *timer)
+{
+	uint64_t Ticks;
+
+	if (!timer->Prescale) return timer->BaseCount;
+
+	Ticks = (SIM_Stats.Now - timer->Base) * (SIM_F_CPU / 1000000UL) /
+		(timer->Prescale * 1000UL);
+
+	return (uint32_t)((timer->BaseCount + Ticks) & 0xFFFF);
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_TIMER_SCHEDULE(SIM_Timer_t *, uint32_t)
+ *
+ * \brief Function to restart the counter at count and find the next match
+ *
+ ******************************************************************************
+ */
+static void prvSIM_TIMER_SCHEDULE(SIM_Timer_t *timer, uint32_t count)
+{
+	uint32_t Compare = SIM_Registers16[timer->Ocr];
+	uint32_t Ticks;
+
+	timer->Base = SIM_Stats.Now;
+	timer->BaseCount = count;
+
+	if (!timer->Prescale)
+	{
+		timer->Match = UINT64_MAX;
+		return;
+	}
+
+	Ticks = (Compare >= count) ? (Compare - count) : (65536 - count + Compare);
+	if (!Ticks) Ticks = 65536;
+
+	timer->Match = SIM_Stats.Now + (uint64_t)Ticks * timer->Prescale * 1000UL /
+		(SIM_F_CPU / 1000000UL);
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_TIMER_WRITTEN(SIM_Timer_t *)
+ *
+ * \brief Function to pick up writes to the timer registers
+ *
+ ******************************************************************************
+ */
+static void prvSIM_TIMER_WRITTEN(SIM_Timer_t *timer)
+{
+	static const uint32_t Prescales[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+	uint8_t Changed = 0;
+	uint32_t Count = prvSIM_TIMER_COUNT(timer);
+
+	if (SIM_Registers[timer->Tccrb] != SIM_Last[timer->Tccrb])
+	{
+		timer->Prescale = Prescales[SIM_Registers[timer->Tccrb] & 0x07];
+		Changed = 1;
+	}
+	if (SIM_Registers16[timer->Tcnt] != SIM_Last16[timer->Tcnt])
+	{
+		Count = SIM_Registers16[timer->Tcnt];
+		Changed = 1;
+	}
+	if (SIM_Registers16[timer->Ocr] != SIM_Last16[timer->Ocr])
+	{
+		Changed = 1;
+	}
+
+	if (Changed)
+	{
+		prvSIM_TIMER_SCHEDULE(timer, Count);
+	}
+
+	/*! Flags are cleared by writing ones, or here by reading them */
+	if (SIM_Registers[timer->Tifr] != SIM_Last[timer->Tifr])
+	{
+		SIM_Registers[timer->Tifr] = SIM_Last[timer->Tifr] & ~SIM_Registers[timer->Tifr];
+	}
+	else if (SIM_FlagsRead[timer->Tifr])
+	{
+		SIM_Registers[timer->Tifr] = 0;
+	}
+	SIM_FlagsRead[timer->Tifr] = 0;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_SYNC(void)
+ *
+ * \brief Function to apply the last register access to the model
+ *
+ ******************************************************************************
+ */
+static void prvSIM_SYNC(void)
+{
+	uint8_t i;
+
+	if ((SIM_Registers[SIM_PORTK] != SIM_Last[SIM_PORTK]) ||
+		(SIM_Registers[SIM_DDRK] != SIM_Last[SIM_DDRK]) ||
+		(SIM_Registers[SIM_PORTJ] != SIM_Last[SIM_PORTJ]) ||
+		(SIM_Registers[SIM_DDRJ] != SIM_Last[SIM_DDRJ]))
+	{
+		prvSIM_PINS();
+	}
+
+	for (i = 0; i < 2; i++)
+	{
+		prvSIM_TIMER_WRITTEN(&SIM_Timers[i]);
+	}
+
+	for (i = 0; i < SIM_REGISTERS; i++) SIM_Last[i] = SIM_Registers[i];
+	for (i = 0; i < SIM_REGISTERS16; i++) SIM_Last16[i] = SIM_Registers16[i];
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_DISPATCH(void)
+ *
+ * \brief Function to run a pending compare match handler
+ *
+ * \returns Virtual time the handler took
+ *
+ ******************************************************************************
+ */
+static uint64_t prvSIM_DISPATCH(void)
+{
+	uint64_t Start = SIM_Stats.Now;
+	uint8_t i;
+
+	if (SIM_InIsr || !(SIM_Registers[SIM_SREG] & (1 << 7))) return 0;
+
+	for (i = 0; i < 2; i++)
+	{
+		SIM_Timer_t *Timer = &SIM_Timers[i];
+
+		if ((SIM_Registers[Timer->Tifr] & 0x02) &&
+			(SIM_Registers[Timer->Timsk] & 0x02) && Timer->Isr)
+		{
+			/*! Entering the handler clears the flag and the I bit */
+			SIM_Registers[Timer->Tifr] &= ~0x02;
+			SIM_Last[Timer->Tifr] = SIM_Registers[Timer->Tifr];
+			SIM_Registers[SIM_SREG] &= ~(1 << 7);
+			SIM_Last[SIM_SREG] = SIM_Registers[SIM_SREG];
+			SIM_InIsr = 1;
+
+			Timer->Isr();
+			prvSIM_SYNC();
+
+			SIM_InIsr = 0;
+			SIM_Registers[SIM_SREG] |= (1 << 7);
+			SIM_Last[SIM_SREG] = SIM_Registers[SIM_SREG];
+		}
+	}
+
+	return SIM_Stats.Now - Start;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_ADVANCE(uint64_t)
+ *
+ * \brief Function to move the virtual clock, firing timer matches on the way
+ *
+ * \details Time spent in interrupt handlers is added on top, as it would
+ *			stretch a cycle counted delay on the hardware.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_ADVANCE(uint64_t ns)
+{
+	uint64_t Target = SIM_Stats.Now + ns;
+	uint8_t i;
+	uint8_t Fired;
+
+	do
+	{
+		Target += prvSIM_DISPATCH();
+		Fired = 0;
+
+		for (i = 0; i < 2; i++)
+		{
+			SIM_Timer_t *Timer = &SIM_Timers[i];
+
+			if (Timer->Match <= Target)
+			{
+				if (Timer->Match > SIM_Stats.Now) SIM_Stats.Now = Timer->Match;
+
+				SIM_Registers[Timer->Tifr] |= 0x02;
+				SIM_Last[Timer->Tifr] = SIM_Registers[Timer->Tifr];
+
+				/*! CTC mode clears the counter on the tick after the match */
+				if (SIM_Registers[Timer->Tccrb] & (1 << 3))
+				{
+					SIM_Stats.Now += Timer->Prescale * 1000UL / (SIM_F_CPU / 1000000UL);
+					prvSIM_TIMER_SCHEDULE(Timer, 0);
+				}
+				else
+				{
+					prvSIM_TIMER_SCHEDULE(Timer, SIM_Registers16[Timer->Ocr]);
+				}
+
+				Fired = 1;
+			}
+		}
+	} while (Fired);
+
+	if (SIM_Stats.Now < Target) SIM_Stats.Now = Target;
+}
+
+/*****************************************************************************/
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_MCU_RESET(uint8_t)
+ *
+ * \brief Function to put the registers in their reset state
+ *
+ * \details Every pin becomes an input and the timers stop. The reset
+ *			flags are added to MCUSR, which keeps the ones already set.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_MCU_RESET(uint8_t flags)
+{
+	uint8_t i;
+
+	flags = flags | SIM_Registers[SIM_MCUSR];
+
+	for (i = 0; i < SIM_REGISTERS; i++)
+	{
+		SIM_Registers[i] = 0;
+		SIM_Last[i] = 0;
+		SIM_FlagsRead[i] = 0;
+	}
+	for (i = 0; i < SIM_REGISTERS16; i++)
+	{
+		SIM_Registers16[i] = 0;
+		SIM_Last16[i] = 0;
+	}
+
+	SIM_Registers[SIM_MCUSR] = flags;
+	SIM_Last[SIM_MCUSR] = flags;
+
+	/*! The program starts again in main, before the scheduler */
+	SIM_Scheduler = SIM_SCHEDULER_NOT_STARTED;
+
+	SIM_Timers[0] = (SIM_Timer_t){ SIM_TCCR3B, SIM_TIMSK3, SIM_TIFR3,
+		SIM_TCNT3, SIM_OCR3A, 0, 0, 0, UINT64_MAX, vSIM_TIMER3_COMPA_ISR };
+	SIM_Timers[1] = (SIM_Timer_t){ SIM_TCCR5B, SIM_TIMSK5, SIM_TIFR5,
+		SIM_TCNT5, SIM_OCR5A, 0, 0, 0, UINT64_MAX, vSIM_TIMER5_COMPA_ISR };
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_LCD_POWER(SIM_Lcd_t *, uint8_t)
+ *
+ * \brief Function to put one controller in its power on state
+ *
+ ******************************************************************************
+ */
+static void prvSIM_LCD_POWER(SIM_Lcd_t *lcd, uint8_t wiring)
+{
+	uint8_t i;
+
+	*lcd = (SIM_Lcd_t){ 0 };
+	lcd->Wiring = wiring;
+	lcd->Bus8Bit = 1;
+	lcd->Increment = 1;
+	lcd->BusyUntil = SIM_Stats.Now + SIM_T_POWER_ON;
+	for (i = 0; i < 128; i++) lcd->Ddram[i] = ' ';
+}
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/****************************/
+/*Simulator Public Functions*/
+/****************************/
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_INIT(uint8_t)
+ *
+ * \brief Function to power up the model
+ *
+ * \details Starts the clock at 0 with the controller in its power on
+ *			state: 8-bit interface, one line, display off, DDRAM blank and
+ *			busy for SIM_T_POWER_ON. All SIM_DISPLAYS controllers are
+ *			powered up together, and MCUSR holds PORF.
+ *
+ * \params[in] wiring - SIM_WIRING_8BIT or SIM_WIRING_4BIT
+ *
+ ******************************************************************************
+ */
+void vSIM_INIT(uint8_t wiring)
+{
+	uint8_t n;
+
+	SIM_Registers[SIM_MCUSR] = 0;
+	prvSIM_MCU_RESET(1 << 0);	// PORF
+
+	SIM_Stats = (SIM_Stats_t){ 0 };
+
+	for (n = 0; n < SIM_DISPLAYS; n++)
+	{
+		prvSIM_LCD_POWER(&SIM_Lcds[n], wiring);
+	}
+	SIM_Shown = &SIM_Lcds[0];
+	SIM_Clash = 0;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_MCU_RESET(uint8_t)
+ *
+ * \brief Function to reset the MCU with the controllers left powered
+ *
+ * \details As a watchdog, external or brown out reset leaves them: the
+ *			pins float, so each controller sees E, RS and R/W low and keeps
+ *			its DDRAM, CGRAM, interface mode and any half received byte.
+ *			The program's variables are not touched, the caller sets them
+ *			back to their start values.
+ *
+ * \params[in] flags - MCUSR bits of the reset cause, (1 << WDRF) for example
+ *
+ ******************************************************************************
+ */
+void vSIM_MCU_RESET(uint8_t flags)
+{
+	prvSIM_SYNC();
+	prvSIM_MCU_RESET(flags);
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_POWER_CYCLE(void)
+ *
+ * \brief Function to power the MCU and the controllers off and on again
+ *
+ * \details The clock and counters keep running. Each controller comes
+ *			back in its power on state, busy for SIM_T_POWER_ON, and MCUSR
+ *			holds only PORF.
+ *
+ ******************************************************************************
+ */
+void vSIM_POWER_CYCLE(void)
+{
+	uint8_t n;
+
+	prvSIM_SYNC();
+	SIM_Registers[SIM_MCUSR] = 0;
+	prvSIM_MCU_RESET(1 << 0);	// PORF
+
+	for (n = 0; n < SIM_DISPLAYS; n++)
+	{
+		prvSIM_LCD_POWER(&SIM_Lcds[n], SIM_Lcds[n].Wiring);
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_REGISTER(uint8_t)
+ *
+ * \brief Function behind every 8-bit register access
+ *
+ * \returns Where the program reads or writes the register
+ *
+ ******************************************************************************
+ */
+volatile uint8_t *xSIM_REGISTER(uint8_t reg)
+{
+	prvSIM_SYNC();
+	prvSIM_ADVANCE(SIM_ACCESS_NS);
+
+	if (reg == SIM_PINK)
+	{
+		uint8_t Driven = 0;
+		uint8_t Value = 0;
+		uint8_t n;
+
+		/*! A controller drives the data pins while its E is high for a read */
+		for (n = 0; n < SIM_DISPLAYS; n++)
+		{
+			SIM_Lcd_t *Lcd = &SIM_Lcds[n];
+			uint8_t Mask = (Lcd->Wiring == SIM_WIRING_4BIT) ? 0xF0 : 0xFF;
+
+			if (Lcd->E && Lcd->Rw)
+			{
+				Driven = Mask & ~SIM_Registers[SIM_DDRK];
+				Value = Lcd->Out;
+				if (!Lcd->Bus8Bit && Lcd->Nibble) Value = Value << 4;
+				if (SIM_Stats.Now - Lcd->Rose < SIM_T_DDR)
+				{
+					prvSIM_VIOLATION(SIM_VIOLATION_READ_EARLY, "data pins read before valid");
+				}
+			}
+		}
+
+		SIM_Registers[SIM_PINK] = (SIM_Registers[SIM_PORTK] & ~Driven) | (Value & Driven);
+		SIM_Last[SIM_PINK] = SIM_Registers[SIM_PINK];
+	}
+	else if ((reg == SIM_TIFR3) || (reg == SIM_TIFR5))
+	{
+		SIM_FlagsRead[reg] = 1;
+	}
+
+	return &SIM_Registers[reg];
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_REGISTER16(uint8_t)
+ *
+ * \brief Function behind every 16-bit register access
+ *
+ * \returns Where the program reads or writes the register
+ *
+ ******************************************************************************
+ */
+volatile uint16_t *xSIM_REGISTER16(uint8_t reg)
+{
+	prvSIM_SYNC();
+	prvSIM_ADVANCE(SIM_ACCESS_NS);
+
+	if (reg == SIM_TCNT3)
+	{
+		SIM_Registers16[reg] = prvSIM_TIMER_COUNT(&SIM_Timers[0]);
+		SIM_Last16[reg] = SIM_Registers16[reg];
+	}
+	else if (reg == SIM_TCNT5)
+	{
+		SIM_Registers16[reg] = prvSIM_TIMER_COUNT(&SIM_Timers[1]);
+		SIM_Last16[reg] = SIM_Registers16[reg];
+	}
+
+	return &SIM_Registers16[reg];
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_DELAY_NS(uint64_t)
+ *
+ * \brief Function behind _delay_us and _delay_ms
+ *
+ ******************************************************************************
+ */
+void vSIM_DELAY_NS(uint64_t ns)
+{
+	prvSIM_SYNC();
+	prvSIM_ADVANCE(ns);
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_CLI(void), vSIM_SEI(void)
+ *
+ * \brief Functions behind cli and sei
+ *
+ ******************************************************************************
+ */
+void vSIM_CLI(void)
+{
+	prvSIM_SYNC();
+	SIM_Registers[SIM_SREG] &= ~(1 << 7);
+	SIM_Last[SIM_SREG] = SIM_Registers[SIM_SREG];
+	prvSIM_ADVANCE(SIM_ACCESS_NS / 2);
+}
+
+void vSIM_SEI(void)
+{
+	prvSIM_SYNC();
+	SIM_Registers[SIM_SREG] |= (1 << 7);
+	SIM_Last[SIM_SREG] = SIM_Registers[SIM_SREG];
+	prvSIM_ADVANCE(SIM_ACCESS_NS / 2);
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_TASK_DELAY(uint32_t, uint32_t)
+ *
+ * \brief Function behind vTaskDelay
+ *
+ * \details The calling task wakes on the given number of ticks, the
+ *			first of them the next multiple of tick_ns on the virtual
+ *			clock. The clock moves on to it and the time is counted as
+ *			blocked, when other tasks or idle would have had the CPU.
+ *
+ ******************************************************************************
+ */
+void vSIM_TASK_DELAY(uint32_t ticks, uint32_t tick_ns)
+{
+	uint64_t Wake;
+
+	prvSIM_SYNC();
+
+	if (ticks == 0) return;
+
+	Wake = (SIM_Stats.Now / tick_ns + ticks) * tick_ns;
+	SIM_Stats.BlockedTime += Wake - SIM_Stats.Now;
+	prvSIM_ADVANCE(Wake - SIM_Stats.Now);
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_SET_SCHEDULER(uint8_t), xSIM_GET_SCHEDULER(void)
+ *
+ * \brief Functions to set and read the RTOS scheduler state
+ *
+ * \details Behind xTaskGetSchedulerState. An MCU reset sets it back to
+ *			SIM_SCHEDULER_NOT_STARTED.
+ *
+ ******************************************************************************
+ */
+void vSIM_SET_SCHEDULER(uint8_t state)
+{
+	SIM_Scheduler = state;
+}
+
+uint8_t xSIM_GET_SCHEDULER(void)
+{
+	return SIM_Scheduler;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_ENTER_CRITICAL(void), vSIM_EXIT_CRITICAL(void)
+ *
+ * \brief Functions behind taskENTER_CRITICAL and taskEXIT_CRITICAL
+ *
+ * \details As the ATmega port does it: SREG is saved and interrupts turned
+ *			off, and the saved SREG is put back on the way out.
+ *
+ ******************************************************************************
+ */
+void vSIM_ENTER_CRITICAL(void)
+{
+	prvSIM_SYNC();
+	SIM_Critical[SIM_CriticalDepth++] = SIM_Registers[SIM_SREG];
+	vSIM_CLI();
+}
+
+void vSIM_EXIT_CRITICAL(void)
+{
+	prvSIM_SYNC();
+	SIM_Registers[SIM_SREG] = SIM_Critical[--SIM_CriticalDepth];
+	SIM_Last[SIM_SREG] = SIM_Registers[SIM_SREG];
+	prvSIM_ADVANCE(SIM_ACCESS_NS / 2);
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_TASK_ENTRY(void)
+ *
+ * \brief Function the task context starts in
+ *
+ ******************************************************************************
+ */
+static void prvSIM_TASK_ENTRY(void)
+{
+	SIM_Task(SIM_TaskParameters);
+
+	/*! A FreeRTOS task must not return, stop the run here if it does */
+	printf("  ! task returned\n");
+	exit(1);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_TASK_CREATE(void (*)(void *), void *)
+ *
+ * \brief Function behind xTaskCreate
+ *
+ * \details The model has room for one task. It does not start until the
+ *			simulator run calls vSIM_TASK_RUN or blocks on a full queue,
+ *			as a task of lower priority than the run would.
+ *
+ * \returns 1, or 0 if a task was already created
+ *
+ ******************************************************************************
+ */
+uint8_t xSIM_TASK_CREATE(void (*task)(void *), void *parameters)
+{
+	if (SIM_Task) return 0;
+
+	SIM_Task = task;
+	SIM_TaskParameters = parameters;
+
+	getcontext(&SIM_TaskContext);
+	SIM_TaskContext.uc_stack.ss_sp = SIM_TaskStack;
+	SIM_TaskContext.uc_stack.ss_size = SIM_TASK_STACK;
+	SIM_TaskContext.uc_link = NULL;
+	makecontext(&SIM_TaskContext, prvSIM_TASK_ENTRY, 0);
+
+	return 1;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_TASK_RUN(uint64_t)
+ *
+ * \brief Function to let the task run for a stretch of virtual time
+ *
+ * \details The task runs until it blocks with nothing to wake it in the
+ *			stretch, and the clock then moves on to the end of it as idle.
+ *			When the task makes room for a waiting sender it returns at
+ *			once instead, as the sender has the higher priority. Without a
+ *			task the whole stretch is idle.
+ *
+ * \params[in] ns - length of the stretch
+ *
+ ******************************************************************************
+ */
+void vSIM_TASK_RUN(uint64_t ns)
+{
+	prvSIM_SYNC();
+	SIM_TaskUntil = SIM_Stats.Now + ns;
+
+	if (SIM_Task && !SIM_InTask)
+	{
+		SIM_InTask = 1;
+		SIM_TaskPreempted = 0;
+		swapcontext(&SIM_RunContext, &SIM_TaskContext);
+		SIM_InTask = 0;
+		prvSIM_SYNC();
+
+		if (SIM_TaskPreempted) return;
+	}
+
+	if (SIM_TaskUntil > SIM_Stats.Now)
+		prvSIM_ADVANCE(SIM_TaskUntil - SIM_Stats.Now);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_TICK_COUNT(uint32_t)
+ *
+ * \brief Function behind xTaskGetTickCount
+ *
+ ******************************************************************************
+ */
+uint32_t xSIM_TICK_COUNT(uint32_t tick_ns)
+{
+	prvSIM_SYNC();
+	return (uint32_t)(SIM_Stats.Now / tick_ns);
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_QUEUE_CREATE(uint8_t, uint16_t)
+ *
+ * \brief Function behind xQueueCreate
+ *
+ * \returns The queue, or NULL if there was no memory for it
+ *
+ ******************************************************************************
+ */
+SIM_Queue_t *xSIM_QUEUE_CREATE(uint8_t length, uint16_t size)
+{
+	SIM_Queue_t *Queue = malloc(sizeof(SIM_Queue_t) + (size_t)length * size);
+
+	if (Queue == NULL) return NULL;
+
+	Queue->Items = (uint8_t *)(Queue + 1);
+	Queue->Size = size;
+	Queue->Length = length;
+	Queue->Head = 0;
+	Queue->Count = 0;
+
+	return Queue;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_QUEUE_SEND(SIM_Queue_t *, const void *, uint32_t, uint32_t)
+ *
+ * \brief Function behind xQueueSendToBack
+ *
+ * \details While the queue is full the simulator run waits for the task
+ *			to take an item, up to the given ticks. The task itself cannot
+ *			wait on a queue only it empties, so it fails at once.
+ *
+ * \returns 1, or 0 if the queue stayed full
+ *
+ ******************************************************************************
+ */
+uint8_t xSIM_QUEUE_SEND(SIM_Queue_t *queue, const void *item, uint32_t ticks,
+	uint32_t tick_ns)
+{
+	uint64_t Wake = UINT64_MAX;
+
+	prvSIM_SYNC();
+
+	if (ticks != SIM_MAX_DELAY)
+		Wake = (SIM_Stats.Now / tick_ns + ticks) * tick_ns;
+
+	while (queue->Count == queue->Length)
+	{
+		if (SIM_InTask || SIM_Task == NULL || Wake <= SIM_Stats.Now) return 0;
+
+		SIM_SendWaiting = 1;
+		vSIM_TASK_RUN(Wake - SIM_Stats.Now);
+		SIM_SendWaiting = 0;
+	}
+
+	memcpy(&queue->Items[((queue->Head + queue->Count) % queue->Length) *
+		queue->Size], item, queue->Size);
+	queue->Count++;
+
+	return 1;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_QUEUE_RECEIVE(SIM_Queue_t *, void *, uint32_t, uint32_t)
+ *
+ * \brief Function behind xQueueReceive
+ *
+ * \details A task waiting on an empty queue wakes on the given number of
+ *			ticks as in vSIM_TASK_DELAY, if that falls in its stretch;
+ *			otherwise it hands the CPU back to the simulator run and waits
+ *			on when it is run again. The simulator run never waits.
+ *
+ * \returns 1, or 0 if the queue stayed empty
+ *
+ ******************************************************************************
+ */
+uint8_t xSIM_QUEUE_RECEIVE(SIM_Queue_t *queue, void *item, uint32_t ticks,
+	uint32_t tick_ns)
+{
+	uint64_t Wake = UINT64_MAX;
+
+	prvSIM_SYNC();
+
+	if (ticks != SIM_MAX_DELAY)
+		Wake = (SIM_Stats.Now / tick_ns + ticks) * tick_ns;
+
+	while (queue->Count == 0)
+	{
+		if (!SIM_InTask) return 0;
+
+		if (Wake <= SIM_TaskUntil)
+		{
+			if (Wake > SIM_Stats.Now) prvSIM_ADVANCE(Wake - SIM_Stats.Now);
+			return 0;
+		}
+
+		swapcontext(&SIM_TaskContext, &SIM_RunContext);
+		prvSIM_SYNC();
+	}
+
+	memcpy(item, &queue->Items[queue->Head * queue->Size], queue->Size);
+	queue->Head = (queue->Head + 1) % queue->Length;
+	queue->Count--;
+
+	/*! The sender waiting for room runs first */
+	if (SIM_InTask && SIM_SendWaiting)
+	{
+		SIM_TaskPreempted = 1;
+		swapcontext(&SIM_TaskContext, &SIM_RunContext);
+		prvSIM_SYNC();
+	}
+
+	return 1;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_QUEUE_WAITING(SIM_Queue_t *)
+ *
+ * \brief Function behind uxQueueMessagesWaiting
+ *
+ ******************************************************************************
+ */
+uint8_t xSIM_QUEUE_WAITING(SIM_Queue_t *queue)
+{
+	return queue->Count;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_GET_STATS(SIM_Stats_t *)
+ *
+ * \brief Function to copy the model counters
+ *
+ ******************************************************************************
+ */
+void vSIM_GET_STATS(SIM_Stats_t *stats)
+{
+	prvSIM_SYNC();
+	*stats = SIM_Stats;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_GET_LINE(uint8_t, char *)
+ *
+ * \brief Function to copy the 24 visible characters of one line
+ *
+ * \details Follows the display shift. text must hold 25 characters.
+ *
+ ******************************************************************************
+ */
+void vSIM_GET_LINE(uint8_t line, char *text)
+{
+	uint8_t i;
+
+	prvSIM_SYNC();
+
+	for (i = 0; i < 24; i++)
+	{
+		text[i] = SIM_Shown->Ddram[(line ? 0x40 : 0x00) + ((i + SIM_Shown->Shift) % 40)];
+	}
+	text[24] = '\0';
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_GET_DDRAM(uint8_t), xSIM_GET_CGRAM(uint8_t), xSIM_GET_ADDRESS(void),
+ *		xSIM_GET_DISPLAY(void)
+ *
+ * \brief Functions to look inside the controller without a bus cycle
+ *
+ ******************************************************************************
+ */
+uint8_t xSIM_GET_DDRAM(uint8_t address)
+{
+	prvSIM_SYNC();
+	return SIM_Shown->Ddram[address & 0x7F];
+}
+
+uint8_t xSIM_GET_CGRAM(uint8_t address)
+{
+	prvSIM_SYNC();
+	return SIM_Shown->Cgram_[address & 0x3F];
+}
+
+uint8_t xSIM_GET_ADDRESS(void)
+{
+	prvSIM_SYNC();
+	return SIM_Shown->Address;
+}
+
+uint8_t xSIM_GET_DISPLAY(void)
+{
+	prvSIM_SYNC();
+	return SIM_Shown->Display;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_UPSET(uint8_t, uint8_t)
+ *
+ * \brief Function to change one DDRAM cell without a bus cycle
+ *
+ * \details Stands in for interference on the glass or a glitch on E that
+ *			the library does not know about.
+ *
+ ******************************************************************************
+ */
+void vSIM_UPSET(uint8_t address, uint8_t value)
+{
+	prvSIM_SYNC();
+	SIM_Shown->Ddram[address & 0x7F] = value;
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_SELECT(uint8_t)
+ *
+ * \brief Function to pick the display the inspection functions look at
+ *
+ * \details vSIM_GET_LINE, xSIM_GET_DDRAM, xSIM_GET_CGRAM and 
+ *			xSIM_GET_ADDRESS look at display 0 until this is called.
+ *
+ * \params[in] display - 0 to SIM_DISPLAYS - 1, E on PJ2 to PJ7
+ *
+ ******************************************************************************
+ */
+void vSIM_SELECT(uint8_t display)
+{
+	if (display < SIM_DISPLAYS) SIM_Shown = &SIM_Lcds[display];
+}
+
+/*!****************************************************************************
+ *
+ * \fn vSIM_SET_VERBOSE(uint8_t)
+ *
+ * \brief Function to print every violation as it happens, on by default
+ *
+ ******************************************************************************
+ */
+void vSIM_SET_VERBOSE(uint8_t verbose)
+{
+	SIM_Verbose = verbose;
+}
+
+/*!****************************************************************************
+ *
+ * \fn xSIM_VIOLATION_NAME(uint8_t)
+ *
+ * \brief Function to name a violation type
+ *
+ ******************************************************************************
+ */
+const char *xSIM_VIOLATION_NAME(uint8_t type)
+{
+	static const char *Names[SIM_VIOLATIONS] =
+	{
+		"write while busy",
+		"data read while busy",
+		"E pulse too short",
+		"E cycle too short",
+		"address setup",
+		"data setup",
+		"read before data valid",
+		"bus contention",
+		"bad DDRAM address",
+		"busy flag read before function set"
+	};
+
+	return (type < SIM_VIOLATIONS) ? Names[type] : "unknown";
+}
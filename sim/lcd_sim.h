@@ -0,0 +1,209 @@
+/*!****************************************************************************
+ *
+ * \file lcd_sim.h
+ *
+ * \brief Host model of the KS0066U and the ATmega2560 registers it uses
+ *
+ * \author
+ *
+ * \details The stub avr/io.h in this directory turns every register access
+ *			of the library into a call to xSIM_REGISTER, which applies the
+ *			previous access to the model and advances a virtual clock. The
+ *			model latches on the edges of E the way the controller does,
+ *			keeps DDRAM, CGRAM and the busy time of each instruction, and
+ *			records every timing rule the library breaks. Up to
+ *			SIM_DISPLAYS controllers share the bus, each on its own E pin.
+ *
+ * Modification History:
+ * 10/18/2026 - Added a task, queues and critical sections
+ * 10/18/2026 - Flag busy flag reads before the function set
+ * 10/18/2026 - Added RTOS scheduler state and blocking task delays
+ * 10/18/2026 - Added DDRAM upsets
+ * 10/18/2026 - Added MCU resets and power cycles
+ * 10/18/2026 - Callable from C++
+ * 10/18/2026 - Added displays on PJ3 to PJ7
+ * 10/18/2026 - Added CGRAM read back
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef LCD_SIM_H
+#define LCD_SIM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************/
+/*************************/
+/*Simulator Definitions*/
+/*************************/
+
+/*! Registers the library touches */
+#define SIM_PORTK		0
+#define SIM_DDRK		1
+#define SIM_PINK		2
+#define SIM_PORTJ		3
+#define SIM_DDRJ		4
+#define SIM_PINJ		5
+#define SIM_SREG		6
+#define SIM_TCCR3A		7
+#define SIM_TCCR3B		8
+#define SIM_TIMSK3		9
+#define SIM_TIFR3		10
+#define SIM_TCCR5A		11
+#define SIM_TCCR5B		12
+#define SIM_TIMSK5		13
+#define SIM_TIFR5		14
+#define SIM_MCUSR		15
+#define SIM_REGISTERS	16
+
+/*! 16-bit timer registers */
+#define SIM_TCNT3		0
+#define SIM_OCR3A		1
+#define SIM_TCNT5		2
+#define SIM_OCR5A		3
+#define SIM_REGISTERS16	4
+
+/*! How the display is wired to PORTK */
+#define SIM_WIRING_8BIT	0	// D0-D7 on PK0-PK7
+#define SIM_WIRING_4BIT	1	// D4-D7 on PK4-PK7, D0-D3 not connected
+
+/*! Displays on the bus, each with E on its own PORTJ pin from PJ2 up */
+#define SIM_DISPLAYS	6
+
+/*! Scheduler states, the values of FreeRTOS taskSCHEDULER_ */
+#define SIM_SCHEDULER_SUSPENDED		0
+#define SIM_SCHEDULER_NOT_STARTED	1
+#define SIM_SCHEDULER_RUNNING		2
+
+/*! Wait that never times out, the FreeRTOS portMAX_DELAY */
+#define SIM_MAX_DELAY	0xFFFFUL
+
+/*! CPU time of one register access, two cycles at 16MHz */
+#define SIM_ACCESS_NS	125
+/*! CPU clock used for the timers */
+#define SIM_F_CPU		16000000UL
+
+/*! KS0066U bus timing at VDD 4.5V to 5.5V, in ns */
+#define SIM_T_CYCLE_E	500		// E cycle time
+#define SIM_T_PW_EH		230		// E high pulse width
+#define SIM_T_AS		40		// RS and R/W set up before E rises
+#define SIM_T_DSW		80		// write data set up before E falls
+#define SIM_T_DDR		160		// read data valid after E rises
+
+/*! KS0066U execution times at 270kHz, in ns */
+#define SIM_T_POWER_ON	30000000UL	// wait after power on
+#define SIM_T_CLEAR		1530000UL	// clear display and return home
+#define SIM_T_INSTR		39000UL		// other instructions
+#define SIM_T_DATA		43000UL		// data read or write
+
+/*! Timing rules the model checks */
+#define SIM_VIOLATION_BUSY_WRITE	0	// write while the controller was busy
+#define SIM_VIOLATION_BUSY_READ		1	// data read while the controller was busy
+#define SIM_VIOLATION_PULSE_WIDTH	2	// E high for less than SIM_T_PW_EH
+#define SIM_VIOLATION_CYCLE_TIME	3	// E rose again within SIM_T_CYCLE_E
+#define SIM_VIOLATION_ADDRESS_SETUP	4	// RS or R/W changed within SIM_T_AS of E rising
+#define SIM_VIOLATION_DATA_SETUP	5	// data changed within SIM_T_DSW of E falling
+#define SIM_VIOLATION_READ_EARLY	6	// PIN read within SIM_T_DDR of E rising
+#define SIM_VIOLATION_CONTENTION	7	// MCU and controller both drove the bus
+#define SIM_VIOLATION_BAD_ADDRESS	8	// set DDRAM address outside both lines
+#define SIM_VIOLATION_EARLY_STATUS	9	// busy flag read before the first function set
+#define SIM_VIOLATIONS				10
+
+/*! Counters kept by the model, all times in ns of virtual time */
+typedef struct
+{
+	uint64_t Now;				// virtual clock
+	uint64_t BusyTime;			// controller execution time started
+	uint64_t BlockedTime;		// time a task was blocked in vTaskDelay
+	uint32_t Instructions;		// instructions executed
+	uint32_t DataWrites;		// data bytes written to DDRAM or CGRAM
+	uint32_t Reads;				// busy flag and data reads
+	uint32_t Strobes;			// E pulses
+	uint32_t Violations[SIM_VIOLATIONS];
+} SIM_Stats_t;
+
+/*! A FreeRTOS queue, fixed size items copied in and out of a ring */
+typedef struct
+{
+	uint8_t *Items;
+	uint16_t Size;				// bytes in one item
+	uint8_t Length;				// items it holds
+	uint8_t Head;				// oldest item
+	uint8_t Count;				// items waiting
+} SIM_Queue_t;
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*********************************/
+/*Simulator Function Prototypes*/
+/*********************************/
+
+/*! Function to power up the model */
+void vSIM_INIT(uint8_t wiring);
+/*! Function behind every 8-bit register access */
+volatile uint8_t *xSIM_REGISTER(uint8_t reg);
+/*! Function behind every 16-bit register access */
+volatile uint16_t *xSIM_REGISTER16(uint8_t reg);
+/*! Function behind _delay_us and _delay_ms */
+void vSIM_DELAY_NS(uint64_t ns);
+/*! Functions behind cli and sei */
+void vSIM_CLI(void);
+void vSIM_SEI(void);
+/*! Function behind vTaskDelay */
+void vSIM_TASK_DELAY(uint32_t ticks, uint32_t tick_ns);
+/*! Functions to set and read the RTOS scheduler state */
+void vSIM_SET_SCHEDULER(uint8_t state);
+uint8_t xSIM_GET_SCHEDULER(void);
+/*! Functions behind taskENTER_CRITICAL and taskEXIT_CRITICAL */
+void vSIM_ENTER_CRITICAL(void);
+void vSIM_EXIT_CRITICAL(void);
+/*! Function behind xTaskCreate, the model runs one task */
+uint8_t xSIM_TASK_CREATE(void (*task)(void *), void *parameters);
+/*! Function to let the task run for a stretch of virtual time */
+void vSIM_TASK_RUN(uint64_t ns);
+/*! Function behind xTaskGetTickCount */
+uint32_t xSIM_TICK_COUNT(uint32_t tick_ns);
+/*! Functions behind xQueueCreate, xQueueSendToBack, xQueueReceive and
+ *	uxQueueMessagesWaiting */
+SIM_Queue_t *xSIM_QUEUE_CREATE(uint8_t length, uint16_t size);
+uint8_t xSIM_QUEUE_SEND(SIM_Queue_t *queue, const void *item, uint32_t ticks,
+	uint32_t tick_ns);
+uint8_t xSIM_QUEUE_RECEIVE(SIM_Queue_t *queue, void *item, uint32_t ticks,
+	uint32_t tick_ns);
+uint8_t xSIM_QUEUE_WAITING(SIM_Queue_t *queue);
+/*! Function to copy the model counters */
+void vSIM_GET_STATS(SIM_Stats_t *stats);
+/*! Function to copy the visible characters of one line */
+void vSIM_GET_LINE(uint8_t line, char *text);
+/*! Function to read one DDRAM cell */
+uint8_t xSIM_GET_DDRAM(uint8_t address);
+/*! Function to read one CGRAM row */
+uint8_t xSIM_GET_CGRAM(uint8_t address);
+/*! Function to read the controller address counter */
+uint8_t xSIM_GET_ADDRESS(void);
+/*! Function to read the display, cursor and blink bits last set */
+uint8_t xSIM_GET_DISPLAY(void);
+/*! Function to change one DDRAM cell without a bus cycle */
+void vSIM_UPSET(uint8_t address, uint8_t value);
+/*! Function to reset the MCU with the controllers left powered */
+void vSIM_MCU_RESET(uint8_t flags);
+/*! Function to power the MCU and the controllers off and on again */
+void vSIM_POWER_CYCLE(void);
+/*! Function to pick the display the inspection functions look at */
+void vSIM_SELECT(uint8_t display);
+/*! Function to print every violation as it happens */
+void vSIM_SET_VERBOSE(uint8_t verbose);
+/*! Function to name a violation type */
+const char *xSIM_VIOLATION_NAME(uint8_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+/*!****************************************************************************
+ *
+ * \file queue.h
+ *
+ * \brief Host stand-in for the FreeRTOS queue.h
+ *
+ * \details Items are copied in and out of a ring as FreeRTOS does. A
+ *			task blocked on an empty queue hands the CPU back to the
+ *			simulator run, and a run blocked on a full queue lets the task
+ *			run until it takes an item.
+ *
+ * Modification History:
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef SIM_QUEUE_H
+#define SIM_QUEUE_H
+
+#include "FreeRTOS.h"
+#include "lcd_sim.h"
+
+typedef SIM_Queue_t *QueueHandle_t;
+
+#define xQueueCreate(length, size)	xSIM_QUEUE_CREATE((length), (size))
+#define xQueueSendToBack(queue, item, ticks) \
+	((BaseType_t)xSIM_QUEUE_SEND((queue), (item), (ticks), 1000000000UL / configTICK_RATE_HZ))
+#define xQueueReceive(queue, item, ticks) \
+	((BaseType_t)xSIM_QUEUE_RECEIVE((queue), (item), (ticks), 1000000000UL / configTICK_RATE_HZ))
+#define uxQueueMessagesWaiting(queue)	((UBaseType_t)xSIM_QUEUE_WAITING(queue))
+
+#endif
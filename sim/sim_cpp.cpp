@@ -0,0 +1,243 @@
+/*!****************************************************************************
+ *
+ * \file sim_cpp.cpp
+ *
+ * \brief Host run of the C++ front end against the KS0066U model
+ *
+ * \author
+ *
+ * \details Builds Lib_LCD.hpp for Linux with the stub headers in this
+ *			directory and runs the opening calls of sim_main.c through the
+ *			extern "C" wrappers, then the same screen through the template
+ *			members, printing the virtual time and bus traffic of each
+ *			call in the same table as sim_main.c so the two can be put side
+ *			by side.
+ *
+ *			Build and run from the repository root:
+ *
+ *				gcc -std=gnu99 -c sim/lcd_sim.c -o lcd_sim.o
+ *				g++ -std=c++11 -Wall -Isim -I. sim/sim_cpp.cpp lcd_sim.o \
+ *					-o lcd_sim_cpp
+ *				./lcd_sim_cpp
+ *
+ *			-DBITMODE4 selects the 4-bit bus and -DconfigUSE_BUSY_FLAG=0
+ *			the fixed delays, as for sim_main.c, and
+ *			-DSIM_DEDICATED_CONTROL a dedicated control port, which may
+ *			drive PJ7 low; otherwise the pull-up set on PJ7 must survive
+ *			the run. The exit status is 1 when
+ *			a rule was broken or the display content was wrong.
+ *
+ * Modification History:
+ * 10/18/2026 - Check a pull-up on the control port, add a dedicated port run
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef F_CPU
+	#define F_CPU 16000000UL
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <avr/io.h>
+#include <util/delay.h>
+
+#ifndef configUSE_BUSY_FLAG
+	#define configUSE_BUSY_FLAG 1
+#endif
+
+#include "Lib_LCD.hpp"
+
+#ifdef BITMODE4
+	typedef LCD::Bus4<4> SIM_Bus;
+#else
+	typedef LCD::Bus8 SIM_Bus;
+#endif
+
+/*! -DSIM_DEDICATED_CONTROL gives the control port over to the display */
+#ifdef SIM_DEDICATED_CONTROL
+	LCD_DEDICATED_PORT_POLICY(SIM_PortJ, PORTJ, DDRJ, PINJ);
+#else
+	typedef LCD::PortJ SIM_PortJ;
+#endif
+
+/*! The lab board display, on the bus this run was built for */
+typedef LCD::Driver<LCD::PortK, SIM_PortJ, LCD::Control<0, 1, 2>, SIM_Bus,
+	LCD::Geometry<2, 24>, LCD::Options<true, true, configUSE_BUSY_FLAG == 1> > Lcd;
+
+#define LCD_CPP_C_API Lcd
+#include "Lib_LCD.hpp"
+
+/*! Prototypes the C code would take from Lib_LCD.h */
+extern "C"
+{
+	void vLCD_INITIALIZATION(void);
+	void vLCD_WRITE_STRING(char *str_ptr);
+	void vLCD_CLEAR(void);
+	void vLCD_GO_TO_POSITION(uint8_t x, uint8_t y);
+	void vLCD_HOME_BOTTOM_LINE(void);
+	uint8_t xLCD_WRITE_CHAR(char character);
+}
+
+/*****************************************************************************/
+/*************************/
+/*Simulator Run Functions*/
+/*************************/
+
+/*! Display content checks that failed */
+static uint16_t SIM_Mismatches = 0;
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_REPORT(const char *, SIM_Stats_t *)
+ *
+ * \brief Function to print what one call cost
+ *
+ ******************************************************************************
+ */
+static void prvSIM_REPORT(const char *call, SIM_Stats_t *before)
+{
+	SIM_Stats_t After;
+	uint32_t Violations = 0;
+	uint8_t i;
+
+	vSIM_GET_STATS(&After);
+
+	for (i = 0; i < SIM_VIOLATIONS; i++)
+	{
+		Violations += After.Violations[i] - before->Violations[i];
+	}
+
+	printf("%-44.44s %10.1f %10.1f %5lu %5lu %5lu %4lu\n", call,
+		(After.Now - before->Now) / 1000.0,
+		(After.BusyTime - before->BusyTime) / 1000.0,
+		(unsigned long)(After.Instructions - before->Instructions),
+		(unsigned long)(After.DataWrites - before->DataWrites),
+		(unsigned long)(After.Reads - before->Reads),
+		(unsigned long)Violations);
+}
+
+/*! Run one call and report its cost, variadic for the commas of GoTo<X, Y> */
+#define SIM_CALL(...)							\
+	do											\
+	{											\
+		SIM_Stats_t Before;						\
+		vSIM_GET_STATS(&Before);				\
+		__VA_ARGS__;							\
+		prvSIM_REPORT(#__VA_ARGS__, &Before);	\
+	} while (0)
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_EXPECT(const char *, const char *)
+ *
+ * \brief Function to compare both visible lines with what they should show
+ *
+ ******************************************************************************
+ */
+static void prvSIM_EXPECT(const char *top, const char *bottom)
+{
+	char Line[2][25];
+
+	vSIM_GET_LINE(0, Line[0]);
+	vSIM_GET_LINE(1, Line[1]);
+
+	printf("  |%s|\n  |%s|\n", Line[0], Line[1]);
+
+	if (strcmp(Line[0], top) || strcmp(Line[1], bottom))
+	{
+		printf("  ! display should show\n  |%s|\n  |%s|\n", top, bottom);
+		SIM_Mismatches++;
+	}
+}
+
+/*****************************************************************************/
+
+int main(void)
+{
+	char Title[] = "Lab 03 KS0066U simulator";
+	char Digits[] = "0123456789";
+	SIM_Stats_t Total;
+	uint32_t Violations = 0;
+	uint8_t i;
+
+	/*! Every instruction is a constant of the specialization */
+	static_assert(Lcd::FunctionSet == (SIM_Bus::FourBit ? 0x28 : 0x38),
+		"function set of a two line display");
+	static_assert(LCD::Instruction::SetDdram(LCD::Geometry<2, 24>::Address(12, 1)) == 0xCC,
+		"set DDRAM address of column 12 on the bottom line");
+
+	#ifdef BITMODE4
+		vSIM_INIT(SIM_WIRING_4BIT);
+	#else
+		vSIM_INIT(SIM_WIRING_8BIT);
+	#endif
+
+	/*! A pull-up on PJ7, which a shared control port must keep */
+	PORTJ |= 1 << 7;
+
+	printf("%-44s %10s %10s %5s %5s %5s %4s\n", "call", "time us",
+		"busy us", "instr", "data", "reads", "viol");
+
+	/*! The opening calls of sim_main.c, through the C wrappers */
+	SIM_CALL(vLCD_INITIALIZATION());
+	SIM_CALL(vLCD_WRITE_STRING(Title));
+	SIM_CALL(vLCD_HOME_BOTTOM_LINE());
+	SIM_CALL(vLCD_WRITE_STRING(Digits));
+	SIM_CALL(vLCD_GO_TO_POSITION(12, 1));
+	SIM_CALL(xLCD_WRITE_CHAR('-'));
+	prvSIM_EXPECT("Lab 03 KS0066U simulator",
+		"0123456789  -           ");
+
+	SIM_CALL(vLCD_CLEAR());
+	prvSIM_EXPECT("                        ",
+		"                        ");
+
+	/*! The same screen through the template members */
+	SIM_CALL(Lcd::WriteString("Lab 03 KS0066U simulator"));
+	SIM_CALL(Lcd::GoTo<0, 1>());
+	SIM_CALL(Lcd::WriteString("0123456789"));
+	SIM_CALL(Lcd::GoTo<12, 1>());
+	SIM_CALL(Lcd::Write('-'));
+	prvSIM_EXPECT("Lab 03 KS0066U simulator",
+		"0123456789  -           ");
+
+	/*! Wrapping past the end of the top line */
+	SIM_CALL(Lcd::Clear());
+	SIM_CALL(Lcd::GoTo<20, 0>());
+	SIM_CALL(Lcd::WriteString("wrap around"));
+	prvSIM_EXPECT("                    wrap",
+		" around                 ");
+
+	SIM_CALL(Lcd::Command(LCD::Instruction::Clear()));
+	prvSIM_EXPECT("                        ",
+		"                        ");
+
+	#ifndef SIM_DEDICATED_CONTROL
+		if (!(PORTJ & (1 << 7)))
+		{
+			printf("  ! the driver cleared the PJ7 pull-up\n");
+			SIM_Mismatches++;
+		}
+	#endif
+
+	vSIM_GET_STATS(&Total);
+	printf("\nvirtual time %.1fus, controller busy %.1fus, %lu E strobes\n",
+		Total.Now / 1000.0, Total.BusyTime / 1000.0, (unsigned long)Total.Strobes);
+
+	for (i = 0; i < SIM_VIOLATIONS; i++)
+	{
+		if (Total.Violations[i])
+		{
+			printf("%6lu x %s\n", (unsigned long)Total.Violations[i],
+				xSIM_VIOLATION_NAME(i));
+			Violations += Total.Violations[i];
+		}
+	}
+
+	printf("%lu violations, %u display mismatches\n",
+		(unsigned long)Violations, SIM_Mismatches);
+
+	return (Violations || SIM_Mismatches) ? 1 : 0;
+}
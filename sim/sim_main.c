@@ -0,0 +1,2213 @@
+/*!****************************************************************************
+ *
+ * \file sim_main.c
+ *
+ * \brief Host run of the LCD library against the KS0066U model
+ *
+ * \author
+ *
+ * \details Builds Lib_LCD.c unchanged for Linux, with the registers and
+ *			delays of the stub headers in this directory, runs a fixed
+ *			sequence of library calls and prints the virtual time and bus
+ *			traffic of each one, every timing rule broken, and whether the
+ *			display ended up showing what it should. The number writers
+ *			are checked against the text they should write for every flag
+ *			and the ends of their ranges.
+ *
+ *			Build and run from the repository root:
+ *
+ *				gcc -std=gnu99 -Wall -Wno-comment -Isim -I. sim/sim_main.c \
+ *					sim/lcd_sim.c -o lcd_sim
+ *				./lcd_sim
+ *
+ *			Any library configuration can be given with -D, for example
+ *			-DBITMODE4 -DconfigUSE_BUSY_FLAG=0 -DconfigUSE_SHADOW_BUFFER=1.
+ *			With -DconfigUSE_LCD_STATS=1 the library's own counters are
+ *			printed at the end and its byte count checked against the
+ *			data writes the model saw. With -DconfigUSE_LCD_TRACE=1 the run
+ *			is recorded to lcd.trace for sim/trace_replay.c. With
+ *			-DconfigUSE_GLYPH_CACHE=1 more glyphs than CGRAM slots are
+ *			written and the patterns behind the visible cells checked.
+ *			With -DconfigUSE_BAR_GRAPH=1 as well a bar and a sparkline
+ *			are updated 50 times a second and their cells checked.
+ *			With -DconfigUSE_MARQUEE=1 a short text is scrolled with 
+ *			display shifts and a long one by rewriting. With
+ *			-DconfigUSE_PAGE_FLIP=1 pages are flipped and the time the
+ *			change takes compared with rewriting both lines in place.
+ *			With -DconfigUSE_MULTI_DISPLAY=1 four displays on PJ2 to PJ5
+ *			are initialized, cleared and given a banner together, then
+ *			written one after another and interleaved, and the times 
+ *			compared. With -DconfigUSE_WARM_START=1 the MCU is reset with
+ *			the display powered and without, and the time from reset to
+ *			the first character on the display printed for each. With
+ *			-DconfigUSE_SCRUB=1 a line is read back, cells are changed
+ *			behind the library's back and scrub steps run until they are
+ *			put right, and the bus time of a step printed. With
+ *			-DconfigUSE_FRAME_SCHEDULER=1 two fields are updated 500
+ *			times a second for a second, flushed after every update and
+ *			then sent in frames, and the driver time and counters of the
+ *			two printed. With -DconfigUSE_LAYOUT=1 a screen of fields is
+ *			shown and its values set, and the bus traffic of unchanged,
+ *			changed and redrawn values compared. With -DconfigUSE_UTF8=1
+ *			UTF-8 text with symbols, katakana and malformed bytes is
+ *			written and the ROM codes checked, and ASCII timed against
+ *			vLCD_WRITE_STRING. With -DconfigUSE_YIELD_WAIT=1 the display
+ *			is initialized and ten screens cleared and written, before the
+ *			scheduler starts and then with it running, and the CPU time
+ *			the library kept for itself printed for both. With
+ *			-DconfigUSE_LCD_GATEKEEPER=1 the gatekeeper task is started on
+ *			the stub FreeRTOS, interleaved requests, refused text and its
+ *			counters are checked, and the time a caller spends on a line
+ *			written directly and through the queue, the time until it is
+ *			on the display and the characters per second of a full queue
+ *			printed.
+ *			The exit status is 1 when a rule was broken or the display
+ *			content was wrong.
+ *
+ * Modification History:
+ * 10/18/2026 - Check the number writers
+ * 10/18/2026 - Check and time the gatekeeper when it is built
+ * 10/18/2026 - Compare spinning and blocking waits when yielding waits are built
+ * 10/18/2026 - Check the UTF-8 writer when it is built
+ * 10/18/2026 - Check change only field updates when layouts are built
+ * 10/18/2026 - Pace updates into frames when the frame scheduler is built
+ * 10/18/2026 - Read back and scrub DDRAM when the scrubber is built
+ * 10/18/2026 - Time cold and warm starts when warm start detection is built
+ * 10/18/2026 - Broadcast initialization, clear and writes to several displays
+ * 10/18/2026 - Time interleaved writes to several displays when they are built
+ * 10/18/2026 - Check page flipping when it is built
+ * 10/18/2026 - Check the marquee when it is built
+ * 10/18/2026 - Check the bar graph and sparkline writers when they are built
+ * 10/18/2026 - Check the glyph cache when it is built
+ * 10/18/2026 - Record a bus trace to lcd.trace when the recorder is built
+ * 10/18/2026 - Print the library instrumentation counters when they are built
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef F_CPU
+	#define F_CPU 16000000UL
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <avr/io.h>
+#include <util/delay.h>
+#include <avr/interrupt.h>
+
+#include "Lib_LCD.h"
+#include "Lib_LCD.c"
+
+/*****************************************************************************/
+/*************************/
+/*Simulator Run Functions*/
+/*************************/
+
+/*! Display content checks that failed */
+static uint16_t SIM_Mismatches = 0;
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_REPORT(const char *, SIM_Stats_t *)
+ *
+ * \brief Function to print what one library call cost
+ *
+ ******************************************************************************
+ */
+static void prvSIM_REPORT(const char *call, SIM_Stats_t *before)
+{
+	SIM_Stats_t After;
+	uint32_t Violations = 0;
+	uint8_t i;
+
+	vSIM_GET_STATS(&After);
+
+	for (i = 0; i < SIM_VIOLATIONS; i++)
+	{
+		Violations += After.Violations[i] - before->Violations[i];
+	}
+
+	printf("%-44.44s %10.1f %10.1f %5lu %5lu %5lu %4lu\n", call,
+		(After.Now - before->Now) / 1000.0,
+		(After.BusyTime - before->BusyTime) / 1000.0,
+		(unsigned long)(After.Instructions - before->Instructions),
+		(unsigned long)(After.DataWrites - before->DataWrites),
+		(unsigned long)(After.Reads - before->Reads),
+		(unsigned long)Violations);
+}
+
+/*! Run one library call and report its cost */
+#define SIM_CALL(call)							\
+	do											\
+	{											\
+		SIM_Stats_t Before;						\
+		vSIM_GET_STATS(&Before);				\
+		call;									\
+		prvSIM_REPORT(#call, &Before);			\
+	} while (0)
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_EXPECT(const char *, const char *)
+ *
+ * \brief Function to compare both visible lines with what they should show
+ *
+ ******************************************************************************
+ */
+static void prvSIM_EXPECT(const char *top, const char *bottom)
+{
+	char Line[2][25];
+
+	/*! Let queued and shadowed writes reach the display first */
+	SIM_CALL(vLCD_FLUSH());
+	SIM_CALL(vLCD_TX_FLUSH());
+
+	vSIM_GET_LINE(0, Line[0]);
+	vSIM_GET_LINE(1, Line[1]);
+
+	printf("  |%s|\n  |%s|\n", Line[0], Line[1]);
+
+	if (strcmp(Line[0], top) || strcmp(Line[1], bottom))
+	{
+		printf("  ! display should show\n  |%s|\n  |%s|\n", top, bottom);
+		SIM_Mismatches++;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_EXPECT_RESULT(const char *, uint8_t, uint8_t)
+ *
+ * \brief Function to check what a library call returned
+ *
+ ******************************************************************************
+ */
+static void prvSIM_EXPECT_RESULT(const char *call, uint8_t result, uint8_t expected)
+{
+	if (result != expected)
+	{
+		printf("  ! %s returned %u, should be %u\n", call, result, expected);
+		SIM_Mismatches++;
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_EXPECT_NUMBER(const char *, const char *)
+ *
+ * \brief Function to compare the top line with what a number writer wrote
+ *
+ * \details text is what should be at the start of the line, the rest must
+ *			be blank.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_EXPECT_NUMBER(const char *call, const char *text)
+{
+	char Line[25];
+	char Expected[25];
+
+	vLCD_FLUSH();
+	vLCD_TX_FLUSH();
+	vSIM_GET_LINE(0, Line);
+	snprintf(Expected, sizeof(Expected), "%-24s", text);
+
+	if (strcmp(Line, Expected))
+	{
+		printf("  ! %s wrote |%s|, should be |%s|\n", call, Line, Expected);
+		SIM_Mismatches++;
+	}
+}
+
+/*! Write a number on a clear top line, then a '|' to show where it ended */
+#define SIM_NUMBER(call, text)									\
+	do															\
+	{															\
+		vLCD_CLEAR_TOP();										\
+		prvSIM_EXPECT_RESULT(#call, call, LCD_OK);				\
+		(void)xLCD_WRITE_CHAR('|');								\
+		prvSIM_EXPECT_NUMBER(#call, text);						\
+		Checked++;												\
+	} while (0)
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_NUMBERS(void)
+ *
+ * \brief Function to check the number writers
+ *
+ * \details Every flag, the ends of the ranges, decimals up to and past
+ *			the digits of the value, values wider than the width and a
+ *			value running off the end of the line.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_NUMBERS(void)
+{
+	uint8_t Checked = 0;
+
+	SIM_NUMBER(xLCD_WRITE_UNSIGNED(0, 0, 0), "0|");
+	SIM_NUMBER(xLCD_WRITE_UNSIGNED(4294967295UL, 0, 0), "4294967295|");
+	SIM_NUMBER(xLCD_WRITE_UNSIGNED(42, 6, 0), "    42|");
+	SIM_NUMBER(xLCD_WRITE_UNSIGNED(42, 6, LCD_NUM_LEFT), "42    |");
+	SIM_NUMBER(xLCD_WRITE_UNSIGNED(42, 6, LCD_NUM_ZERO), "000042|");
+	SIM_NUMBER(xLCD_WRITE_UNSIGNED(42, 6, LCD_NUM_LEFT | LCD_NUM_ZERO), "42    |");
+	SIM_NUMBER(xLCD_WRITE_UNSIGNED(42, 6, LCD_NUM_PLUS), "   +42|");
+	SIM_NUMBER(xLCD_WRITE_UNSIGNED(123456, 3, 0), "123456|");
+
+	SIM_NUMBER(xLCD_WRITE_SIGNED(-42, 6, 0), "   -42|");
+	SIM_NUMBER(xLCD_WRITE_SIGNED(-42, 6, LCD_NUM_ZERO), "-00042|");
+	SIM_NUMBER(xLCD_WRITE_SIGNED(-42, 6, LCD_NUM_LEFT), "-42   |");
+	SIM_NUMBER(xLCD_WRITE_SIGNED(42, 6, LCD_NUM_PLUS | LCD_NUM_ZERO), "+00042|");
+	SIM_NUMBER(xLCD_WRITE_SIGNED(0, 0, LCD_NUM_PLUS), "+0|");
+	SIM_NUMBER(xLCD_WRITE_SIGNED(INT32_MIN, 0, 0), "-2147483648|");
+	SIM_NUMBER(xLCD_WRITE_SIGNED(INT32_MAX, 0, LCD_NUM_PLUS), "+2147483647|");
+	SIM_NUMBER(xLCD_WRITE_SIGNED(-123456, 3, LCD_NUM_ZERO), "-123456|");
+
+	SIM_NUMBER(xLCD_WRITE_FIXED(-1234, 0, 0, 0), "-1234|");
+	SIM_NUMBER(xLCD_WRITE_FIXED(-1234, 2, 0, 0), "-12.34|");
+	SIM_NUMBER(xLCD_WRITE_FIXED(5, 2, 0, 0), "0.05|");
+	SIM_NUMBER(xLCD_WRITE_FIXED(123, 3, 0, 0), "0.123|");
+	SIM_NUMBER(xLCD_WRITE_FIXED(-5, 3, 7, LCD_NUM_ZERO), "-00.005|");
+	SIM_NUMBER(xLCD_WRITE_FIXED(25, 1, 6, LCD_NUM_LEFT | LCD_NUM_PLUS), "+2.5  |");
+	SIM_NUMBER(xLCD_WRITE_FIXED(1, 12, 0, 0), "0.000000001|");
+	SIM_NUMBER(xLCD_WRITE_FIXED(INT32_MIN, 2, 0, 0), "-21474836.48|");
+	SIM_NUMBER(xLCD_WRITE_FIXED(INT32_MIN, 9, 0, 0), "-2.147483648|");
+	SIM_NUMBER(xLCD_WRITE_FIXED(123456, 2, 4, 0), "1234.56|");
+
+	SIM_NUMBER(xLCD_WRITE_HEX(0, 0, 0), "0|");
+	SIM_NUMBER(xLCD_WRITE_HEX(0xBEEF, 0, 0), "BEEF|");
+	SIM_NUMBER(xLCD_WRITE_HEX(0x2A, 4, LCD_NUM_ZERO), "002A|");
+	SIM_NUMBER(xLCD_WRITE_HEX(0x2A, 4, LCD_NUM_LEFT), "2A  |");
+	SIM_NUMBER(xLCD_WRITE_HEX(0xFFFFFFFFUL, 2, LCD_NUM_PLUS), "FFFFFFFF|");
+
+	/*! The digits past the end of the line are not shown */
+	vLCD_CLEAR_TOP();
+	vLCD_GO_TO_POSITION(20, 0);
+	prvSIM_EXPECT_RESULT("xLCD_WRITE_UNSIGNED(12345678, 0, 0)",
+		xLCD_WRITE_UNSIGNED(12345678, 0, 0), LCD_OK);
+	prvSIM_EXPECT_NUMBER("xLCD_WRITE_UNSIGNED(12345678, 0, 0)",
+		"                    1234");
+	Checked++;
+
+	vLCD_CLEAR_TOP();
+	printf("numbers  %u writes checked\n", Checked);
+}
+
+#if configUSE_LCD_STATS == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_LCD_STATS(SIM_Stats_t *)
+ *
+ * \brief Function to print the library counters and check them
+ *
+ ******************************************************************************
+ */
+static void prvSIM_LCD_STATS(SIM_Stats_t *total)
+{
+	static const char *Names[LCD_API_COUNT] =
+	{
+		"INITIALIZATION", "WRITE_COMMAND", "WAIT_BUSY", "WRITE_STRING",
+		"WRITE_CHAR", "CLEAR", "CLEAR_LINE", "FILL_RANGE", "ON_OFF",
+		"GO_TO_POSITION", "HOME", "SEGMENTS", "NUMBER", "FLUSH", "TX_FLUSH",
+		"PEEPHOLE_FLUSH", "GLYPH", "BAR", "MARQUEE", "PAGE_PREPARE",
+		"PAGE_FLIP", "MULTI_FLUSH", "READ_DDRAM", "SCRUB", "FRAME_WRITE",
+		"FRAME_SEND", "LAYOUT_SHOW", "FIELD_SET", "WRITE_UTF8", "PAGE_END",
+	};
+	LCD_Stats_t Stats;
+	uint8_t i;
+
+	vLCD_GET_STATS(&Stats);
+
+	printf("\n%-16s %6s %10s\n", "library call", "calls", "cycles");
+	for (i = 0; i < LCD_API_COUNT; i++)
+	{
+		if (Stats.Calls[i])
+		{
+			printf("%-16s %6u %10lu\n", Names[i], Stats.Calls[i],
+				(unsigned long)Stats.Cycles[i]);
+		}
+	}
+	printf("%lu cycles, %lu bytes, %lu instructions, %lu us delays, "
+		"%lu busy polls, %lu cycles blocked\n", (unsigned long)Stats.TotalCycles,
+		(unsigned long)Stats.Bytes, (unsigned long)Stats.Commands,
+		(unsigned long)Stats.DelayUs, (unsigned long)Stats.BusyPolls,
+		(unsigned long)Stats.BlockedCycles);
+
+	if (Stats.Bytes != total->DataWrites)
+	{
+		printf("  ! library counted %lu bytes, the display saw %lu\n",
+			(unsigned long)Stats.Bytes, (unsigned long)total->DataWrites);
+		SIM_Mismatches++;
+	}
+}
+
+#endif
+
+#if configUSE_LCD_TRACE == 1
+
+/*! File the bus trace is stored in */
+static FILE *SIM_TraceFile;
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_TRACE_WRITE(const uint8_t *, uint16_t)
+ *
+ * \brief Function given to vLCD_TRACE_DUMP to store the trace
+ *
+ ******************************************************************************
+ */
+static void prvSIM_TRACE_WRITE(const uint8_t *data, uint16_t length)
+{
+	fwrite(data, 1, length, SIM_TraceFile);
+}
+
+#endif
+
+#if configUSE_GLYPH_CACHE == 1
+
+/*! Glyph with rows n to n + 7, each glyph is different */
+#define SIM_GLYPH(n)	(n) & 0x1F, ((n) + 1) & 0x1F, ((n) + 2) & 0x1F, \
+	((n) + 3) & 0x1F, ((n) + 4) & 0x1F, ((n) + 5) & 0x1F, ((n) + 6) & 0x1F, \
+	((n) + 7) & 0x1F
+
+/*! Twelve glyphs, more than the CGRAM holds */
+static const uint8_t SIM_Glyphs[] PROGMEM =
+{
+	SIM_GLYPH(0), SIM_GLYPH(3), SIM_GLYPH(6), SIM_GLYPH(9), SIM_GLYPH(12),
+	SIM_GLYPH(15), SIM_GLYPH(18), SIM_GLYPH(21), SIM_GLYPH(24), SIM_GLYPH(27),
+	SIM_GLYPH(30), SIM_GLYPH(33),
+};
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_EXPECT_GLYPHS(uint8_t, const uint8_t *, uint8_t)
+ *
+ * \brief Function to check the glyphs shown from a DDRAM address on
+ *
+ ******************************************************************************
+ */
+static void prvSIM_EXPECT_GLYPHS(uint8_t address, const uint8_t *ids, uint8_t count)
+{
+	uint8_t Cell;
+	uint8_t Row;
+
+	SIM_CALL(vLCD_FLUSH());
+	SIM_CALL(vLCD_TX_FLUSH());
+
+	for (Cell = 0; Cell < count; Cell++)
+	{
+		uint8_t Code = xSIM_GET_DDRAM(address + Cell);
+
+		for (Row = 0; Row < LCD_GLYPH_ROWS; Row++)
+		{
+			if ((Code >= 16) || (xSIM_GET_CGRAM((Code & 7) * 8 + Row) !=
+				SIM_Glyphs[ids[Cell] * LCD_GLYPH_ROWS + Row]))
+			{
+				printf("  ! DDRAM 0x%02X should show glyph %u\n",
+					address + Cell, ids[Cell]);
+				SIM_Mismatches++;
+				break;
+			}
+		}
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_GLYPHS(void)
+ *
+ * \brief Function to run twelve glyphs through the eight CGRAM slots
+ *
+ ******************************************************************************
+ */
+static void prvSIM_GLYPHS(void)
+{
+	static const uint8_t Top[] = { 4, 5, 6, 7, 0 };
+	static const uint8_t Bottom[] = { 8, 9, 10 };
+	LCD_GlyphStats_t Stats;
+	uint8_t Result;
+	uint8_t i;
+
+	vLCD_GLYPH_TABLE(SIM_Glyphs, sizeof(SIM_Glyphs) / LCD_GLYPH_ROWS);
+
+	SIM_CALL(vLCD_HOME_TOP_LINE());
+	for (i = 0; i < 8; i++)
+	{
+		SIM_CALL(Result = xLCD_WRITE_GLYPH(i));
+	}
+	SIM_CALL(Result = xLCD_WRITE_GLYPH(0));
+	SIM_CALL(vLCD_FLUSH());
+
+	/*! Every slot is on the display */
+	SIM_CALL(Result = xLCD_WRITE_GLYPH(8));
+	prvSIM_EXPECT_RESULT("xLCD_WRITE_GLYPH(8)", Result, LCD_ERROR_NO_GLYPH);
+
+	/*! Frees the slots of glyphs 1 to 3, glyph 0 is still in cell 8 */
+	SIM_CALL(vLCD_CLEAR_RANGE(0, 0, 4));
+	SIM_CALL(vLCD_FLUSH());
+	SIM_CALL(vLCD_HOME_BOTTOM_LINE());
+	for (i = 8; i < 12; i++)
+	{
+		SIM_CALL(Result = xLCD_WRITE_GLYPH(i));
+	}
+	prvSIM_EXPECT_RESULT("xLCD_WRITE_GLYPH(11)", Result, LCD_ERROR_NO_GLYPH);
+
+	/*! Already loaded, nothing is sent to CGRAM */
+	SIM_CALL(Result = xLCD_WRITE_GLYPH(9));
+
+	prvSIM_EXPECT_GLYPHS(LCD_LINE0_DDRAMADDR + 4, Top, sizeof(Top));
+	prvSIM_EXPECT_GLYPHS(LCD_LINE1_DDRAMADDR, Bottom, sizeof(Bottom));
+	prvSIM_EXPECT_GLYPHS(LCD_LINE1_DDRAMADDR + 3, &Bottom[1], 1);
+
+	vLCD_GLYPH_GET_STATS(&Stats);
+	printf("glyphs %u hits, %u loads, %u refused\n", Stats.Hits, Stats.Loads,
+		Stats.Refused);
+	if ((Stats.Hits != 2) || (Stats.Loads != 11) || (Stats.Refused != 2))
+	{
+		printf("  ! glyph cache should have 2 hits, 11 loads, 2 refused\n");
+		SIM_Mismatches++;
+	}
+}
+
+#endif
+
+#if configUSE_BAR_GRAPH == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_EXPECT_LEVELS(uint8_t, const uint8_t *, uint8_t, uint8_t, uint8_t)
+ *
+ * \brief Function to check the bar cells shown from a DDRAM address on
+ *
+ ******************************************************************************
+ */
+static void prvSIM_EXPECT_LEVELS(uint8_t address, const uint8_t *levels,
+	uint8_t count, uint8_t full, uint8_t glyph)
+{
+	uint8_t Cell;
+	uint8_t Row;
+
+	for (Cell = 0; Cell < count; Cell++)
+	{
+		uint8_t Code = xSIM_GET_DDRAM(address + Cell);
+		uint8_t Level = levels[Cell];
+		uint8_t Good;
+
+		if (Level == 0) Good = (Code == ' ');
+		else if (Level >= full) Good = (Code == LCD_FULL_BLOCK);
+		else
+		{
+			Good = (Code < 16);
+			for (Row = 0; Good && (Row < LCD_GLYPH_ROWS); Row++)
+			{
+				Good = (xSIM_GET_CGRAM((Code & 7) * 8 + Row) == LCD_BarGlyphs[
+					(glyph - LCD_GLYPH_BUILTIN + Level - 1) * LCD_GLYPH_ROWS + Row]);
+			}
+		}
+
+		if (!Good)
+		{
+			printf("  ! DDRAM 0x%02X should show level %u of %u\n",
+				address + Cell, Level, full);
+			SIM_Mismatches++;
+		}
+	}
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_BARS(void)
+ *
+ * \brief Function to update a bar and a sparkline 50 times a second
+ *
+ ******************************************************************************
+ */
+static void prvSIM_BARS(void)
+{
+	static const uint16_t Wave[16] =
+	{
+		500, 690, 850, 960, 1000, 960, 850, 690,
+		500, 310, 150, 40, 0, 40, 150, 310
+	};
+	LCD_Bar_t Bar;
+	LCD_Spark_t Spark;
+	LCD_GlyphStats_t Glyphs;
+	SIM_Stats_t Start;
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint64_t Busiest = 0;
+	uint64_t Spent = 0;
+	uint8_t Levels[LCD_LINE_LENGTH];
+	uint16_t Update;
+	uint16_t Value = 0;
+	uint8_t Low = 0;
+	uint8_t Cell;
+
+	SIM_CALL(vLCD_CLEAR());
+	vLCD_GLYPH_RESET_STATS();
+
+	vLCD_BAR_INIT(&Bar, 0, 0, LCD_LINE_LENGTH);
+	vLCD_SPARK_INIT(&Spark, 0, 1, LCD_LINE_LENGTH);
+
+	vSIM_GET_STATS(&Start);
+
+	for (Update = 0; Update < 200; Update++)
+	{
+		/*! The bar sweeps up and down, the sparkline follows a wave */
+		Value = (Update % 100 < 50) ? (Update % 100) * 20 : (100 - Update % 100) * 20;
+
+		vSIM_GET_STATS(&Before);
+		(void)xLCD_BAR_SET(&Bar, Value, 1000);
+		(void)xLCD_SPARK_PUSH(&Spark, Wave[Update % 16] + (Update % 3) * 13, 1000);
+		vLCD_FLUSH();
+		vLCD_TX_FLUSH();
+		vSIM_GET_STATS(&After);
+
+		Spent += After.Now - Before.Now;
+		if (After.Now - Before.Now > Busiest) Busiest = After.Now - Before.Now;
+
+		/*! 20ms between updates */
+		if (After.Now - Before.Now < 20000000ULL)
+		{
+			vSIM_DELAY_NS(20000000ULL - (After.Now - Before.Now));
+		}
+	}
+
+	vSIM_GET_STATS(&After);
+
+	for (Cell = 0; Cell < LCD_LINE_LENGTH; Cell++)
+	{
+		uint8_t Start = Cell * LCD_BAR_COLUMNS;
+
+		Levels[Cell] = (Bar.Level <= Start) ? 0 : (Bar.Level - Start > LCD_BAR_COLUMNS) ?
+			LCD_BAR_COLUMNS : Bar.Level - Start;
+		if (Spark.Shown[Cell] != Spark.Samples[Cell]) Low++;
+	}
+
+	prvSIM_EXPECT_LEVELS(LCD_LINE0_DDRAMADDR, Levels, LCD_LINE_LENGTH,
+		LCD_BAR_COLUMNS, LCD_GLYPH_BAR(1));
+	prvSIM_EXPECT_LEVELS(LCD_LINE1_DDRAMADDR, Spark.Shown, LCD_LINE_LENGTH,
+		LCD_SPARK_LEVELS, LCD_GLYPH_SPARK(1));
+
+	if (Bar.Level != prvLCD_BAR_LEVEL(Value, 1000, LCD_LINE_LENGTH * LCD_BAR_COLUMNS))
+	{
+		printf("  ! bar shows %u columns, should be %u\n", Bar.Level,
+			prvLCD_BAR_LEVEL(Value, 1000, LCD_LINE_LENGTH * LCD_BAR_COLUMNS));
+		SIM_Mismatches++;
+	}
+
+	vLCD_GLYPH_GET_STATS(&Glyphs);
+	printf("bars   %u updates, %.1fus each on average, %.1fus at most, %lu "
+		"instructions, %lu data, bus in use %.1f%% of the time\n", Update,
+		Spent / 1000.0 / Update, Busiest / 1000.0,
+		(unsigned long)(After.Instructions - Start.Instructions),
+		(unsigned long)(After.DataWrites - Start.DataWrites),
+		100.0 * Spent / (After.Now - Start.Now));
+	printf("bars   glyphs %u hits, %u loads, %u refused, %u sparkline cells "
+		"below their level\n", Glyphs.Hits, Glyphs.Loads, Glyphs.Refused, Low);
+}
+
+#endif
+
+#if configUSE_MARQUEE == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_MARQUEE_LINE(char *, const char *, uint16_t, uint16_t)
+ *
+ * \brief Function to make the 24 characters a marquee should show
+ *
+ ******************************************************************************
+ */
+static void prvSIM_MARQUEE_LINE(char *line, const char *text, uint16_t period,
+	uint16_t offset)
+{
+	uint16_t Length = strlen(text);
+	uint8_t i;
+
+	for (i = 0; i < LCD_LINE_LENGTH; i++)
+	{
+		uint16_t Index = (offset + i) % period;
+		line[i] = (Index < Length) ? text[Index] : ' ';
+	}
+	line[LCD_LINE_LENGTH] = 0;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_MARQUEE(void)
+ *
+ * \brief Function to scroll a short text by display shift and a long one
+ *			by rewriting
+ *
+ ******************************************************************************
+ */
+static void prvSIM_MARQUEE(void)
+{
+	static const char Short[] = "Tank 3 at 72%, pump 2 running";
+	static const char Long[] = "Alarm: tank 1 high level, inlet valve closed, "
+		"check float switch";
+	char Top[LCD_LINE_LENGTH + 1];
+	char Bottom[LCD_LINE_LENGTH + 1];
+	uint8_t Result;
+	uint8_t i;
+
+	SIM_CALL(vLCD_CLEAR());
+	prvSIM_EXPECT("                        ",
+		"                        ");
+
+	SIM_CALL(Result = xLCD_MARQUEE_START(0, Short));
+	SIM_CALL(Result = xLCD_MARQUEE_STEP());
+	for (i = 1; i < 30; i++)
+	{
+		Result = xLCD_MARQUEE_STEP();
+	}
+	prvSIM_EXPECT_RESULT("xLCD_MARQUEE_STEP()", Result, LCD_OK);
+	prvSIM_MARQUEE_LINE(Top, Short, LCD_DDRAM_LINE_LENGTH, 30);
+	prvSIM_EXPECT(Top, "                        ");
+
+	/*! Positions are columns on the glass while shifted, column 8 is 
+		cell 38 so the text carries on from cell 39 to cell 0 */
+	SIM_CALL(vLCD_GO_TO_POSITION(8, 1));
+	SIM_CALL(vLCD_WRITE_STRING("Level 72"));
+	SIM_CALL(vLCD_HOME_BOTTOM_LINE());
+	SIM_CALL(vLCD_WRITE_STRING("Hi"));
+	prvSIM_EXPECT(Top, "Hi      Level 72        ");
+
+	/*! The other line scrolls along */
+	SIM_CALL(Result = xLCD_MARQUEE_STEP());
+	prvSIM_MARQUEE_LINE(Top, Short, LCD_DDRAM_LINE_LENGTH, 31);
+	prvSIM_EXPECT(Top, "i      Level 72         ");
+
+	SIM_CALL(Result = xLCD_MARQUEE_STOP());
+	prvSIM_MARQUEE_LINE(Top, Short, LCD_DDRAM_LINE_LENGTH, 0);
+	prvSIM_EXPECT(Top, "vel 72                  ");
+
+	SIM_CALL(Result = xLCD_MARQUEE_START(1, Long));
+	SIM_CALL(Result = xLCD_MARQUEE_STEP());
+	for (i = 1; i < 70; i++)
+	{
+		Result = xLCD_MARQUEE_STEP();
+	}
+	prvSIM_EXPECT_RESULT("xLCD_MARQUEE_STEP()", Result, LCD_OK);
+	prvSIM_MARQUEE_LINE(Bottom, Long, strlen(Long) + LCD_MARQUEE_GAP, 70);
+	prvSIM_EXPECT(Top, Bottom);
+
+	SIM_CALL(Result = xLCD_MARQUEE_STOP());
+	SIM_CALL(vLCD_CLEAR());
+
+	#if configUSE_SHADOW_BUFFER == 0
+		/*! Writes in a shifting entry mode move the display three cells
+			left, positions after them are still columns on the glass */
+		SIM_CALL(vWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_ENTRY_MODE) |
+			(1 << LCD_ENTRY_INC) | (1 << LCD_ENTRY_SHIFT)));
+		SIM_CALL(vLCD_WRITE_STRING("abc"));
+		SIM_CALL(vWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_ENTRY_MODE) |
+			(1 << LCD_ENTRY_INC)));
+		SIM_CALL(vLCD_GO_TO_POSITION(10, 1));
+		SIM_CALL(vLCD_WRITE_STRING("OK"));
+		prvSIM_EXPECT("                        ",
+			"          OK            ");
+		
+		SIM_CALL(vLCD_CLEAR());
+	#endif
+}
+
+#endif
+
+#if configUSE_PAGE_FLIP == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_PAGES(void)
+ *
+ * \brief Function to flip pages and time them against rewriting in place
+ *
+ ******************************************************************************
+ */
+static void prvSIM_PAGES(void)
+{
+	static const char *Pages[4][2] =
+	{
+		{ "Tank 1   72%   pump on  ", "Inlet 12.5 l/min  OK    " },
+		{ "Tank 2   15%   pump off ", "Inlet  0.0 l/min  LOW   " },
+		{ "Tank 3   98%   pump off ", "Overflow valve open     " },
+		{ "Summary  3 tanks        ", "1 alarm, 1 warning      " },
+	};
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint64_t InPlace;
+	uint64_t Flip = 0;
+	uint8_t Result;
+	uint8_t i;
+
+	SIM_CALL(vLCD_CLEAR());
+	prvSIM_EXPECT("                        ",
+		"                        ");
+
+	/*! Both lines rewritten in place, half old and half new meanwhile */
+	vSIM_GET_STATS(&Before);
+	vLCD_HOME_TOP_LINE();
+	vLCD_WRITE_STRING((char *)Pages[0][0]);
+	vLCD_HOME_BOTTOM_LINE();
+	vLCD_WRITE_STRING((char *)Pages[0][1]);
+	vLCD_FLUSH();
+	vLCD_TX_FLUSH();
+	vSIM_GET_STATS(&After);
+	InPlace = After.Now - Before.Now;
+	prvSIM_EXPECT(Pages[0][0], Pages[0][1]);
+
+	/*! The flips have to keep the cursor the application switched off */
+	SIM_CALL(vWRITE_COMMAND_TO_LCD(INSTR_WR, (1 << LCD_ON_CTRL) | (1 << LCD_ON_DISPLAY)));
+
+	for (i = 1; i < 4; i++)
+	{
+		SIM_CALL(Result = xLCD_PAGE_PREPARE(Pages[i][0], Pages[i][1]));
+		prvSIM_EXPECT_RESULT("xLCD_PAGE_PREPARE()", Result, LCD_OK);
+
+		/*! Nothing on screen changes until the flip */
+		prvSIM_EXPECT(Pages[i - 1][0], Pages[i - 1][1]);
+
+		vSIM_GET_STATS(&Before);
+		SIM_CALL(Result = xLCD_PAGE_FLIP());
+		vLCD_TX_FLUSH();
+		vSIM_GET_STATS(&After);
+		prvSIM_EXPECT_RESULT("xLCD_PAGE_FLIP()", Result, LCD_OK);
+		if (After.Now - Before.Now > Flip) Flip = After.Now - Before.Now;
+
+		prvSIM_EXPECT(Pages[i][0], Pages[i][1]);
+		vLCD_TX_FLUSH();
+		if (xSIM_GET_DISPLAY() != (1 << LCD_ON_DISPLAY))
+		{
+			printf("  ! display control %02X after the flip, should be %02X\n",
+				xSIM_GET_DISPLAY(), 1 << LCD_ON_DISPLAY);
+			SIM_Mismatches++;
+		}
+	}
+
+	/*! Positions are columns on the glass with the page shifted */
+	SIM_CALL(vLCD_GO_TO_POSITION(9, 0));
+	SIM_CALL(vLCD_WRITE_STRING("4"));
+	prvSIM_EXPECT("Summary  4 tanks        ", Pages[3][1]);
+
+	printf("pages  new screen after %.1fus rewriting in place, %.1fus blank "
+		"with a flip\n", InPlace / 1000.0, Flip / 1000.0);
+
+	SIM_CALL(Result = xLCD_PAGE_END());
+	prvSIM_EXPECT("                        ",
+		"                        ");
+}
+
+#endif
+
+#if configUSE_SCRUB == 1
+
+/*! Idle slot the scrub steps are given, in ns */
+#define SIM_SCRUB_PERIOD	10000000ULL
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_SCRUB_PASS(uint64_t *)
+ *
+ * \brief Function to run scrub steps until every cell has been checked
+ *
+ * \returns Steps run, the longest step in *longest
+ *
+ ******************************************************************************
+ */
+static uint8_t prvSIM_SCRUB_PASS(uint64_t *longest)
+{
+	LCD_ScrubStats_t Stats;
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint16_t Passes;
+	uint8_t Steps = 0;
+	uint8_t Result;
+
+	vLCD_SCRUB_GET_STATS(&Stats);
+	Passes = Stats.Passes;
+
+	while (Stats.Passes == Passes)
+	{
+		vSIM_GET_STATS(&Before);
+		Result = xLCD_SCRUB_STEP();
+		vLCD_TX_FLUSH();
+		vSIM_GET_STATS(&After);
+		prvSIM_EXPECT_RESULT("xLCD_SCRUB_STEP()", Result, LCD_OK);
+
+		if (After.Now - Before.Now > *longest) *longest = After.Now - Before.Now;
+		Steps++;
+
+		vLCD_SCRUB_GET_STATS(&Stats);
+	}
+
+	return Steps;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_SCRUB(void)
+ *
+ * \brief Function to read DDRAM back and let the scrubber repair it
+ *
+ * \details A line is read back and a character written after it, which
+ *			must land at the cursor. Then three cells are upset and scrub
+ *			steps run for one pass, which must rewrite those three and
+ *			nothing else, and another, which must write nothing. A write
+ *			after a cursor move must be kept, and a step in the middle of
+ *			a glyph upload must leave the upload alone.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_SCRUB(void)
+{
+	char Line[LCD_LINE_LENGTH + 1];
+	LCD_ScrubStats_t Stats;
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint64_t Repairing = 0;
+	uint64_t Clean = 0;
+	uint8_t Steps;
+	uint8_t Result;
+
+	SIM_CALL(vLCD_CLEAR());
+	SIM_CALL(vLCD_HOME_TOP_LINE());
+	SIM_CALL(vLCD_WRITE_STRING("Scrub DDRAM read back"));
+	SIM_CALL(vLCD_HOME_BOTTOM_LINE());
+	SIM_CALL(vLCD_WRITE_STRING("Pressure 101.3 kPa"));
+	SIM_CALL(vLCD_FLUSH());
+
+	SIM_CALL(Result = xLCD_READ_DDRAM(0, 1, LCD_LINE_LENGTH, Line));
+	prvSIM_EXPECT_RESULT("xLCD_READ_DDRAM()", Result, LCD_OK);
+	Line[LCD_LINE_LENGTH] = '\0';
+	printf("  read |%s|\n", Line);
+	if (strcmp(Line, "Pressure 101.3 kPa      "))
+	{
+		printf("  ! read back should be\n       |Pressure 101.3 kPa      |\n");
+		SIM_Mismatches++;
+	}
+
+	/*! The read put the address counter back at the cursor */
+	SIM_CALL(xLCD_WRITE_CHAR('!'));
+	prvSIM_EXPECT("Scrub DDRAM read back   ",
+		"Pressure 101.3 kPa!     ");
+
+	vSIM_UPSET(LCD_LINE0_DDRAMADDR + 6, '#');
+	vSIM_UPSET(LCD_LINE1_DDRAMADDR + 9, '7');
+	vSIM_UPSET(LCD_LINE1_DDRAMADDR + 23, '%');
+	prvSIM_EXPECT("Scrub #DRAM read back   ",
+		"Pressure 701.3 kPa!    %");
+
+	vLCD_SCRUB_RESET_STATS();
+	vSIM_GET_STATS(&Before);
+	Steps = prvSIM_SCRUB_PASS(&Repairing);
+	vSIM_GET_STATS(&After);
+	vLCD_SCRUB_GET_STATS(&Stats);
+
+	prvSIM_EXPECT_RESULT("cells repaired", Stats.Repaired, 3);
+	prvSIM_EXPECT_RESULT("data writes of the repair",
+		After.DataWrites - Before.DataWrites, 3);
+	prvSIM_EXPECT("Scrub DDRAM read back   ",
+		"Pressure 101.3 kPa!     ");
+
+	/*! A display that is right gets no writes */
+	vSIM_GET_STATS(&Before);
+	(void)prvSIM_SCRUB_PASS(&Clean);
+	vSIM_GET_STATS(&After);
+	prvSIM_EXPECT_RESULT("data writes of a clean pass",
+		After.DataWrites - Before.DataWrites, 0);
+
+	printf("scrub  %lu cells checked in %u steps of %u, %u repaired, "
+		"a step takes %.1fus, %.1fus with repairs, %.2f%% of a %lums slot\n",
+		(unsigned long)Stats.Checked, Steps, configLCD_SCRUB_CELLS,
+		Stats.Repaired, Clean / 1000.0, Repairing / 1000.0,
+		Clean * 100.0 / SIM_SCRUB_PERIOD,
+		(unsigned long)(SIM_SCRUB_PERIOD / 1000000ULL));
+
+	SIM_CALL(xLCD_WRITE_CHAR('?'));
+	prvSIM_EXPECT("Scrub DDRAM read back   ",
+		"Pressure 101.3 kPa!?    ");
+
+	/*! A write after a cursor move is what the scrubber must keep */
+	SIM_CALL(xWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_MOVE));
+	SIM_CALL(xWRITE_COMMAND_TO_LCD(DATA_WR, 'X'));
+	vLCD_TX_FLUSH();
+	vLCD_SCRUB_RESET_STATS();
+	(void)prvSIM_SCRUB_PASS(&Clean);
+	vLCD_SCRUB_GET_STATS(&Stats);
+	prvSIM_EXPECT_RESULT("cells repaired after a cursor move", Stats.Repaired, 0);
+	prvSIM_EXPECT_RESULT("cell written after a cursor move",
+		xSIM_GET_DDRAM(LCD_LINE1_DDRAMADDR + 19), 'X');
+
+	/*! A scrub step between two rows of a glyph must leave them in CGRAM */
+	SIM_CALL(xWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_CGRAM | 8));
+	SIM_CALL(xWRITE_COMMAND_TO_LCD(DATA_WR, 0x0E));
+	SIM_CALL(Result = xLCD_SCRUB_STEP());
+	prvSIM_EXPECT_RESULT("xLCD_SCRUB_STEP() in a glyph upload", Result, LCD_OK);
+	SIM_CALL(xWRITE_COMMAND_TO_LCD(DATA_WR, 0x11));
+	vLCD_TX_FLUSH();
+	prvSIM_EXPECT_RESULT("glyph row before the scrub step", xSIM_GET_CGRAM(8), 0x0E);
+	prvSIM_EXPECT_RESULT("glyph row after the scrub step", xSIM_GET_CGRAM(9), 0x11);
+	prvSIM_EXPECT("Scrub DDRAM read back   ",
+		"Pressure 101.3 kPa!X    ");
+
+	SIM_CALL(vLCD_CLEAR());
+}
+
+#endif
+
+#if configUSE_LAYOUT == 1
+
+/*! Labels of the test screen */
+static const char SIM_LabelTemp[] PROGMEM = "Temp ";
+static const char SIM_LabelRpm[] PROGMEM = "RPM ";
+static const char SIM_LabelMode[] PROGMEM = "Mode ";
+static const char SIM_LabelGap[] PROGMEM = " ";
+
+/*! Fields of the test screen by name */
+enum { SIM_FIELD_TEMP, SIM_FIELD_RPM, SIM_FIELD_MODE, SIM_FIELD_STATUS, SIM_FIELD_GAP,
+	SIM_FIELDS };
+
+/*! The test screen */
+static const LCD_Field_t SIM_Screen[SIM_FIELDS] PROGMEM =
+{
+	LCD_FIELD(0, 0, SIM_LabelTemp, 7, LCD_ALIGN_RIGHT),
+	LCD_FIELD(13, 0, SIM_LabelRpm, 7, LCD_ALIGN_LEFT),
+	LCD_FIELD(0, 1, SIM_LabelMode, 8, LCD_ALIGN_LEFT),
+	LCD_FIELD_VALUE(16, 1, 8, LCD_ALIGN_CENTER),
+	LCD_FIELD(13, 1, SIM_LabelGap, 0, LCD_ALIGN_LEFT),
+};
+
+/*! Temperature updates in the redraw comparison */
+#define SIM_LAYOUT_UPDATES	100
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_FIELD(uint8_t, const char *, uint64_t *)
+ *
+ * \brief Function to set one field and send it
+ *
+ * \returns Data writes the model saw, the time taken added to *time
+ *
+ ******************************************************************************
+ */
+static uint32_t prvSIM_FIELD(uint8_t field, const char *text, uint64_t *time)
+{
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint8_t Result;
+
+	vSIM_GET_STATS(&Before);
+	Result = xLCD_FIELD_SET(field, text);
+	vLCD_FLUSH();
+	vLCD_TX_FLUSH();
+	vSIM_GET_STATS(&After);
+	prvSIM_EXPECT_RESULT("xLCD_FIELD_SET()", Result, LCD_OK);
+
+	*time += After.Now - Before.Now;
+	return After.DataWrites - Before.DataWrites;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_LAYOUT(void)
+ *
+ * \brief Function to check change only field updates
+ *
+ * \details Shows the test screen and sets its values, checks that a value
+ *			set again sends nothing and one changed digit sends one cell,
+ *			that without the shadow buffer a value is written in full
+ *			while the address counter is lost and a label only field not
+ *			at all, then times a temperature
+ *			changing 100 times through its field and through the labels
+ *			and values being redrawn by hand.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_LAYOUT(void)
+{
+	char Text[8];
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint64_t Time = 0;
+	uint64_t Fields = 0;
+	uint64_t Redraw;
+	uint32_t FieldWrites = 0;
+	uint32_t Writes;
+	uint8_t Result;
+	uint8_t i;
+
+	SIM_CALL(vLCD_LAYOUT_SHOW(SIM_Screen, SIM_FIELDS));
+	SIM_CALL(vLCD_FLUSH());
+	prvSIM_EXPECT("Temp         RPM        ",
+		"Mode                    ");
+
+	SIM_CALL(Result = xLCD_FIELD_SET(SIM_FIELD_TEMP, "21.5C"));
+	SIM_CALL(Result = xLCD_FIELD_SET(SIM_FIELD_RPM, "1200"));
+	SIM_CALL(Result = xLCD_FIELD_SET(SIM_FIELD_MODE, "AUTO"));
+	SIM_CALL(Result = xLCD_FIELD_SET(SIM_FIELD_STATUS, "OK"));
+	SIM_CALL(vLCD_FLUSH());
+	prvSIM_EXPECT("Temp   21.5C RPM 1200   ",
+		"Mode AUTO          OK   ");
+
+	SIM_CALL(Result = xLCD_FIELD_SET(SIM_FIELDS, "9"));
+	prvSIM_EXPECT_RESULT("xLCD_FIELD_SET() past the layout", Result, LCD_ERROR_NO_FIELD);
+
+	/*! The same value sends nothing, one changed digit one cell */
+	Writes = prvSIM_FIELD(SIM_FIELD_TEMP, "21.5C", &Time);
+	prvSIM_EXPECT_RESULT("data writes of an unchanged value", Writes, 0);
+	Writes = prvSIM_FIELD(SIM_FIELD_TEMP, "21.6C", &Time);
+	prvSIM_EXPECT_RESULT("data writes of one changed digit", Writes, 1);
+	(void)prvSIM_FIELD(SIM_FIELD_RPM, "980", &Time);
+	(void)prvSIM_FIELD(SIM_FIELD_STATUS, "ALARM", &Time);
+	prvSIM_EXPECT("Temp   21.6C RPM 980    ",
+		"Mode AUTO        ALARM  ");
+
+	#if configUSE_SHADOW_BUFFER == 0
+		/*! Digits written after the address counter was lost, as a timed
+			out read leaves it, are put right by the same value */
+		vLCD_GO_TO_POSITION(17, 0);
+		LCD_AddressCounter = LCD_ADDRESS_UNKNOWN;
+		vLCD_WRITE_STRING("12");
+		vLCD_TX_FLUSH();
+		Writes = prvSIM_FIELD(SIM_FIELD_RPM, "980", &Time);
+		prvSIM_EXPECT_RESULT("data writes of a value over lost cells", Writes, 7);
+		prvSIM_EXPECT("Temp   21.6C RPM 980    ",
+			"Mode AUTO        ALARM  ");
+
+		/*! A label only field has no cells to write, known or not */
+		LCD_AddressCounter = LCD_ADDRESS_UNKNOWN;
+		Writes = prvSIM_FIELD(SIM_FIELD_GAP, "9", &Time);
+		prvSIM_EXPECT_RESULT("data writes of a label only field", Writes, 0);
+	#endif
+
+	/*! A slowly changing temperature, through its field */
+	for (i = 0; i < SIM_LAYOUT_UPDATES; i++)
+	{
+		snprintf(Text, sizeof(Text), "%d.%dC", 20 + i / 20, (i / 2) % 10);
+		FieldWrites += prvSIM_FIELD(SIM_FIELD_TEMP, Text, &Fields);
+		FieldWrites += prvSIM_FIELD(SIM_FIELD_MODE, "AUTO", &Fields);
+	}
+
+	/*! The same updates written the way the screens were hand coded */
+	vSIM_GET_STATS(&Before);
+	for (i = 0; i < SIM_LAYOUT_UPDATES; i++)
+	{
+		snprintf(Text, sizeof(Text), "%d.%dC", 20 + i / 20, (i / 2) % 10);
+		vLCD_GO_TO_POSITION(0, 0);
+		vLCD_WRITE_STRING("Temp   ");
+		vLCD_WRITE_STRING(Text);
+		vLCD_GO_TO_POSITION(0, 1);
+		vLCD_WRITE_STRING("Mode AUTO    ");
+		vLCD_FLUSH();
+		vLCD_TX_FLUSH();
+	}
+	vSIM_GET_STATS(&After);
+	Redraw = After.Now - Before.Now;
+	prvSIM_EXPECT("Temp   24.9C RPM 980    ",
+		"Mode AUTO        ALARM  ");
+
+	printf("layout %u updates through fields: %lu data writes in %.1fus, "
+		"redrawn: %lu data writes in %.1fus\n", 2 * SIM_LAYOUT_UPDATES,
+		(unsigned long)FieldWrites, Fields / 1000.0,
+		(unsigned long)(After.DataWrites - Before.DataWrites), Redraw / 1000.0);
+
+	SIM_CALL(vLCD_CLEAR());
+	SIM_CALL(vLCD_FLUSH());
+}
+
+#endif
+
+#if configUSE_UTF8 == 1
+
+#if configUSE_UTF8_GLYPHS == 1
+
+/*! Capital umlauts, which the A00 ROM lacks, from the test glyphs */
+static const LCD_Utf8Glyph_t SIM_Utf8Glyphs[] PROGMEM =
+{
+	{ 0x00C4, 3 },
+	{ 0x00D6, 4 },
+};
+
+#endif
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_UTF8(void)
+ *
+ * \brief Function to check the ROM codes written for UTF-8 text
+ *
+ * \details Writes symbols, katakana, hiragana, a voiced katakana and
+ *			malformed sequences and checks the codes on the display, then
+ *			writes the same ASCII line through vLCD_WRITE_STRING and
+ *			xLCD_WRITE_UTF8 to compare their cost.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_UTF8(void)
+{
+	char Ascii[] = "ASCII fast path 0123456";
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint64_t StringTime;
+	uint64_t Utf8Time;
+	uint32_t StringWrites;
+	uint8_t Result;
+
+	SIM_CALL(vLCD_CLEAR());
+
+	#if configLCD_ROM == LCD_ROM_A00
+		SIM_CALL(Result = xLCD_WRITE_UTF8("Temp 21.5\xC2\xB0" "C \xEF\xBD\xB1\xEF\xBD\xB2"
+			"\xEF\xBD\xB3 \xE3\x82\xAB\xE3\x83\x8A"));
+		prvSIM_EXPECT_RESULT("xLCD_WRITE_UTF8()", Result, LCD_OK);
+		SIM_CALL(vLCD_HOME_BOTTOM_LINE());
+		SIM_CALL(Result = xLCD_WRITE_UTF8("\xE3\x82\xAC\xE3\x81\x95\xC3(\xF0\x9F\x98\x80"
+			"\xC2\xB5\xC3\xB7\xCF\x80\xE2\x86\x92"));
+		SIM_CALL(vLCD_FLUSH());
+		prvSIM_EXPECT("Temp 21.5\xDF" "C \xB1\xB2\xB3 \xB6\xC5      ",
+			"\xB6\xDE\xBB?(?\xE4\xFD\xF7\x7E              ");
+	#else
+		SIM_CALL(Result = xLCD_WRITE_UTF8("Gr\xC3\xBC\xC3\x9F" "e 21\xC2\xB0" "C \xC3\x89t\xC3\xA9"));
+		prvSIM_EXPECT_RESULT("xLCD_WRITE_UTF8()", Result, LCD_OK);
+		SIM_CALL(vLCD_HOME_BOTTOM_LINE());
+		SIM_CALL(Result = xLCD_WRITE_UTF8("\xE3\x82\xAB\xC3(\xE2\x82\xAC"));
+		SIM_CALL(vLCD_FLUSH());
+		prvSIM_EXPECT("Gr\xFC\xDF" "e 21\xB0" "C \xC9t\xE9          ",
+			"??" "(?                    ");
+	#endif
+
+	#if configUSE_UTF8_GLYPHS == 1
+		/*! Characters the ROM lacks come from CGRAM */
+		{
+			static const uint8_t Umlauts[] = { 3, 4 };
+
+			vLCD_GLYPH_TABLE(SIM_Glyphs, sizeof(SIM_Glyphs) / LCD_GLYPH_ROWS);
+			vLCD_UTF8_GLYPHS(SIM_Utf8Glyphs, 2);
+			SIM_CALL(vLCD_HOME_BOTTOM_LINE());
+			SIM_CALL(Result = xLCD_WRITE_UTF8("\xC3\x84\xC3\x96"));
+			prvSIM_EXPECT_RESULT("xLCD_WRITE_UTF8()", Result, LCD_OK);
+			prvSIM_EXPECT_GLYPHS(LCD_LINE1_DDRAMADDR, Umlauts, 2);
+		}
+	#endif
+
+	/*! ASCII costs the bus the same either way, one line each */
+	SIM_CALL(vLCD_CLEAR());
+	SIM_CALL(vLCD_FLUSH());
+	vLCD_TX_FLUSH();
+	(void)xLCD_WAIT_WHILE_BUSY();
+
+	vSIM_GET_STATS(&Before);
+	vLCD_HOME_TOP_LINE();
+	vLCD_WRITE_STRING(Ascii);
+	vLCD_FLUSH();
+	vLCD_TX_FLUSH();
+	vSIM_GET_STATS(&After);
+	StringTime = After.Now - Before.Now;
+	StringWrites = After.DataWrites - Before.DataWrites;
+	(void)xLCD_WAIT_WHILE_BUSY();
+
+	vSIM_GET_STATS(&Before);
+	vLCD_HOME_BOTTOM_LINE();
+	Result = xLCD_WRITE_UTF8(Ascii);
+	vLCD_FLUSH();
+	vLCD_TX_FLUSH();
+	vSIM_GET_STATS(&After);
+	Utf8Time = After.Now - Before.Now;
+	prvSIM_EXPECT_RESULT("xLCD_WRITE_UTF8()", Result, LCD_OK);
+	prvSIM_EXPECT_RESULT("data writes of ASCII", After.DataWrites - Before.DataWrites,
+		StringWrites);
+	prvSIM_EXPECT("ASCII fast path 0123456 ",
+		"ASCII fast path 0123456 ");
+
+	printf("utf8   %u ASCII characters take %.1fus through xLCD_WRITE_UTF8, "
+		"%.1fus through vLCD_WRITE_STRING\n", (unsigned)strlen(Ascii),
+		Utf8Time / 1000.0, StringTime / 1000.0);
+
+	SIM_CALL(vLCD_CLEAR());
+	SIM_CALL(vLCD_FLUSH());
+}
+
+#endif
+
+#if configUSE_YIELD_WAIT == 1
+
+/*! Screens cleared and written in one run */
+#define SIM_YIELD_SCREENS	10
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_YIELD_RUN(uint8_t, uint64_t *)
+ *
+ * \brief Function to initialize the display and write screens after clears
+ *
+ * \details The scheduler is left in the given state for the run.
+ *
+ * \returns Time the run took, the CPU time of the library in *cpu
+ *
+ ******************************************************************************
+ */
+static uint64_t prvSIM_YIELD_RUN(uint8_t scheduler, uint64_t *cpu)
+{
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	char Count[] = "Screen 0";
+	uint8_t i;
+
+	vSIM_SET_SCHEDULER(scheduler);
+	vSIM_GET_STATS(&Before);
+
+	vLCD_INITIALIZATION();
+	for (i = 0; i < SIM_YIELD_SCREENS; i++)
+	{
+		Count[7] = '0' + i;
+		vLCD_CLEAR();
+		vLCD_WRITE_STRING("Yielding waits");
+		vLCD_HOME_BOTTOM_LINE();
+		vLCD_WRITE_STRING(Count);
+	}
+	vLCD_FLUSH();
+	vLCD_TX_FLUSH();
+
+	vSIM_GET_STATS(&After);
+	vSIM_SET_SCHEDULER(SIM_SCHEDULER_NOT_STARTED);
+
+	prvSIM_EXPECT("Yielding waits          ",
+		"Screen 9                ");
+
+	*cpu = (After.Now - Before.Now) - (After.BlockedTime - Before.BlockedTime);
+
+	return After.Now - Before.Now;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_YIELD(void)
+ *
+ * \brief Function to compare spinning and blocking waits
+ *
+ * \details Before the scheduler starts every wait spins, as it did before
+ *			the waits could block. With it running the long ones block,
+ *			and the CPU time of the library should come down to the bus
+ *			transfers and short waits. A clear with interrupts off must
+ *			still spin.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_YIELD(void)
+{
+	uint64_t SpinCpu;
+	uint64_t SpinTime;
+	uint64_t BlockCpu;
+	uint64_t BlockTime;
+
+	SpinTime = prvSIM_YIELD_RUN(SIM_SCHEDULER_NOT_STARTED, &SpinCpu);
+	BlockTime = prvSIM_YIELD_RUN(SIM_SCHEDULER_RUNNING, &BlockCpu);
+
+	printf("yield  spinning %.1fus CPU in %.1fus (%.1f%%), blocking %.1fus CPU "
+		"in %.1fus (%.1f%%)\n", SpinCpu / 1000.0, SpinTime / 1000.0,
+		100.0 * SpinCpu / SpinTime, BlockCpu / 1000.0, BlockTime / 1000.0,
+		100.0 * BlockCpu / BlockTime);
+	prvSIM_EXPECT_RESULT("CPU time below spinning", BlockCpu < SpinCpu, 1);
+
+	#if configUSE_TX_INTERRUPT == 0
+	{
+		SIM_Stats_t Before;
+		SIM_Stats_t After;
+
+		vSIM_SET_SCHEDULER(SIM_SCHEDULER_RUNNING);
+		vSIM_GET_STATS(&Before);
+		cli();
+		vLCD_CLEAR();
+		vLCD_WRITE_STRING("Interrupts off");
+		vLCD_FLUSH();
+		sei();
+		vSIM_GET_STATS(&After);
+		vSIM_SET_SCHEDULER(SIM_SCHEDULER_NOT_STARTED);
+
+		prvSIM_EXPECT_RESULT("blocked with interrupts off",
+			After.BlockedTime != Before.BlockedTime, 0);
+		prvSIM_EXPECT("Interrupts off          ",
+			"                        ");
+	}
+	#endif
+
+	SIM_CALL(vLCD_CLEAR());
+	SIM_CALL(vLCD_FLUSH());
+}
+
+#endif
+
+#if configUSE_FRAME_SCHEDULER == 1
+
+/*! Time between field updates, in ns */
+#define SIM_FRAME_UPDATE	2000000ULL
+/*! Time between frames, in ns */
+#define SIM_FRAME_PERIOD	(1000000000ULL / configLCD_FRAME_RATE_HZ)
+/*! Field updates in one run, a second of them */
+#define SIM_FRAME_UPDATES	500
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_FRAME_RUN(uint8_t, uint64_t *)
+ *
+ * \brief Function to update two fields at a steady rate for a while
+ *
+ * \details The count changes on every update, the state every 50. With
+ *			framed set the changes are sent by xLCD_FRAME_SEND once a frame
+ *			period, else by vLCD_FLUSH after every update as the gatekeeper
+ *			would without the scheduler. Virtual time runs on between
+ *			updates as if the CPU did other work.
+ *
+ * \returns Time spent in library calls, the longest send in *longest
+ *
+ ******************************************************************************
+ */
+static uint64_t prvSIM_FRAME_RUN(uint8_t framed, uint64_t *longest)
+{
+	char Text[8];
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint64_t Start;
+	uint64_t NextFrame;
+	uint64_t Driver = 0;
+	uint64_t Sent;
+	uint16_t Update;
+
+	vSIM_GET_STATS(&Before);
+	Start = Before.Now;
+	NextFrame = Start + SIM_FRAME_PERIOD;
+
+	for (Update = 1; Update <= SIM_FRAME_UPDATES; Update++)
+	{
+		vSIM_GET_STATS(&Before);
+		if (Before.Now < Start + Update * SIM_FRAME_UPDATE)
+			vSIM_DELAY_NS(Start + Update * SIM_FRAME_UPDATE - Before.Now);
+
+		vSIM_GET_STATS(&Before);
+		snprintf(Text, sizeof(Text), "%6u", Update);
+		vLCD_FRAME_WRITE(6, 0, Text);
+		vLCD_FRAME_WRITE(6, 1, (Update / 50) & 1 ? "RUN " : "IDLE");
+
+		if (!framed)
+			vLCD_FLUSH();
+		else if (Before.Now >= NextFrame)
+		{
+			(void)xLCD_FRAME_SEND();
+			NextFrame += SIM_FRAME_PERIOD;
+		}
+		vLCD_TX_FLUSH();
+		vSIM_GET_STATS(&After);
+
+		Sent = After.Now - Before.Now;
+		Driver += Sent;
+		if (Sent > *longest) *longest = Sent;
+	}
+
+	return Driver;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_FRAMES(void)
+ *
+ * \brief Function to compare frame paced updates with flushing each one
+ *
+ * \details Runs the same second of updates both ways and checks the
+ *			display ends up with the last values, then changes every cell
+ *			at once and counts the frames the budget spreads it over.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_FRAMES(void)
+{
+	LCD_FrameStats_t Stats;
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint64_t Each;
+	uint64_t Framed;
+	uint64_t EachLongest = 0;
+	uint64_t FrameLongest = 0;
+	uint64_t Longest = 0;
+	uint16_t Frames = 0;
+	uint8_t Result;
+
+	SIM_CALL(vLCD_CLEAR());
+	SIM_CALL(vLCD_FLUSH());
+	SIM_CALL(vLCD_FRAME_WRITE(0, 0, "Count"));
+	SIM_CALL(vLCD_FRAME_WRITE(0, 1, "State"));
+
+	vSIM_GET_STATS(&Before);
+	Each = prvSIM_FRAME_RUN(0, &EachLongest);
+	vSIM_GET_STATS(&After);
+	prvSIM_EXPECT("Count    500            ",
+		"State IDLE              ");
+	printf("frames flushed after each of %u updates: %.1fus in the driver, "
+		"%lu data writes, longest %.1fus\n", 2 * SIM_FRAME_UPDATES,
+		Each / 1000.0, (unsigned long)(After.DataWrites - Before.DataWrites),
+		EachLongest / 1000.0);
+
+	vLCD_FRAME_RESET_STATS();
+	vSIM_GET_STATS(&Before);
+	Framed = prvSIM_FRAME_RUN(1, &FrameLongest);
+	SIM_CALL(Result = xLCD_FRAME_SEND());
+	prvSIM_EXPECT_RESULT("xLCD_FRAME_SEND()", Result, LCD_OK);
+	vSIM_GET_STATS(&After);
+	vLCD_FRAME_GET_STATS(&Stats);
+	prvSIM_EXPECT("Count    500            ",
+		"State IDLE              ");
+	printf("frames at %uHz: %.1fus in the driver, %lu data writes, longest "
+		"%.1fus against a %uus budget\n", configLCD_FRAME_RATE_HZ,
+		Framed / 1000.0, (unsigned long)(After.DataWrites - Before.DataWrites),
+		FrameLongest / 1000.0, configLCD_FRAME_BUDGET_US);
+	printf("frames %lu updates, %lu coalesced, %lu dropped, %u frames, "
+		"%u deferred\n", (unsigned long)Stats.Updates,
+		(unsigned long)Stats.Coalesced, (unsigned long)Stats.Dropped,
+		Stats.Frames, Stats.Deferred);
+	prvSIM_EXPECT_RESULT("updates counted", Stats.Updates == 2 * SIM_FRAME_UPDATES, 1);
+
+	/*! A whole new screen may need more than one frame */
+	vLCD_FRAME_RESET_STATS();
+	vLCD_FRAME_WRITE(0, 0, "Frame budget test line 0");
+	vLCD_FRAME_WRITE(0, 1, "Frame budget test line 1");
+	do
+	{
+		vSIM_GET_STATS(&Before);
+		Result = xLCD_FRAME_SEND();
+		vLCD_TX_FLUSH();
+		vSIM_GET_STATS(&After);
+		if (After.Now - Before.Now > Longest) Longest = After.Now - Before.Now;
+		Frames++;
+	} while (Result == LCD_ERROR_BUDGET && Frames < 10);
+	prvSIM_EXPECT_RESULT("xLCD_FRAME_SEND()", Result, LCD_OK);
+	vLCD_FRAME_GET_STATS(&Stats);
+	prvSIM_EXPECT_RESULT("frames deferred", Stats.Deferred, Frames - 1);
+	prvSIM_EXPECT("Frame budget test line 0",
+		"Frame budget test line 1");
+	printf("frames a full screen took %u frames, longest %.1fus\n", Frames,
+		Longest / 1000.0);
+
+	SIM_CALL(vLCD_CLEAR());
+	SIM_CALL(vLCD_FLUSH());
+}
+
+#endif
+
+#if configUSE_MULTI_DISPLAY == 1
+
+/*! Displays on the bus, E on PJ2 up */
+#define SIM_MULTI_DISPLAYS	4
+
+/*! The handles, set up by the multi display run, the first is on PJ2 */
+static LCD_Display_t SIM_Displays[SIM_MULTI_DISPLAYS];
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_MULTI_SCREEN(const char *, const char *)
+ *
+ * \brief Function to write both lines of the selected display
+ *
+ ******************************************************************************
+ */
+static void prvSIM_MULTI_SCREEN(const char *top, const char *bottom)
+{
+	vLCD_HOME_TOP_LINE();
+	vLCD_WRITE_STRING((char *)top);
+	vLCD_HOME_BOTTOM_LINE();
+	vLCD_WRITE_STRING((char *)bottom);
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_BROADCAST(void)
+ *
+ * \brief Function to initialize, clear and write several displays at once
+ *
+ ******************************************************************************
+ */
+static void prvSIM_BROADCAST(void)
+{
+	static const char *Tops[SIM_MULTI_DISPLAYS] =
+	{
+		"Line A                  ", "Line B                  ",
+		"Line C                  ", "Line D                  ",
+	};
+	static const char Banner[] = "Plant status   12:00    ";
+	static const char *Blank = "                        ";
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint64_t One;
+	uint64_t All;
+	uint8_t Result = LCD_OK;
+	uint8_t i;
+
+	vSIM_GET_STATS(&Before);
+	SIM_CALL(vLCD_INITIALIZATION());
+	vSIM_GET_STATS(&After);
+	One = After.Now - Before.Now;
+
+	vSIM_GET_STATS(&Before);
+	SIM_CALL(vLCD_BROADCAST_INITIALIZATION(LCD_TARGET_ALL));
+	vSIM_GET_STATS(&After);
+	All = After.Now - Before.Now;
+
+	/*! A banner sent once for all, then a line of each display's own */
+	Result |= xLCD_BROADCAST_COMMAND(LCD_TARGET_ALL, INSTR_WR, 
+		(1 << LCD_DDRAM) | LCD_LINE1_DDRAMADDR);
+	for (i = 0; Banner[i]; i++)
+	{
+		Result |= xLCD_BROADCAST_COMMAND(LCD_TARGET_ALL, DATA_WR, Banner[i]);
+	}
+	prvSIM_EXPECT_RESULT("xLCD_BROADCAST_COMMAND()", Result, LCD_OK);
+
+	for (i = 0; i < SIM_MULTI_DISPLAYS; i++)
+	{
+		vLCD_SELECT(&SIM_Displays[i]);
+		vLCD_HOME_TOP_LINE();
+		vLCD_WRITE_STRING((char *)Tops[i]);
+	}
+	for (i = 0; i < SIM_MULTI_DISPLAYS; i++)
+	{
+		vSIM_SELECT(i);
+		prvSIM_EXPECT(Tops[i], Banner);
+	}
+
+	/*! Clear two of them */
+	SIM_CALL(vLCD_BROADCAST_CLEAR(LCD_TARGET(&SIM_Displays[1]) |
+		LCD_TARGET(&SIM_Displays[3])));
+	for (i = 0; i < SIM_MULTI_DISPLAYS; i++)
+	{
+		vSIM_SELECT(i);
+		if (i & 1) prvSIM_EXPECT(Blank, Blank);
+		else prvSIM_EXPECT(Tops[i], Banner);
+	}
+
+	/*! A broadcast between queued writes lands between them */
+	SIM_CALL(vLCD_BROADCAST_CLEAR(LCD_TARGET_ALL));
+	vLCD_MULTI_BEGIN();
+	vLCD_SELECT(&SIM_Displays[0]);
+	vLCD_HOME_TOP_LINE();
+	vLCD_WRITE_STRING("first");
+	Result = xLCD_BROADCAST_COMMAND(LCD_TARGET_ALL, INSTR_WR, 
+		(1 << LCD_DDRAM) | LCD_LINE0_DDRAMADDR);
+	Result |= xLCD_BROADCAST_COMMAND(LCD_TARGET_ALL, DATA_WR, 'X');
+	vLCD_WRITE_STRING("Y");
+	Result |= xLCD_MULTI_FLUSH();
+	prvSIM_EXPECT_RESULT("xLCD_BROADCAST_COMMAND() queued", Result, LCD_OK);
+	for (i = 0; i < SIM_MULTI_DISPLAYS; i++)
+	{
+		vSIM_SELECT(i);
+		prvSIM_EXPECT(i ? "X                       " : "XYrst                   ", Blank);
+	}
+	vSIM_SELECT(0);
+
+	printf("broadcast  %u displays initialized in %.1fus together, %.1fus "
+		"for one\n", SIM_MULTI_DISPLAYS, All / 1000.0, One / 1000.0);
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_MULTI(void)
+ *
+ * \brief Function to time screens written one display after another and
+ *		  interleaved across the displays
+ *
+ * \details First checks that writes queued before any display is set up
+ *			reach the display on LCD_E.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_MULTI(void)
+{
+	static const char *Screens[2][SIM_MULTI_DISPLAYS][2] =
+	{
+		{
+			{ "Line A   pressure 4.2bar", "Flow 12.5 l/min   OK    " },
+			{ "Line B   pressure 3.9bar", "Flow 11.8 l/min   OK    " },
+			{ "Line C   pressure 0.0bar", "Flow  0.0 l/min   STOP  " },
+			{ "Line D   pressure 4.0bar", "Flow 12.1 l/min   OK    " },
+		},
+		{
+			{ "Line A   pressure 4.3bar", "Flow 12.6 l/min   OK    " },
+			{ "Line B   pressure 1.2bar", "Flow  4.1 l/min   LOW   " },
+			{ "Line C   pressure 2.5bar", "Flow  8.0 l/min   START " },
+			{ "Line D   pressure 4.1bar", "Flow 12.2 l/min   OK    " },
+		},
+	};
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint64_t One = 0;
+	uint64_t Serial;
+	uint64_t Interleaved;
+	uint8_t Result;
+	uint8_t i;
+
+	/*! Before any display is set up the writes go to the one on LCD_E,
+		more of them than a queue holds */
+	vLCD_MULTI_BEGIN();
+	for (i = 0; i < 3; i++)
+	{
+		vLCD_HOME_TOP_LINE();
+		vLCD_WRITE_STRING("Primary display queued");
+	}
+	Result = xLCD_MULTI_FLUSH();
+	prvSIM_EXPECT_RESULT("xLCD_MULTI_FLUSH() on the primary display", Result, LCD_OK);
+	prvSIM_EXPECT("Primary display queued  ", "                        ");
+
+	for (i = 0; i < SIM_MULTI_DISPLAYS; i++)
+	{
+		vLCD_DISPLAY_INIT(&SIM_Displays[i], LCD_E + i);
+	}
+	prvSIM_BROADCAST();
+
+	/*! One display after another, each write waits for its display */
+	vSIM_GET_STATS(&Before);
+	for (i = 0; i < SIM_MULTI_DISPLAYS; i++)
+	{
+		SIM_Stats_t Start;
+
+		vSIM_GET_STATS(&Start);
+		vLCD_SELECT(&SIM_Displays[i]);
+		prvSIM_MULTI_SCREEN(Screens[0][i][0], Screens[0][i][1]);
+		vSIM_GET_STATS(&After);
+		if (!One) One = After.Now - Start.Now;
+	}
+	Serial = After.Now - Before.Now;
+
+	for (i = 0; i < SIM_MULTI_DISPLAYS; i++)
+	{
+		vSIM_SELECT(i);
+		prvSIM_EXPECT(Screens[0][i][0], Screens[0][i][1]);
+	}
+
+	/*! All queued first, then sent while the other displays execute */
+	vSIM_GET_STATS(&Before);
+	vLCD_MULTI_BEGIN();
+	for (i = 0; i < SIM_MULTI_DISPLAYS; i++)
+	{
+		vLCD_SELECT(&SIM_Displays[i]);
+		prvSIM_MULTI_SCREEN(Screens[1][i][0], Screens[1][i][1]);
+	}
+	SIM_CALL(Result = xLCD_MULTI_FLUSH());
+	vSIM_GET_STATS(&After);
+	Interleaved = After.Now - Before.Now;
+	prvSIM_EXPECT_RESULT("xLCD_MULTI_FLUSH()", Result, LCD_OK);
+
+	for (i = 0; i < SIM_MULTI_DISPLAYS; i++)
+	{
+		vSIM_SELECT(i);
+		prvSIM_EXPECT(Screens[1][i][0], Screens[1][i][1]);
+	}
+
+	vSIM_SELECT(0);
+	vLCD_SELECT(&SIM_Displays[0]);
+
+	printf("multi  one screen %.1fus on 1 display, %u screens %.1fus one after "
+		"another, %.1fus interleaved, %.2f times the rate of 1 display\n",
+		One / 1000.0, SIM_MULTI_DISPLAYS, Serial / 1000.0,
+		Interleaved / 1000.0, (double)One * SIM_MULTI_DISPLAYS / Interleaved);
+}
+
+#endif
+
+#if configUSE_LCD_GATEKEEPER == 1
+
+/*! Stretch of virtual time the gatekeeper is run for between checks */
+#define SIM_GATEKEEPER_SLICE_NS	10000ULL
+/*! Longest the gatekeeper is given to put a screen up */
+#define SIM_GATEKEEPER_LIMIT_NS	1000000000ULL
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_GATEKEEPER_SHOWN(const char *, const char *)
+ *
+ * \brief Function to run the gatekeeper until both lines show the text
+ *
+ * \details The display is only looked at, never flushed, as the gatekeeper
+ *			owns it.
+ *
+ * \returns Time until the text was on the display, to SIM_GATEKEEPER_SLICE_NS
+ *
+ ******************************************************************************
+ */
+static uint64_t prvSIM_GATEKEEPER_SHOWN(const char *top, const char *bottom)
+{
+	SIM_Stats_t Start;
+	SIM_Stats_t Now;
+	char Line[2][25];
+
+	vSIM_GET_STATS(&Start);
+
+	do
+	{
+		vSIM_TASK_RUN(SIM_GATEKEEPER_SLICE_NS);
+		vSIM_GET_STATS(&Now);
+		vSIM_GET_LINE(0, Line[0]);
+		vSIM_GET_LINE(1, Line[1]);
+	} while ((strcmp(Line[0], top) || strcmp(Line[1], bottom)) &&
+		Now.Now - Start.Now < SIM_GATEKEEPER_LIMIT_NS);
+
+	printf("  |%s|\n  |%s|\n", Line[0], Line[1]);
+
+	if (strcmp(Line[0], top) || strcmp(Line[1], bottom))
+	{
+		printf("  ! display should show\n  |%s|\n  |%s|\n", top, bottom);
+		SIM_Mismatches++;
+	}
+
+	return Now.Now - Start.Now;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_GATEKEEPER_LINE(char *, uint8_t)
+ *
+ * \brief Function to make the full line of text of one queued request
+ *
+ ******************************************************************************
+ */
+static void prvSIM_GATEKEEPER_LINE(char *text, uint8_t request)
+{
+	snprintf(text, LCD_LINE_LENGTH + 1, "Queue run request %02u%4s", request % 100, "");
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_GATEKEEPER(void)
+ *
+ * \brief Function to check and time the gatekeeper task
+ *
+ * \details Requests two tasks would make are queued interleaved, with
+ *			text too long for a line and text running off the end of one,
+ *			and must reach the display in queue order with the counters
+ *			matching. A line is then written directly and through the
+ *			queue, and a full queue of lines drained while one more request
+ *			waits for room.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_GATEKEEPER(void)
+{
+	LCD_GatekeeperStats_t Stats;
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	char Text[LCD_LINE_LENGTH + 2];
+	char Previous[LCD_LINE_LENGTH + 1];
+	uint64_t Direct;
+	uint64_t Enqueue;
+	uint64_t Shown;
+	uint64_t Blocked;
+	uint64_t Drain;
+	uint8_t i;
+
+	/*! A line written by the caller itself, before the gatekeeper owns the display */
+	prvSIM_GATEKEEPER_LINE(Text, 0);
+	_delay_ms(2);
+	vSIM_GET_STATS(&Before);
+	vLCD_GO_TO_POSITION(0, 0);
+	vLCD_WRITE_STRING(Text);
+	vLCD_FLUSH();
+	vLCD_TX_FLUSH();
+	vSIM_GET_STATS(&After);
+	Direct = After.Now - Before.Now;
+
+	vSIM_SET_SCHEDULER(SIM_SCHEDULER_RUNNING);
+	prvSIM_EXPECT_RESULT("xLCD_GATEKEEPER_START()", xLCD_GATEKEEPER_START(), pdPASS);
+
+	/*! Two tasks' requests interleaved after a full line, the last runs off the line */
+	memset(Text, 'x', LCD_LINE_LENGTH + 1);
+	Text[LCD_LINE_LENGTH] = '\0';
+	prvSIM_EXPECT_RESULT("clear", xLCD_REQUEST_CLEAR(LCD_REQUEST_CLEAR, 0), pdPASS);
+	prvSIM_EXPECT_RESULT("line", xLCD_REQUEST_WRITE(0, 0, Text, 0), pdPASS);
+	prvSIM_EXPECT_RESULT("A1", xLCD_REQUEST_WRITE(0, 0, "A1", 0), pdPASS);
+	prvSIM_EXPECT_RESULT("B1", xLCD_REQUEST_WRITE(0, 1, "B1", 0), pdPASS);
+	prvSIM_EXPECT_RESULT("-B2", xLCD_REQUEST_STRING("-B2", 0), pdPASS);
+	prvSIM_EXPECT_RESULT("position", xLCD_REQUEST_POSITION(10, 0, 0), pdPASS);
+	prvSIM_EXPECT_RESULT("A2", xLCD_REQUEST_STRING("A2", 0), pdPASS);
+	prvSIM_EXPECT_RESULT("B3-B4", xLCD_REQUEST_WRITE(20, 1, "B3-B4", 0), pdPASS);
+
+	/*! Text longer than a line is refused, not cut, and nothing is queued */
+	Text[LCD_LINE_LENGTH] = 'x';
+	Text[LCD_LINE_LENGTH + 1] = '\0';
+	prvSIM_EXPECT_RESULT("string too long", 
+		(uint8_t)xLCD_REQUEST_STRING(Text, 0), (uint8_t)errLCD_TEXT_TOO_LONG);
+	prvSIM_EXPECT_RESULT("write too long", 
+		(uint8_t)xLCD_REQUEST_WRITE(0, 0, Text, 0), (uint8_t)errLCD_TEXT_TOO_LONG);
+	prvSIM_EXPECT_RESULT("requests queued", uxQueueMessagesWaiting(LCD_GatekeeperQueue), 8);
+
+	prvSIM_GATEKEEPER_SHOWN("A1xxxxxxxxA2xxxxxxxxxxxx", "B1-B2               B3-B");
+
+	vLCD_GATEKEEPER_GET_STATS(&Stats);
+	printf("gatekeeper  %lu requests, %lu characters, %lu queue full, high water %u\n",
+		(unsigned long)Stats.Requests, (unsigned long)Stats.Characters,
+		(unsigned long)Stats.QueueFull, Stats.HighWater);
+	prvSIM_EXPECT_RESULT("requests", Stats.Requests, 8);
+	prvSIM_EXPECT_RESULT("characters", Stats.Characters, 24 + 2 + 2 + 3 + 2 + 4);
+	prvSIM_EXPECT_RESULT("queue full", Stats.QueueFull, 0);
+	prvSIM_EXPECT_RESULT("high water", Stats.HighWater, 8);
+
+	/*! One line through the queue of an idle gatekeeper */
+	prvSIM_GATEKEEPER_LINE(Text, 0);
+	vSIM_GET_STATS(&Before);
+	prvSIM_EXPECT_RESULT("line", xLCD_REQUEST_WRITE(0, 0, Text, portMAX_DELAY), pdPASS);
+	vSIM_GET_STATS(&After);
+	Enqueue = After.Now - Before.Now;
+	Shown = prvSIM_GATEKEEPER_SHOWN(Text, "B1-B2               B3-B");
+
+	/*! A full queue of lines, and one more that has to wait for room */
+	vLCD_GATEKEEPER_RESET_STATS();
+	for (i = 1; i <= configLCD_GATEKEEPER_QUEUE_LENGTH; i++)
+	{
+		prvSIM_GATEKEEPER_LINE(Text, i);
+		prvSIM_EXPECT_RESULT("queue run",
+			xLCD_REQUEST_WRITE(0, (i - 1) & 1, Text, 0), pdPASS);
+	}
+	prvSIM_EXPECT_RESULT("queue full", xLCD_REQUEST_STRING("", 0), errQUEUE_FULL);
+
+	prvSIM_GATEKEEPER_LINE(Previous, i - 1);
+	prvSIM_GATEKEEPER_LINE(Text, i);
+	vSIM_GET_STATS(&Before);
+	prvSIM_EXPECT_RESULT("queue run wait",
+		xLCD_REQUEST_WRITE(0, (i - 1) & 1, Text, portMAX_DELAY), pdPASS);
+	vSIM_GET_STATS(&After);
+	Blocked = After.Now - Before.Now;
+
+	if (i & 1)
+		Drain = Blocked + prvSIM_GATEKEEPER_SHOWN(Text, Previous);
+	else
+		Drain = Blocked + prvSIM_GATEKEEPER_SHOWN(Previous, Text);
+
+	vLCD_GATEKEEPER_GET_STATS(&Stats);
+	prvSIM_EXPECT_RESULT("queue run requests", Stats.Requests, i);
+	prvSIM_EXPECT_RESULT("queue run queue full", Stats.QueueFull, 1);
+
+	/*! The queue copy and task switches take no virtual time, so Enqueue
+		and Blocked are not a measure of the request latency */
+	printf("gatekeeper  line written directly %.1fus, enqueued %.1fus and on the "
+		"display after %.1fus, waited %.1fus for room (queue and task "
+		"switches not timed), %lu characters in %.1fus (%.0f/s)\n",
+		Direct / 1000.0, Enqueue / 1000.0, Shown / 1000.0, Blocked / 1000.0,
+		(unsigned long)Stats.Characters, Drain / 1000.0,
+		Stats.Characters * 1e9 / Drain);
+
+	/*! Leave the display blank for the runs after this one */
+	prvSIM_EXPECT_RESULT("clear", xLCD_REQUEST_CLEAR(LCD_REQUEST_CLEAR, portMAX_DELAY), pdPASS);
+	prvSIM_GATEKEEPER_SHOWN("                        ", "                        ");
+	vSIM_SET_SCHEDULER(SIM_SCHEDULER_NOT_STARTED);
+}
+
+#endif
+
+#if configUSE_WARM_START == 1
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_REBOOT(uint8_t)
+ *
+ * \brief Function to reset the MCU and start the library variables again
+ *
+ * \details With PORF the display is powered off and on as well. The
+ *			variables a reset would set back to their initial values are
+ *			set here, as the host program keeps running.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_REBOOT(uint8_t cause)
+{
+	vLCD_FLUSH();
+	vLCD_TX_FLUSH();
+
+	if (cause == (1 << PORF)) vSIM_POWER_CYCLE();
+	else vSIM_MCU_RESET(cause);
+
+	CURSOR_X_POSITION = 0;
+	CURSOR_Y_POSITION = 0;
+	LCD_AddressCounter = LCD_ADDRESS_UNKNOWN;
+	LCD_EntryMode = (1 << LCD_ENTRY_MODE) | (INCREMENT_MODE << LCD_ENTRY_INC);
+	LCD_DisplayShift = 0;
+	LCD_DisplayControl = (1 << LCD_ON_CTRL) | (1 << LCD_ON_DISPLAY) |
+		(configCURSOR_SHOW << LCD_ON_CURSOR) | (configCURSOR_BLINK << LCD_ON_BLINK);
+	LCD_WarmStarted = 0;
+	#if configUSE_BUSY_FLAG == 1
+		LCD_BusyFlagReady = 0;
+	#endif
+	#if configUSE_SHADOW_BUFFER == 1
+		memset(LCD_ShadowBuffer, 0, sizeof(LCD_ShadowBuffer));
+		LCD_ShadowDirty = 0;
+	#endif
+	#if configUSE_SHADOW_BUFFER == 1 || configUSE_GLYPH_CACHE == 1 || configUSE_SCRUB == 1
+		memset(LCD_GlassBuffer, 0, sizeof(LCD_GlassBuffer));
+	#endif
+	#if configUSE_SCRUB == 1
+		LCD_ScrubNext = 0;
+	#endif
+	#if configUSE_FRAME_SCHEDULER == 1
+		LCD_FrameLine = 0;
+	#endif
+
+	/*! The transmit queue and trace clock need interrupts */
+	sei();
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_BOOT(uint8_t)
+ *
+ * \brief Function to initialize and write the first character
+ *
+ * \returns Time from the start of vLCD_INITIALIZATION until the
+ *			character is on the display
+ *
+ ******************************************************************************
+ */
+static uint64_t prvSIM_BOOT(uint8_t warm)
+{
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+
+	vSIM_GET_STATS(&Before);
+	SIM_CALL(vLCD_INITIALIZATION());
+	SIM_CALL(xLCD_WRITE_CHAR('>'));
+	SIM_CALL(vLCD_FLUSH());
+	SIM_CALL(vLCD_TX_FLUSH());
+	vSIM_GET_STATS(&After);
+
+	prvSIM_EXPECT_RESULT("LCD_WarmStarted", LCD_WarmStarted, warm);
+
+	return After.Now - Before.Now;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_WARM(void)
+ *
+ * \brief Function to time cold and warm starts
+ *
+ * \details After a power on the display starts blank. After a watchdog
+ *			reset it still shows what it did. When the signature cell was
+ *			overwritten, or in 4-bit mode when the reset came between the
+ *			two nibbles of a byte, the full sequence runs without the power
+ *			on wait.
+ *
+ ******************************************************************************
+ */
+static void prvSIM_WARM(void)
+{
+	static const char *Screen[2] =
+	{
+		"Running since power on  ", "Count 1234              "
+	};
+	uint64_t PowerOn;
+	uint64_t Lost;
+	uint64_t Warm;
+
+	prvSIM_REBOOT(1 << PORF);
+	PowerOn = prvSIM_BOOT(0);
+	prvSIM_EXPECT(">                       ",
+		"                        ");
+	/*! The flag is cleared for the next reset, the cause is kept */
+	prvSIM_EXPECT_RESULT("LCD_ResetCause & (1 << PORF)",
+		LCD_ResetCause & (1 << PORF), 1 << PORF);
+	prvSIM_EXPECT_RESULT("MCUSR & (1 << PORF)", MCUSR & (1 << PORF), 0);
+
+	vLCD_HOME_TOP_LINE();
+	vLCD_WRITE_STRING((char *)Screen[0]);
+	vLCD_HOME_BOTTOM_LINE();
+	vLCD_WRITE_STRING((char *)Screen[1]);
+	prvSIM_EXPECT(Screen[0], Screen[1]);
+
+	/*! The display kept its power and shows the same screen */
+	prvSIM_REBOOT(1 << WDRF);
+	Warm = prvSIM_BOOT(1);
+	prvSIM_EXPECT(">unning since power on  ", Screen[1]);
+
+	/*! Something overwrote the signature */
+	SIM_CALL(xWRITE_COMMAND_TO_LCD(INSTR_WR, 1 << LCD_DDRAM | configLCD_WARM_ADDRESS));
+	SIM_CALL(xWRITE_COMMAND_TO_LCD(DATA_WR, ' '));
+	prvSIM_REBOOT(1 << EXTRF);
+	Lost = prvSIM_BOOT(0);
+	prvSIM_EXPECT(">                       ",
+		"                        ");
+
+	#ifdef BITMODE4
+		/*! Reset between the two nibbles of a byte */
+		vLCD_HOME_BOTTOM_LINE();
+		vLCD_WRITE_STRING((char *)Screen[1]);
+		prvSIM_EXPECT(">                       ", Screen[1]);
+		vLCD_FLUSH();
+		vLCD_TX_FLUSH();
+		/*! The transmit queue drains before the controller is idle */
+		(void)prvLCD_READY_STATUS();
+		prvLCD_BUS_WRITE_NIBBLE(DATA_WR, 'N' >> 4);
+		prvSIM_REBOOT(1 << WDRF);
+		(void)prvSIM_BOOT(0);
+		prvSIM_EXPECT(">                       ",
+			"                        ");
+	#endif
+
+	printf("boot   first character %.1fus after a power on, %.1fus after a reset "
+		"with the signature lost, %.1fus after a warm reset\n",
+		PowerOn / 1000.0, Lost / 1000.0, Warm / 1000.0);
+}
+
+#endif
+
+/*****************************************************************************/
+
+int main(void)
+{
+	LCD_Segment_t Segments[] =
+	{
+		{ 14, 0, "1200", 4 },
+		{ 0, 1, "OK", 2 },
+		{ 2, 0, "21.5", 4 },
+		{ 0, 0, "T=", 2 },
+		{ 10, 0, "RPM", 3 },
+	};
+	SIM_Stats_t Total;
+	uint32_t Violations = 0;
+	uint8_t i;
+
+	#ifdef BITMODE4
+		vSIM_INIT(SIM_WIRING_4BIT);
+	#else
+		vSIM_INIT(SIM_WIRING_8BIT);
+	#endif
+
+	/*! The transmit queue and trace clock need interrupts */
+	sei();
+
+	#if configUSE_LCD_TRACE == 1
+		vLCD_TRACE_START();
+	#endif
+
+	#if configUSE_MULTI_DISPLAY == 1
+		/*! Everything but the multi display run goes to LCD_PrimaryDisplay,
+			the display on PJ2, with no handle set up. The pull-up the
+			application put on PJ7, an input, must be left alone */
+		LCP = LCP | (1 << 7);
+	#endif
+
+	printf("%-44s %10s %10s %5s %5s %5s %4s\n", "call", "time us",
+		"busy us", "instr", "data", "reads", "viol");
+
+	SIM_CALL(vLCD_INITIALIZATION());
+	SIM_CALL(vLCD_WRITE_STRING("Lab 03 KS0066U simulator"));
+	SIM_CALL(vLCD_HOME_BOTTOM_LINE());
+	SIM_CALL(vLCD_WRITE_STRING("0123456789"));
+	SIM_CALL(vLCD_GO_TO_POSITION(12, 1));
+	SIM_CALL(xLCD_WRITE_FIXED(-1234, 2, 7, 0));
+	prvSIM_EXPECT("Lab 03 KS0066U simulator",
+		"0123456789   -12.34     ");
+
+	SIM_CALL(vLCD_CLEAR_TOP());
+	prvSIM_EXPECT("                        ",
+		"0123456789   -12.34     ");
+
+	prvSIM_NUMBERS();
+
+	SIM_CALL(vLCD_HOME_TOP_LINE());
+	SIM_CALL(vLCD_WRITE_STRING("Top"));
+	SIM_CALL(vLCD_FILL_RANGE(4, 0, 3, '*'));
+	SIM_CALL(vLCD_CLEAR_RANGE(10, 1, 9));
+	prvSIM_EXPECT("Top ***                 ",
+		"0123456789              ");
+
+	SIM_CALL(vLCD_CLEAR_BOTTOM());
+	SIM_CALL(xLCD_WRITE_SEGMENTS(Segments, 5));
+	prvSIM_EXPECT("T=21.5*   RPM 1200      ",
+		"OK                      ");
+
+	SIM_CALL(vLCD_CLEAR());
+	prvSIM_EXPECT("                        ",
+		"                        ");
+
+	#if configUSE_GLYPH_CACHE == 1
+		prvSIM_GLYPHS();
+	#endif
+
+	#if configUSE_BAR_GRAPH == 1
+		prvSIM_BARS();
+	#endif
+
+	#if configUSE_MARQUEE == 1
+		prvSIM_MARQUEE();
+	#endif
+
+	#if configUSE_PAGE_FLIP == 1
+		prvSIM_PAGES();
+	#endif
+
+	#if configUSE_MULTI_DISPLAY == 1
+		prvSIM_MULTI();
+		if (!(LCP & (1 << 7)))
+		{
+			printf("  ! the library cleared the PJ7 pull-up\n");
+			SIM_Mismatches++;
+		}
+	#endif
+
+	#if configUSE_SCRUB == 1
+		prvSIM_SCRUB();
+	#endif
+
+	#if configUSE_FRAME_SCHEDULER == 1
+		prvSIM_FRAMES();
+	#endif
+
+	#if configUSE_LAYOUT == 1
+		prvSIM_LAYOUT();
+	#endif
+
+	#if configUSE_UTF8 == 1
+		prvSIM_UTF8();
+	#endif
+
+	#if configUSE_YIELD_WAIT == 1
+		prvSIM_YIELD();
+	#endif
+
+	#if configUSE_LCD_GATEKEEPER == 1
+		prvSIM_GATEKEEPER();
+	#endif
+
+	#if configUSE_WARM_START == 1
+		prvSIM_WARM();
+	#endif
+
+	vSIM_GET_STATS(&Total);
+	printf("\nvirtual time %.1fus, controller busy %.1fus, %lu E strobes\n",
+		Total.Now / 1000.0, Total.BusyTime / 1000.0, (unsigned long)Total.Strobes);
+
+	#if configUSE_LCD_STATS == 1
+		prvSIM_LCD_STATS(&Total);
+	#endif
+
+	#if configUSE_LCD_TRACE == 1
+		SIM_TraceFile = fopen("lcd.trace", "wb");
+		if (SIM_TraceFile)
+		{
+			vLCD_TRACE_DUMP(prvSIM_TRACE_WRITE);
+			printf("bus trace of %ld bytes written to lcd.trace\n",
+				ftell(SIM_TraceFile));
+			fclose(SIM_TraceFile);
+		}
+	#endif
+
+	for (i = 0; i < SIM_VIOLATIONS; i++)
+	{
+		if (Total.Violations[i])
+		{
+			printf("%6lu x %s\n", (unsigned long)Total.Violations[i],
+				xSIM_VIOLATION_NAME(i));
+			Violations += Total.Violations[i];
+		}
+	}
+
+	printf("%lu violations, %u display mismatches\n",
+		(unsigned long)Violations, SIM_Mismatches);
+
+	return (Violations || SIM_Mismatches) ? 1 : 0;
+}
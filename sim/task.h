@@ -0,0 +1,40 @@
+/*!****************************************************************************
+ *
+ * \file task.h
+ *
+ * \brief Host stand-in for the FreeRTOS task.h
+ *
+ * \details vTaskDelay moves the virtual clock of the model on to the
+ *			tick the task would wake on and counts the time as blocked.
+ *			The scheduler state is set by the simulator run with
+ *			vSIM_SET_SCHEDULER. The model runs one created task, when the
+ *			simulator run calls vSIM_TASK_RUN or waits on a full queue.
+ *
+ * Modification History:
+ * 10/18/2026 - Added task creation, the tick count and critical sections
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef SIM_TASK_H
+#define SIM_TASK_H
+
+#include "FreeRTOS.h"
+#include "lcd_sim.h"
+
+#define taskSCHEDULER_SUSPENDED		SIM_SCHEDULER_SUSPENDED
+#define taskSCHEDULER_NOT_STARTED	SIM_SCHEDULER_NOT_STARTED
+#define taskSCHEDULER_RUNNING		SIM_SCHEDULER_RUNNING
+
+#define vTaskDelay(ticks)			vSIM_TASK_DELAY((ticks), 1000000000UL / configTICK_RATE_HZ)
+#define xTaskGetSchedulerState()	((BaseType_t)xSIM_GET_SCHEDULER())
+#define xTaskGetTickCount()			((TickType_t)xSIM_TICK_COUNT(1000000000UL / configTICK_RATE_HZ))
+
+#define xTaskCreate(task, name, stack, parameters, priority, handle) \
+	((BaseType_t)xSIM_TASK_CREATE((task), (parameters)))
+
+#define taskENTER_CRITICAL()		vSIM_ENTER_CRITICAL()
+#define taskEXIT_CRITICAL()			vSIM_EXIT_CRITICAL()
+
+#endif
@@ -0,0 +1,313 @@
+/*!****************************************************************************
+ *
+ * \file trace_replay.c
+ *
+ * \brief Host replay of a recorded bus trace against the KS0066U model
+ *
+ * \author
+ *
+ * \details Reads a trace stored from vLCD_TRACE_DUMP and feeds every
+ *			recorded write through xWRITE_COMMAND_TO_LCD of the library
+ *			build under test, at the recorded times. Prints the time the
+ *			library spent on the writes, the instructions and data that
+ *			reached the controller, every timing rule broken and what the
+ *			display shows at the end. Replaying one trace against builds
+ *			with different options compares them on the same traffic.
+ *
+ *			Build and run from the repository root:
+ *
+ *				gcc -std=gnu99 -Wall -Wno-comment -Isim -I. \
+ *					sim/trace_replay.c sim/lcd_sim.c -o lcd_replay
+ *				./lcd_replay lcd.trace
+ *
+ *			Library options are given with -D as for sim_main.c. The build
+ *			under test runs its own vLCD_INITIALIZATION first, so recorded
+ *			function set instructions are skipped; the bus width belongs to
+ *			the build, not the trace. The exit status is 1 when the trace
+ *			could not be read or a rule was broken.
+ *
+ * Modification History:
+ * 10/18/2026 - Build with the gatekeeper on the stub FreeRTOS
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef F_CPU
+	#define F_CPU 16000000UL
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <avr/io.h>
+#include <util/delay.h>
+#include <avr/interrupt.h>
+
+#include "Lib_LCD.h"
+#include "Lib_LCD.c"
+
+/*****************************************************************************/
+/************************/
+/*Trace Replay Functions*/
+/************************/
+
+/*! Totals of one replay */
+typedef struct
+{
+	uint32_t Records;		// writes in the trace
+	uint32_t Commands;		// instructions in the trace
+	uint32_t Bytes;			// data bytes in the trace
+	uint32_t Skipped;		// function set instructions not replayed
+	uint32_t Dropped;		// records the recorder dropped
+	uint64_t Span;			// recorded time from the first to the last write
+	uint64_t LibraryTime;	// time spent in xWRITE_COMMAND_TO_LCD
+	uint64_t MaxLate;		// most a write started after its recorded time
+} SIM_Replay_t;
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_READ_FILE(const char *, long *)
+ *
+ * \brief Function to read a whole file into memory
+ *
+ * \returns The contents, or NULL if the file could not be read
+ *
+ ******************************************************************************
+ */
+static uint8_t *prvSIM_READ_FILE(const char *name, long *length)
+{
+	FILE *File = fopen(name, "rb");
+	uint8_t *Data;
+
+	if (!File) return NULL;
+
+	fseek(File, 0, SEEK_END);
+	*length = ftell(File);
+	fseek(File, 0, SEEK_SET);
+
+	Data = malloc(*length ? *length : 1);
+	if (Data && fread(Data, 1, *length, File) != (size_t)*length)
+	{
+		free(Data);
+		Data = NULL;
+	}
+
+	fclose(File);
+	return Data;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_REPLAY_WRITE(SIM_Replay_t *, uint64_t, uint8_t, uint8_t)
+ *
+ * \brief Function to replay one write at its recorded time
+ *
+ ******************************************************************************
+ */
+static void prvSIM_REPLAY_WRITE(SIM_Replay_t *replay, uint64_t due,
+	uint8_t rs, uint8_t data)
+{
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+
+	replay->Records++;
+	if (rs == DATA_WR) replay->Bytes++;
+	else replay->Commands++;
+
+	/*! Function set belongs to the build under test */
+	if ((rs == INSTR_WR) && ((data & 0xE0) == (1 << LCD_D5)))
+	{
+		replay->Skipped++;
+		return;
+	}
+
+	vSIM_GET_STATS(&Before);
+
+	if (Before.Now < due)
+	{
+		vSIM_DELAY_NS(due - Before.Now);
+		vSIM_GET_STATS(&Before);
+	}
+	else if (Before.Now - due > replay->MaxLate)
+	{
+		replay->MaxLate = Before.Now - due;
+	}
+
+	(void)xWRITE_COMMAND_TO_LCD(rs, data);
+
+	/*! Callers wait out clear and return home when the busy flag is not read */
+	if ((rs == INSTR_WR) && (data < (1 << LCD_ENTRY_MODE)))
+	{
+		LCD_EXECUTION_DELAY_US(LCD_CLEAR_TIME_US);
+	}
+
+	vSIM_GET_STATS(&After);
+	replay->LibraryTime += After.Now - Before.Now;
+}
+
+/*!****************************************************************************
+ *
+ * \fn prvSIM_REPLAY(SIM_Replay_t *, const uint8_t *, long)
+ *
+ * \brief Function to decode the dumps in a trace and replay their records
+ *
+ * \returns 0, or 1 if the trace is malformed
+ *
+ ******************************************************************************
+ */
+static uint8_t prvSIM_REPLAY(SIM_Replay_t *replay, const uint8_t *trace, long length)
+{
+	SIM_Stats_t Start;
+	uint64_t Ticks = 0;
+	long i = 0;
+
+	vSIM_GET_STATS(&Start);
+
+	while (i < length)
+	{
+		uint16_t TickNs;
+		long End;
+
+		if ((length - i < LCD_TRACE_HEADER_LENGTH) || (trace[i] != 'L') ||
+			(trace[i + 1] != 'T') || (trace[i + 2] != LCD_TRACE_VERSION))
+		{
+			printf("no trace dump header at byte %ld\n", i);
+			return 1;
+		}
+
+		TickNs = trace[i + 3] | (trace[i + 4] << 8);
+		replay->Dropped += trace[i + 5] | (trace[i + 6] << 8);
+		End = i + LCD_TRACE_HEADER_LENGTH + (trace[i + 7] | (trace[i + 8] << 8));
+		i += LCD_TRACE_HEADER_LENGTH;
+
+		if (End > length)
+		{
+			printf("trace dump at byte %ld is cut short\n", i - LCD_TRACE_HEADER_LENGTH);
+			return 1;
+		}
+
+		while (i < End)
+		{
+			uint8_t Header = trace[i++];
+			uint64_t Delta = Header & LCD_TRACE_DELTA;
+
+			if (Delta == LCD_TRACE_ESCAPE)
+			{
+				uint8_t Shift = 0;
+				uint8_t Byte;
+
+				do
+				{
+					if (i >= End) break;
+					Byte = trace[i++];
+					Delta += (uint64_t)(Byte & 0x7F) << Shift;
+					Shift += 7;
+				} while (Byte & 0x80);
+			}
+
+			if (i >= End)
+			{
+				printf("trace record at byte %ld is cut short\n", i);
+				return 1;
+			}
+
+			/*! The first write starts the replay clock */
+			if (replay->Records) Ticks += Delta;
+
+			prvSIM_REPLAY_WRITE(replay, Start.Now + Ticks * TickNs,
+				(Header & LCD_TRACE_RS) ? DATA_WR : INSTR_WR, trace[i++]);
+
+			replay->Span = Ticks * TickNs;
+		}
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+
+int main(int argc, char **argv)
+{
+	SIM_Replay_t Replay = { 0 };
+	SIM_Stats_t Before;
+	SIM_Stats_t After;
+	uint32_t Violations = 0;
+	uint8_t *Trace;
+	long Length;
+	char Line[2][25];
+	uint8_t i;
+
+	if (argc != 2)
+	{
+		printf("usage: %s trace\n", argv[0]);
+		return 1;
+	}
+
+	Trace = prvSIM_READ_FILE(argv[1], &Length);
+	if (!Trace)
+	{
+		printf("cannot read %s\n", argv[1]);
+		return 1;
+	}
+
+	#ifdef BITMODE4
+		vSIM_INIT(SIM_WIRING_4BIT);
+	#else
+		vSIM_INIT(SIM_WIRING_8BIT);
+	#endif
+
+	sei();
+
+	vLCD_INITIALIZATION();
+	vLCD_TX_FLUSH();
+
+	vSIM_GET_STATS(&Before);
+
+	if (prvSIM_REPLAY(&Replay, Trace, Length))
+	{
+		free(Trace);
+		return 1;
+	}
+	free(Trace);
+
+	/*! Let held back and queued writes reach the display */
+	#if configUSE_PEEPHOLE == 1
+		(void)xLCD_PEEPHOLE_FLUSH();
+	#endif
+	vLCD_TX_FLUSH();
+
+	vSIM_GET_STATS(&After);
+
+	vSIM_GET_LINE(0, Line[0]);
+	vSIM_GET_LINE(1, Line[1]);
+	printf("  |%s|\n  |%s|\n\n", Line[0], Line[1]);
+
+	printf("trace      %lu writes, %lu instructions, %lu data, %lu function sets "
+		"skipped, %lu dropped by the recorder\n", (unsigned long)Replay.Records,
+		(unsigned long)Replay.Commands, (unsigned long)Replay.Bytes,
+		(unsigned long)Replay.Skipped, (unsigned long)Replay.Dropped);
+	printf("bus        %lu instructions, %lu data, %lu reads, %lu E strobes\n",
+		(unsigned long)(After.Instructions - Before.Instructions),
+		(unsigned long)(After.DataWrites - Before.DataWrites),
+		(unsigned long)(After.Reads - Before.Reads),
+		(unsigned long)(After.Strobes - Before.Strobes));
+	printf("time       recorded %.1fus, replayed %.1fus, in the library %.1fus, "
+		"controller busy %.1fus, latest write %.1fus behind\n",
+		Replay.Span / 1000.0, (After.Now - Before.Now) / 1000.0,
+		Replay.LibraryTime / 1000.0, (After.BusyTime - Before.BusyTime) / 1000.0,
+		Replay.MaxLate / 1000.0);
+
+	for (i = 0; i < SIM_VIOLATIONS; i++)
+	{
+		if (After.Violations[i])
+		{
+			printf("%6lu x %s\n", (unsigned long)After.Violations[i],
+				xSIM_VIOLATION_NAME(i));
+			Violations += After.Violations[i];
+		}
+	}
+
+	printf("%lu violations\n", (unsigned long)Violations);
+
+	return Violations ? 1 : 0;
+}
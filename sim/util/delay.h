@@ -0,0 +1,24 @@
+/*!****************************************************************************
+ *
+ * \file delay.h
+ *
+ * \brief Host stand-in for <util/delay.h>
+ *
+ * \details Delays advance the virtual clock of the model instead of
+ *			spinning, so a simulated run takes no real time.
+ *
+ * Modification History:
+ * 10/18/2026 - Original File
+ *
+ ******************************************************************************
+ */
+
+#ifndef SIM_UTIL_DELAY_H
+#define SIM_UTIL_DELAY_H
+
+#include "../lcd_sim.h"
+
+#define _delay_us(us)	vSIM_DELAY_NS((uint64_t)((us) * 1000.0))
+#define _delay_ms(ms)	vSIM_DELAY_NS((uint64_t)((ms) * 1000000.0))
+
+#endif